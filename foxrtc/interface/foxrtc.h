@@ -1,5 +1,67 @@
 #pragma once
 
+// SRTP crypto suites, numbered as in RFC 4568 / RFC 7714 and rtc::SRTP_*.
+enum FoxrtcSrtpSuite
+{
+	kFoxrtcSrtpNone = 0,
+	kFoxrtcSrtpAes128CmSha1_80 = 1,
+	kFoxrtcSrtpAes128CmSha1_32 = 2,
+	kFoxrtcSrtpAeadAes128Gcm = 7,
+	kFoxrtcSrtpAeadAes256Gcm = 8,
+};
+
+// Video codecs, each sent with a fixed RTP payload type.
+enum FoxrtcVideoCodec
+{
+	kFoxrtcVideoCodecVP8 = 0,
+	kFoxrtcVideoCodecVP9 = 1,
+	kFoxrtcVideoCodecH264 = 2,
+};
+
+// SDES or DTLS-SRTP derived keying material. Each key is the master key
+// directly followed by the master salt.
+struct FoxrtcCryptoParams
+{
+	int suite = kFoxrtcSrtpNone;
+	const unsigned char* sendKey = nullptr;
+	int sendKeyLen = 0;
+	const unsigned char* recvKey = nullptr;
+	int recvKeyLen = 0;
+};
+
+// Receives what a virtual audio device plays out, interleaved 16-bit PCM,
+// 10 ms at a time on the audio thread.
+class FoxrtcAudioSink
+{
+public:
+	virtual ~FoxrtcAudioSink() {}
+	virtual void OnPlayoutData(const short* samples, int samplesPerChannel, int channels, int sampleRate) = 0;
+};
+
+// Replaces the sound card with a virtual audio device, for server-side
+// sessions and benchmarks on machines without audio hardware.
+struct FoxrtcVirtualAudioParams
+{
+	// The microphone loops this 16-bit PCM WAV file, or else |inputSamples|,
+	// interleaved at |sampleRate| and |channels|, or else silence. The
+	// samples must stay valid until Uninit. Audio moves in 10 ms blocks, so
+	// all sample rates must be multiples of 100 Hz; 11025 Hz and 22050 Hz
+	// files need resampling first.
+	const char* inputWavFile = nullptr;
+	const short* inputSamples = nullptr;
+	int inputSampleCount = 0;
+	// Playout goes to this WAV file and/or |outputSink|, or is dropped.
+	const char* outputWavFile = nullptr;
+	FoxrtcAudioSink* outputSink = nullptr;
+	// Playout format, and the in-memory input format.
+	int sampleRate = 48000;
+	int channels = 1;
+	// Audio runs |speed| times faster than real time, or as fast as the
+	// CPU allows for 0. Only capture, encoding and playout speed up, the
+	// network side still follows the wall clock.
+	float speed = 1.0f;
+};
+
 class FoxrtcTransport
 {
 public:
@@ -20,6 +82,15 @@ public:
 	static Foxrtc& Instance();
 
 	virtual int Init(FoxrtcTransport* transport) = 0;
+	// Same as Init(transport), but every outgoing RTP/RTCP packet is protected
+	// with SRTP and IncomingData expects SRTP/SRTCP. Without a transport,
+	// packets loop back and are unprotected with the send key, so the receive
+	// key is not used.
+	virtual int Init(FoxrtcTransport* transport, const FoxrtcCryptoParams& crypto) = 0;
+	// Same as Init(transport, crypto), but audio goes through a virtual
+	// device instead of the sound card.
+	virtual int Init(FoxrtcTransport* transport, const FoxrtcCryptoParams& crypto,
+		const FoxrtcVirtualAudioParams& audio) = 0;
 	virtual int Uninit() = 0;
 
 	virtual int GetDeviceInfo() = 0;
@@ -27,17 +98,50 @@ public:
 	virtual int OpenCamera(int index) = 0;
 	virtual int CloseCamera() = 0;
 
+	// Sends screen |screenId| (-1 for the whole desktop) on the local video
+	// stream instead of the camera, encoded as screen content at up to
+	// |maxFramerate| fps. Frames are only sent when the screen changes, plus
+	// one per second while it does not. Applies to the current local stream
+	// and to streams created afterwards, but not to simulcast streams.
+	virtual int StartScreenShare(int screenId, int maxFramerate) = 0;
+	virtual int StopScreenShare() = 0;
+	// Compares large updates against the previous screen frame on up to
+	// |threads| threads, to find what actually changed. Applies to screen
+	// shares started afterwards. Defaults to 1; at most the number of cores.
+	virtual int SetScreenShareDifferThreads(int threads) = 0;
+
 	virtual int CreateLocalAudioStream(unsigned int ssrc) = 0;
 	virtual int DeleteLocalAudioStream() = 0;
+	// Sends local audio as Opus and lets the encoder lower its complexity,
+	// then lengthen its packets to 40 and 60 ms, while encoding takes too
+	// much of each packet's duration. Applies to the current local audio
+	// stream and to streams created afterwards. Off by default, when local
+	// audio is sent as PCMU; turning it off again keeps Opus.
+	virtual int SetOpusCpuAdaptation(bool enable) = 0;
 	virtual int CreateRemoteAudioStream(unsigned int ssrc) = 0;
 	virtual int DeleteRemoteAudioStream() = 0;
 
+	// Video codecs in order of preference, used by streams created afterwards.
+	// Local streams send the first one this build supports, remote streams
+	// accept all of them. Defaults to VP9, VP8.
+	virtual int SetVideoCodecPreference(const int* codecs, int count) = 0;
 	virtual int CreateLocalVideoStream(int ssrc, void* view) = 0;
+	// Sends |count| simulcast layers, lowest resolution first, one SSRC each.
+	// Simulcast needs VP8 in the codec preference list.
+	virtual int CreateLocalVideoStream(const int* ssrcs, int count, void* view) = 0;
+	// Encodes the layers of simulcast streams created afterwards on up to
+	// |threads| threads at once, to cut the encode latency of each frame.
+	// Defaults to 1, which encodes the layers one after another. At most
+	// webrtc::kMaxSimulcastStreams, one thread per layer.
+	virtual int SetSimulcastEncodeThreads(int threads) = 0;
 	virtual int DeleteLocalVideoStream() = 0;
 	virtual int CreateRemoteVideoStream(int ssrc, void* view) = 0;
 	virtual int DeleteRemoteVideoStream() = 0;
 
 	virtual int IncomingData(const char* data, int len) = 0;
+	// Same as IncomingData, but SRTP is removed in place, so |data| is
+	// modified and must stay writable for the duration of the call.
+	virtual int IncomingDataInPlace(char* data, int len) = 0;
 
 };
 
@@ -0,0 +1,189 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+#include <libyuv/convert.h>
+#include <webrtc/base/event.h>
+#include <webrtc/base/platform_thread.h>
+#include <webrtc/base/refcount.h>
+#include <webrtc/base/timeutils.h>
+#include <webrtc/common_video/include/video_frame_buffer.h>
+#include <webrtc/media/base/videosourceinterface.h>
+#include <webrtc/modules/desktop_capture/desktop_and_cursor_composer.h>
+#include <webrtc/modules/desktop_capture/desktop_capture_options.h>
+#include <webrtc/modules/desktop_capture/desktop_frame.h>
+#include <webrtc/modules/desktop_capture/mouse_cursor_monitor.h>
+#include <webrtc/modules/desktop_capture/screen_capturer.h>
+#include <webrtc/system_wrappers/include/critical_section_wrapper.h>
+#include <webrtc/video_frame.h>
+#include "scoped_ptr.h"
+
+// A static screen is still sent this often, so that receivers that join late
+// or lost the last frame get a picture within a second.
+static const int kDesktopCaptureKeepAliveMs = 1000;
+
+// Screen capture source for screen sharing. The capturer polls at the maximum
+// frame rate, but a frame is only converted and delivered when the screen or
+// the cursor changed, and then only the changed rectangles are converted from
+// BGRA into a persistent I420 buffer. A static slide costs one capture and a
+// keep-alive frame per second instead of a full convert and encode per frame.
+class DesktopCaptureSource
+	:public rtc::VideoSourceInterface<webrtc::VideoFrame>
+	, public webrtc::DesktopCapturer::Callback
+{
+public:
+	DesktopCaptureSource() :
+		_stopEvent(true, false)
+		, _locker(webrtc::CriticalSectionWrapper::CreateCriticalSection())
+	{
+	}
+	virtual ~DesktopCaptureSource() {
+		StopCapture();
+	}
+	// Captures screen |screenId|, or all of them for
+	// webrtc::kFullDesktopScreenId, with the cursor drawn in. Updates are
+	// compared against the previous frame on up to |differThreads| threads.
+	int StartCapture(webrtc::ScreenId screenId, int maxFramerate, int differThreads) {
+		if (_thread.get() != nullptr || maxFramerate <= 0 || differThreads < 1) {
+			return -1;
+		}
+		webrtc::DesktopCaptureOptions options = webrtc::DesktopCaptureOptions::CreateDefault();
+		// XDamage where available, comparing against the previous frame
+		// everywhere else.
+		options.set_use_update_notifications(true);
+		options.set_detect_updated_region(true);
+		options.set_differ_threads(differThreads);
+		webrtc::ScreenCapturer* screen = webrtc::ScreenCapturer::Create(options);
+		if (screen == nullptr) {
+			return -1;
+		}
+		if (!screen->SelectScreen(screenId)) {
+			delete screen;
+			return -1;
+		}
+		_capturer.reset(new webrtc::DesktopAndCursorComposer(screen,
+			webrtc::MouseCursorMonitor::CreateForScreen(options, screenId)));
+		_capturer->Start(this);
+		_frameIntervalMs = 1000 / maxFramerate;
+		_lastFrameMs = 0;
+		_stopEvent.Reset();
+		_thread.reset(new rtc::PlatformThread(&DesktopCaptureSource::CaptureThread, this, "DesktopCapture"));
+		_thread->Start();
+		return 0;
+	}
+	int StopCapture() {
+		if (_thread.get() == nullptr) {
+			return -1;
+		}
+		_stopEvent.Set();
+		_thread->Stop();
+		_thread.reset();
+		_capturer.reset();
+		_buffer = nullptr;
+		return 0;
+	}
+public:
+	virtual void AddOrUpdateSink(rtc::VideoSinkInterface<webrtc::VideoFrame>* sink,
+		const rtc::VideoSinkWants& wants) {
+		webrtc::CriticalSectionScoped ls(_locker.get());
+		for (auto item : _sinks) {
+			if (item == sink) {
+				return;
+			}
+		}
+		_sinks.push_back(sink);
+	}
+	// RemoveSink must guarantee that at the time the method returns,
+	// there is no current and no future calls to VideoSinkInterface::OnFrame.
+	virtual void RemoveSink(rtc::VideoSinkInterface<webrtc::VideoFrame>* sink) {
+		webrtc::CriticalSectionScoped ls(_locker.get());
+		auto item = _sinks.begin();
+		for (; item != _sinks.end(); item++) {
+			if (*item == sink) {
+				_sinks.erase(item);
+				return;
+			}
+		}
+	}
+protected:
+	virtual void OnCaptureResult(webrtc::DesktopCapturer::Result result,
+		std::unique_ptr<webrtc::DesktopFrame> frame) {
+		if (result != webrtc::DesktopCapturer::Result::SUCCESS) {
+			return;
+		}
+		int64_t nowMs = rtc::TimeMillis();
+		const webrtc::DesktopSize& size = frame->size();
+		if (_buffer == nullptr || _buffer->width() != size.width() ||
+			_buffer->height() != size.height()) {
+			_buffer = new rtc::RefCountedObject<webrtc::I420Buffer>(size.width(), size.height());
+			ConvertRect(*frame, webrtc::DesktopRect::MakeSize(size));
+		}
+		else if (!frame->updated_region().is_empty()) {
+			if (!_buffer->HasOneRef()) {
+				// The last frame is still queued for encoding, so it must
+				// not change underneath the encoder.
+				rtc::scoped_refptr<rtc::RefCountedObject<webrtc::I420Buffer>> buffer(
+					new rtc::RefCountedObject<webrtc::I420Buffer>(size.width(), size.height()));
+				libyuv::I420Copy(_buffer->DataY(), _buffer->StrideY(),
+					_buffer->DataU(), _buffer->StrideU(),
+					_buffer->DataV(), _buffer->StrideV(),
+					buffer->MutableDataY(), buffer->StrideY(),
+					buffer->MutableDataU(), buffer->StrideU(),
+					buffer->MutableDataV(), buffer->StrideV(),
+					size.width(), size.height());
+				_buffer = buffer;
+			}
+			for (webrtc::DesktopRegion::Iterator it(frame->updated_region()); !it.IsAtEnd(); it.Advance()) {
+				ConvertRect(*frame, it.rect());
+			}
+		}
+		else if (nowMs - _lastFrameMs < kDesktopCaptureKeepAliveMs) {
+			return;
+		}
+		_lastFrameMs = nowMs;
+
+		webrtc::VideoFrame videoFrame(_buffer, webrtc::kVideoRotation_0,
+			nowMs * rtc::kNumMicrosecsPerMillisec);
+		webrtc::CriticalSectionScoped ls(_locker.get());
+		for (auto item : _sinks) {
+			item->OnFrame(videoFrame);
+		}
+	}
+private:
+	static bool CaptureThread(void* obj) {
+		return static_cast<DesktopCaptureSource*>(obj)->CaptureProcess();
+	}
+	bool CaptureProcess() {
+		int64_t startMs = rtc::TimeMillis();
+		_capturer->Capture(webrtc::DesktopRegion());
+		int64_t waitMs = _frameIntervalMs - (rtc::TimeMillis() - startMs);
+		return !_stopEvent.Wait(static_cast<int>(std::max<int64_t>(waitMs, 0)));
+	}
+	// Converts |rect| of |frame| into the same place of |_buffer|. Chroma is
+	// subsampled 2x2, so the rectangle is widened to even coordinates.
+	void ConvertRect(const webrtc::DesktopFrame& frame, const webrtc::DesktopRect& rect) {
+		int left = rect.left() & ~1;
+		int top = rect.top() & ~1;
+		int right = std::min(rect.right() + (rect.right() & 1), frame.size().width());
+		int bottom = std::min(rect.bottom() + (rect.bottom() & 1), frame.size().height());
+		if (right <= left || bottom <= top) {
+			return;
+		}
+		libyuv::ARGBToI420(
+			frame.data() + top * frame.stride() + left * webrtc::DesktopFrame::kBytesPerPixel,
+			frame.stride(),
+			_buffer->MutableDataY() + top * _buffer->StrideY() + left, _buffer->StrideY(),
+			_buffer->MutableDataU() + top / 2 * _buffer->StrideU() + left / 2, _buffer->StrideU(),
+			_buffer->MutableDataV() + top / 2 * _buffer->StrideV() + left / 2, _buffer->StrideV(),
+			right - left, bottom - top);
+	}
+
+	foxrtc::scoped_ptr<webrtc::DesktopCapturer> _capturer;
+	foxrtc::scoped_ptr<rtc::PlatformThread> _thread;
+	rtc::Event _stopEvent;
+	int _frameIntervalMs = 0;
+	int64_t _lastFrameMs = 0;
+	// Only touched on the capture thread.
+	rtc::scoped_refptr<rtc::RefCountedObject<webrtc::I420Buffer>> _buffer;
+	std::vector<rtc::VideoSinkInterface<webrtc::VideoFrame>*> _sinks;
+	foxrtc::scoped_ptr<webrtc::CriticalSectionWrapper> _locker;
+};
@@ -1,6 +1,15 @@
 #pragma once
+#include <algorithm>
 #include <webrtc/config.h>
 #include <webrtc/video_encoder.h>
+#include <webrtc/media/engine/simulcast.h>
+
+// Default minimum for a single stream, as kMinVideoBitrateKbps in
+// webrtcvideoengine2.
+static const int kEncoderStreamMinBitrateBps = 30 * 1000;
+// The bitrate tables below and in simulcast.cc are for 30 fps.
+static const int kEncoderStreamReferenceFramerate = 30;
+static const int kEncoderStreamVp8ConferenceTemporalLayers = 3;
 
 class EncoderStreamFactory : public webrtc::VideoEncoderConfig::VideoStreamFactoryInterface {
 public:
@@ -22,24 +31,84 @@ private:
 		const webrtc::VideoEncoderConfig& encoder_config) override {
 		RTC_DCHECK(encoder_config.number_of_streams > 1 ? !is_screencast_ : true);
 
+		std::vector<webrtc::VideoStream> streams;
+		if (encoder_config.number_of_streams > 1) {
+			// Resolution ladder and per-layer rates from the simulcast table,
+			// each layer with three temporal layers.
+			streams = cricket::GetSimulcastConfig(encoder_config.number_of_streams,
+				width, height, encoder_config.max_bitrate_bps, max_qp_, max_framerate_);
+		}
+		if (streams.empty()) {
+			int max_bitrate_bps = encoder_config.max_bitrate_bps > 0
+				? encoder_config.max_bitrate_bps
+				: MaxBitrateKbps(width, height) * 1000;
 
-		webrtc::VideoStream stream;
-		stream.width = width;
-		stream.height = height;
-		stream.max_framerate = max_framerate_;
-		stream.min_bitrate_bps = 100 * 1000;
-		stream.target_bitrate_bps = stream.max_bitrate_bps = 500 * 1000;
-		stream.max_qp = max_qp_;
+			webrtc::VideoStream stream;
+			stream.width = width;
+			stream.height = height;
+			stream.max_framerate = max_framerate_;
+			stream.min_bitrate_bps = kEncoderStreamMinBitrateBps;
+			stream.target_bitrate_bps = stream.max_bitrate_bps = max_bitrate_bps;
+			stream.max_qp = max_qp_;
 
+			if (is_screencast_ && conference_mode_) {
+				// tl0 and tl1 bitrates are carried as target and max, see
+				// webrtc::VP8EncoderImpl::SetRates().
+				cricket::ScreenshareLayerConfig config = cricket::ScreenshareLayerConfig::GetDefault();
+				stream.target_bitrate_bps = config.tl0_bitrate_kbps * 1000;
+				stream.max_bitrate_bps = config.tl1_bitrate_kbps * 1000;
+				stream.temporal_layer_thresholds_bps.push_back(config.tl0_bitrate_kbps * 1000);
+			}
+			else if (conference_mode_ && codec_name_ == "VP8") {
+				// Lets an SFU thin the frame rate without transcoding.
+				stream.temporal_layer_thresholds_bps.resize(
+					kEncoderStreamVp8ConferenceTemporalLayers - 1);
+			}
+			streams.push_back(stream);
+		}
 
-		std::vector<webrtc::VideoStream> streams;
-		streams.push_back(stream);
+		if (!is_screencast_) {
+			for (webrtc::VideoStream& stream : streams) {
+				ScaleForFramerate(&stream);
+			}
+		}
 		return streams;
 	}
 
+	// Default max bitrate of a 30 fps camera stream, as
+	// GetMaxDefaultVideoBitrateKbps in webrtcvideoengine2 plus a 1080p tier.
+	static int MaxBitrateKbps(int width, int height) {
+		int pixels = width * height;
+		if (pixels <= 320 * 240) {
+			return 600;
+		}
+		else if (pixels <= 640 * 480) {
+			return 1700;
+		}
+		else if (pixels <= 960 * 540) {
+			return 2000;
+		}
+		else if (pixels <= 1280 * 720) {
+			return 2500;
+		}
+		return 4000;
+	}
+
+	// Fewer frames need fewer bits. The minimum is left alone so that low
+	// frame rates still get a usable picture.
+	void ScaleForFramerate(webrtc::VideoStream* stream) const {
+		if (max_framerate_ <= 0 || max_framerate_ >= kEncoderStreamReferenceFramerate) {
+			return;
+		}
+		stream->target_bitrate_bps = std::max(stream->min_bitrate_bps,
+			stream->target_bitrate_bps / kEncoderStreamReferenceFramerate * max_framerate_);
+		stream->max_bitrate_bps = std::max(stream->target_bitrate_bps,
+			stream->max_bitrate_bps / kEncoderStreamReferenceFramerate * max_framerate_);
+	}
+
 	const std::string codec_name_;
 	const int max_qp_;
 	const int max_framerate_;
 	const bool is_screencast_;
 	const bool conference_mode_;
-};
\ No newline at end of file
+};
@@ -39,14 +39,33 @@ static Foxrtc& Instance()
 	return *instance;
 }
 
+// Fixed RTP payload types, so that both ends agree without negotiation.
+static int VideoPayloadType(webrtc::VideoCodecType type)
+{
+	switch (type) {
+	case webrtc::kVideoCodecVP8:
+		return 120;
+	case webrtc::kVideoCodecVP9:
+		return 121;
+	default:
+		return 122;
+	}
+}
+
 FoxrtcImpl::FoxrtcImpl()
+	: _videoCodecFactory(new PooledVideoCodecFactory())
+	, _recvLocker(webrtc::CriticalSectionWrapper::CreateCriticalSection())
 {
+	_videoCodecs.push_back(webrtc::kVideoCodecVP9);
+	_videoCodecs.push_back(webrtc::kVideoCodecVP8);
 }
 
 FoxrtcImpl::~FoxrtcImpl()
 {
 	delete _stream_id;
 	delete _audioDecoderFactory;
+	delete _srtpSend;
+	delete _srtpRecv;
 }
 
 Call* FoxrtcImpl::GetCall()
@@ -54,11 +73,125 @@ Call* FoxrtcImpl::GetCall()
 	return _call;
 }
 
+int FoxrtcImpl::SetVideoCodecFactory(VideoCodecFactory* factory)
+{
+	if (factory == nullptr || _videoSendStream != nullptr || _videoReceiveStream != nullptr) {
+		return -1;
+	}
+	_videoCodecFactory.reset(factory);
+	return 0;
+}
+
+webrtc::Transport* FoxrtcImpl::SendTransport(MediaType mediaType)
+{
+	foxrtc::scoped_ptr<OwnedTransport>& sendTransport =
+		mediaType == MediaType::AUDIO ? _audioSendTransport : _videoSendTransport;
+	if (sendTransport == nullptr) {
+		OwnedTransport* transport = nullptr;
+		if (_transport != nullptr) {
+			transport = new FoxrtcTransportAdapter(_transport);
+		}
+		else if (mediaType == MediaType::AUDIO) {
+			transport = new AudioLoopbackTransport();
+		}
+		else {
+			transport = new VideoLoopbackTransport();
+		}
+		if (_srtpSend != nullptr) {
+			transport = new SrtpTransport(transport, _srtpSend);
+		}
+		sendTransport.reset(transport);
+	}
+	return sendTransport.get();
+}
+
+void FoxrtcImpl::ReleaseSendTransport(MediaType mediaType)
+{
+	if (mediaType == MediaType::AUDIO) {
+		if (_audioSendStream == nullptr && _audioReceiveStream == nullptr) {
+			_audioSendTransport.reset();
+		}
+	}
+	else if (_videoSendStream == nullptr && _videoReceiveStream == nullptr) {
+		_videoSendTransport.reset();
+	}
+}
+
+size_t FoxrtcImpl::MaxPacketSize() const
+{
+	// Leave room for the SRTP trailer so protected packets still fit the MTU.
+	return _srtpSend != nullptr ? 1350 - kSrtpMaxOverhead : 1350;
+}
+
+webrtc::VideoEncoderConfig FoxrtcImpl::CreateVideoEncoderConfig(int streamCount)
+{
+	bool screencast = _screenSource != nullptr;
+	webrtc::VideoEncoderConfig encoder_config;
+    switch (_videoCodec.codecType) {
+    case webrtc::kVideoCodecVP8:
+        encoder_config.encoder_specific_settings = new rtc::RefCountedObject<webrtc::VideoEncoderConfig::Vp8EncoderSpecificSettings>(_videoCodec.codecSpecific.VP8);
+        break;
+    case webrtc::kVideoCodecVP9:
+        encoder_config.encoder_specific_settings = new rtc::RefCountedObject<webrtc::VideoEncoderConfig::Vp9EncoderSpecificSettings>(_videoCodec.codecSpecific.VP9);
+        break;
+    default:
+        encoder_config.encoder_specific_settings = new rtc::RefCountedObject<webrtc::VideoEncoderConfig::H264EncoderSpecificSettings>(_videoCodec.codecSpecific.H264);
+        break;
+    }
+    encoder_config.encoder_specific_settings->FillEncoderSpecificSettings(&_videoCodec);
+    encoder_config.content_type = screencast
+        ? webrtc::VideoEncoderConfig::ContentType::kScreen
+        : webrtc::VideoEncoderConfig::ContentType::kRealtimeVideo;
+    encoder_config.number_of_streams = streamCount;
+    // Simulcast only makes sense behind an SFU, so it implies conference mode.
+    encoder_config.video_stream_factory = new rtc::RefCountedObject<EncoderStreamFactory>(_videoCodec.plName, _videoCodec.qpMax,
+        screencast ? _screenMaxFramerate : _videoCodec.maxFramerate, screencast, streamCount > 1);
+	return encoder_config;
+}
+
 int FoxrtcImpl::Init(FoxrtcTransport* transport)
+{
+	return Init(transport, FoxrtcCryptoParams());
+}
+
+int FoxrtcImpl::Init(FoxrtcTransport* transport, const FoxrtcCryptoParams& crypto,
+	const FoxrtcVirtualAudioParams& audio)
+{
+	if (_call != nullptr) {
+		return -1;
+	}
+	// Started here rather than by the voice engine, so that a missing file
+	// fails Init instead of leaving a session without audio.
+	_virtualAudio.reset(new VirtualAudioDevice(audio));
+	if (_virtualAudio->Init() != 0 || Init(transport, crypto) != 0) {
+		_virtualAudio.reset();
+		return -1;
+	}
+	return 0;
+}
+
+int FoxrtcImpl::Init(FoxrtcTransport* transport, const FoxrtcCryptoParams& crypto)
 {
     if (_call != nullptr) {
         return -1;
     }
+    if (crypto.suite != kFoxrtcSrtpNone) {
+        // Without a transport, packets loop back protected with the send key.
+        const bool loopback = transport == nullptr;
+        _srtpSend = new SrtpContext();
+        _srtpRecv = new SrtpContext();
+        if (!_srtpSend->SetSend(crypto.suite, crypto.sendKey, crypto.sendKeyLen) ||
+            !_srtpRecv->SetRecv(crypto.suite,
+                loopback ? crypto.sendKey : crypto.recvKey,
+                loopback ? crypto.sendKeyLen : crypto.recvKeyLen)) {
+            delete _srtpSend;
+            _srtpSend = nullptr;
+            delete _srtpRecv;
+            _srtpRecv = nullptr;
+            return -1;
+        }
+    }
+    _transport = transport;
     LogMessage::ConfigureLogging("tstamp thread info debug");
     _logsink = new rtc::FileRotatingLogSink("./", "foxrtc", 10 * 1024 * 1024, 10);
     _logsink->Init();
@@ -76,7 +209,8 @@ int FoxrtcImpl::Init(FoxrtcTransport* transport)
     VOE.RTP_RTCP = VoERTP_RTCP::GetInterface(VOE.ENGINE);
     VOE.AUDIO_PROC = VoEAudioProcessing::GetInterface(VOE.ENGINE);
     VOE.EXTERNAL_MEDIA = VoEExternalMedia::GetInterface(VOE.ENGINE);
-    VOE.BASE->Init(nullptr, nullptr, _audioDecoderFactory);
+    // Without a virtual device the voice engine opens the sound card.
+    VOE.BASE->Init(_virtualAudio.get(), nullptr, _audioDecoderFactory);
     
     VIE.CAPTURE_SOURCE = new VideoCaptureSource();
     VIE.CAMERA_SOURCE = new VideoCaptureSource();
@@ -93,10 +227,20 @@ int FoxrtcImpl::Init(FoxrtcTransport* transport)
 int FoxrtcImpl::Uninit()
 {
 	if (_call != nullptr) {
+		// The streams send through the transports and SRTP contexts below,
+		// and the call sends their RTCP from its process thread, so both go
+		// first.
+		DeleteLocalVideoStream();
+		DeleteRemoteVideoStream();
+		DeleteLocalAudioStream();
+		DeleteRemoteAudioStream();
+		delete _call;
+		_call = nullptr;
 		if (VIE.DEVICE != nullptr) {
 			delete VIE.DEVICE;
 			VIE.DEVICE = nullptr;
 		}
+		_screenSource.reset();
 		if (VIE.CAPTURE_SOURCE != nullptr) {
 			VIE.CAPTURE_SOURCE->StopCapture();
 			delete VIE.CAPTURE_SOURCE;
@@ -128,10 +272,18 @@ int FoxrtcImpl::Uninit()
 			VOE.AUDIO_STATE = nullptr;
 			VOE.LOCAL_ID = -1;
 		}
+		_virtualAudio.reset();
 		if (_logsink != nullptr) {
 			LogMessage::RemoveLogToStream(_logsink);
 			_logsink = nullptr;
 		}
+		_audioSendTransport.reset();
+		_videoSendTransport.reset();
+		delete _srtpSend;
+		_srtpSend = nullptr;
+		delete _srtpRecv;
+		_srtpRecv = nullptr;
+		_transport = nullptr;
 	}
 	return 0;
 }
@@ -150,19 +302,62 @@ int FoxrtcImpl::CloseCamera()
 	return 0;
 }
 
+int FoxrtcImpl::StartScreenShare(int screenId, int maxFramerate)
+{
+	// EncoderStreamFactory has no screen content layers for simulcast.
+	if (_call == nullptr || _screenSource != nullptr || _videoStreamCount > 1) {
+		return -1;
+	}
+	_screenSource.reset(new DesktopCaptureSource());
+	if (_screenSource->StartCapture(screenId, maxFramerate, _screenDifferThreads) != 0) {
+		_screenSource.reset();
+		return -1;
+	}
+	_screenMaxFramerate = maxFramerate;
+	if (_videoSendStream != nullptr) {
+		_videoSendStream->ReconfigureVideoEncoder(CreateVideoEncoderConfig(_videoStreamCount));
+		_videoSendStream->SetSource(_screenSource.get());
+	}
+	return 0;
+}
+
+int FoxrtcImpl::StopScreenShare()
+{
+	if (_screenSource == nullptr) {
+		return -1;
+	}
+	if (_videoSendStream != nullptr) {
+		_videoSendStream->SetSource(VIE.CAPTURE_SOURCE);
+	}
+	_screenSource.reset();
+	if (_videoSendStream != nullptr) {
+		_videoSendStream->ReconfigureVideoEncoder(CreateVideoEncoderConfig(_videoStreamCount));
+	}
+	return 0;
+}
+
+int FoxrtcImpl::SetScreenShareDifferThreads(int threads)
+{
+	if (threads < 1 || threads > static_cast<int>(webrtc::CpuInfo::DetectNumberOfCores())) {
+		return -1;
+	}
+	_screenDifferThreads = threads;
+	return 0;
+}
+
 int FoxrtcImpl::CreateLocalAudioStream(unsigned int ssrc)
 {
 	if (_audioSendStream != nullptr) {
 		return -1;
 	}
-    _audioSendTransport = new AudioLoopbackTransport();
-	AudioSendStream::Config streamConfig(_audioSendTransport);
+	AudioSendStream::Config streamConfig(SendTransport(MediaType::AUDIO));
 	streamConfig.voe_channel_id = VOE.LOCAL_ID;
 	streamConfig.rtp.ssrc = ssrc;
 	VOE.LOCAL_SSRC = ssrc;
 	_audioSendStream =
 		_call->CreateAudioSendStream(std::move(streamConfig));
 	//VOE.CODEC->SetSendCodec(VOE.LOCAL_ID, audioCodec);
+	ApplyOpusCpuAdaptation();
 	VOE.AUDIO_PROC->EnableHighPassFilter(true);
 	VOE.CODEC->SetVADStatus(VOE.LOCAL_ID, true, kVadAggressiveMid);
 #ifndef UMCS_IOS
@@ -179,16 +374,50 @@ int FoxrtcImpl::CreateLocalAudioStream(unsigned int ssrc)
 
 int FoxrtcImpl::DeleteLocalAudioStream()
 {
-	if (_audioSendStream != nullptr)
-    {
-        return 0;
-    }
+	if (_audioSendStream == nullptr) {
+		return -1;
+	}
 	_audioSendStream->Stop();
 	_call->DestroyAudioSendStream(_audioSendStream);
+	_audioSendStream = nullptr;
+	ReleaseSendTransport(MediaType::AUDIO);
 	return 0;
 
 }
 
+int FoxrtcImpl::SetOpusCpuAdaptation(bool enable)
+{
+	_opusCpuAdaptation = enable;
+	if (_audioSendStream == nullptr) {
+		return 0;
+	}
+	return ApplyOpusCpuAdaptation();
+}
+
+int FoxrtcImpl::ApplyOpusCpuAdaptation()
+{
+	if (!_opusCpuAdaptation) {
+		// Fails unless the channel sends Opus, and nothing else adapts.
+		VOE.CODEC->SetOpusCpuAdaptation(VOE.LOCAL_ID, false);
+		return 0;
+	}
+	// Only the Opus encoder adapts, so switch to it first.
+	for (int i = 0; i < VOE.CODEC->NumOfCodecs(); i++) {
+		webrtc::CodecInst codec;
+		if (VOE.CODEC->GetCodec(i, codec) != 0 || STR_CASE_CMP(codec.plname, "opus") != 0) {
+			continue;
+		}
+		// Mono voice, at the encoder's default bitrate for one channel.
+		codec.channels = 1;
+		codec.rate = 32000;
+		if (VOE.CODEC->SetSendCodec(VOE.LOCAL_ID, codec) != 0) {
+			return -1;
+		}
+		return VOE.CODEC->SetOpusCpuAdaptation(VOE.LOCAL_ID, true);
+	}
+	return -1;
+}
+
 
 int FoxrtcImpl::CreateRemoteAudioStream(unsigned int ssrc)
 {
@@ -196,7 +425,7 @@ int FoxrtcImpl::CreateRemoteAudioStream(unsigned int ssrc)
 	AudioReceiveStream::Config streamConfig;
 	streamConfig.rtp.local_ssrc = VOE.LOCAL_SSRC;
 	streamConfig.rtp.remote_ssrc = ssrc;
-	streamConfig.rtcp_send_transport = _audioSendTransport;
+	streamConfig.rtcp_send_transport = SendTransport(MediaType::AUDIO);
 	streamConfig.voe_channel_id = _audioReceiveChannelId;
 	streamConfig.decoder_factory = _audioDecoderFactory;
 	_audioReceiveStream = _call->CreateAudioReceiveStream(std::move(streamConfig));
@@ -214,57 +443,154 @@ int FoxrtcImpl::DeleteRemoteAudioStream()
 	VOE.BASE->StopPlayout(_audioReceiveChannelId);
 	VOE.BASE->DeleteChannel(_audioReceiveChannelId);
 	_call->DestroyAudioReceiveStream(_audioReceiveStream);
+	_audioReceiveStream = nullptr;
+	ReleaseSendTransport(MediaType::AUDIO);
+	return 0;
+}
+
+int FoxrtcImpl::SetVideoCodecPreference(const int* codecs, int count)
+{
+	if (codecs == nullptr || count <= 0) {
+		return -1;
+	}
+	std::vector<webrtc::VideoCodecType> types;
+	for (int i = 0; i < count; ++i) {
+		switch (codecs[i]) {
+		case kFoxrtcVideoCodecVP8:
+			types.push_back(webrtc::kVideoCodecVP8);
+			break;
+		case kFoxrtcVideoCodecVP9:
+			types.push_back(webrtc::kVideoCodecVP9);
+			break;
+		case kFoxrtcVideoCodecH264:
+			types.push_back(webrtc::kVideoCodecH264);
+			break;
+		default:
+			return -1;
+		}
+	}
+	_videoCodecs.swap(types);
 	return 0;
 }
 
 int FoxrtcImpl::CreateLocalVideoStream(int ssrc, void* view)
 {
-	if (_videoSendStream != nullptr) {
+	return CreateLocalVideoStream(&ssrc, 1, view);
+}
+
+int FoxrtcImpl::CreateLocalVideoStream(const int* ssrcs, int count, void* view)
+{
+	if (_videoSendStream != nullptr || ssrcs == nullptr || count < 1 ||
+		count > webrtc::kMaxSimulcastStreams) {
 		return -1;
 	}
-    _videoSendTransport = new VideoLoopbackTransport();
-	VideoSendStream::Config streamConfig(_videoSendTransport);
-	streamConfig.encoder_settings.payload_name = "VP9";
-	streamConfig.encoder_settings.payload_type = 121;
-	streamConfig.rtp.max_packet_size = 1350;
-	streamConfig.encoder_settings.encoder = webrtc::VideoEncoder::Create(VideoEncoder::kVp9);
-    streamConfig.rtp.ssrcs.push_back(ssrc);
-    VIE.LOCAL_SSRC = ssrc;
-    //VideoEncoderConfig
-    webrtc::VideoEncoderConfig encoder_config;
-    webrtc::VCMCodecDataBase::Codec(webrtc::kVideoCodecVP8, &_videoCodec);
-    encoder_config.encoder_specific_settings = new rtc::RefCountedObject<webrtc::VideoEncoderConfig::Vp8EncoderSpecificSettings>(_videoCodec.codecSpecific.VP8);
-    encoder_config.encoder_specific_settings->FillEncoderSpecificSettings(&_videoCodec);
-    encoder_config.content_type = webrtc::VideoEncoderConfig::ContentType::kRealtimeVideo;
-    encoder_config.number_of_streams = 1;
-    encoder_config.video_stream_factory = new rtc::RefCountedObject<EncoderStreamFactory>(_videoCodec.plName, _videoCodec.qpMax, _videoCodec.maxFramerate, false, false);
-    
+	bool simulcast = count > 1;
+	if (simulcast && _screenSource != nullptr) {
+		return -1;
+	}
+	webrtc::VideoCodecType codecType = webrtc::kVideoCodecUnknown;
+	for (webrtc::VideoCodecType type : _videoCodecs) {
+		// SimulcastEncoderAdapter only handles VP8.
+		if (_videoCodecFactory->IsSupported(type) &&
+			(!simulcast || type == webrtc::kVideoCodecVP8)) {
+			codecType = type;
+			break;
+		}
+	}
+	if (codecType == webrtc::kVideoCodecUnknown) {
+		return -1;
+	}
+	_simulcastEncoder = simulcast;
+	if (simulcast) {
+		// The adapter takes ownership of the factory. More threads than
+		// layers would only sit idle.
+		_videoEncoder = new webrtc::SimulcastEncoderAdapter(
+			new SimulcastVideoEncoderFactory(_videoCodecFactory.get()),
+			_simulcastEncodeThreads < count ? _simulcastEncodeThreads : count);
+	}
+	else {
+		_videoEncoder = _videoCodecFactory->CreateEncoder(codecType);
+	}
+	webrtc::VCMCodecDataBase::Codec(codecType, &_videoCodec);
+	VideoSendStream::Config streamConfig(SendTransport(MediaType::VIDEO));
+	streamConfig.encoder_settings.payload_name = _videoCodec.plName;
+	streamConfig.encoder_settings.payload_type = VideoPayloadType(codecType);
+	streamConfig.rtp.max_packet_size = MaxPacketSize();
+	streamConfig.encoder_settings.encoder = _videoEncoder;
+    for (int i = 0; i < count; ++i) {
+        streamConfig.rtp.ssrcs.push_back(ssrcs[i]);
+    }
+    VIE.LOCAL_SSRC = ssrcs[0];
+	_videoStreamCount = count;
 	_videoSendStream = _call->CreateVideoSendStream(
-		std::move(streamConfig), std::move(encoder_config));
-	_videoSendStream->SetSource(VIE.CAPTURE_SOURCE);
+		std::move(streamConfig), CreateVideoEncoderConfig(count));
+	if (_screenSource != nullptr) {
+		_videoSendStream->SetSource(_screenSource.get());
+	}
+	else {
+		_videoSendStream->SetSource(VIE.CAPTURE_SOURCE);
+	}
 	_videoSendStream->Start();
 	return 0;
 }
 
+int FoxrtcImpl::SetSimulcastEncodeThreads(int threads)
+{
+	if (threads < 1 || threads > webrtc::kMaxSimulcastStreams) {
+		return -1;
+	}
+	_simulcastEncodeThreads = threads;
+	return 0;
+}
+
 int FoxrtcImpl::DeleteLocalVideoStream()
 {
-    if (_videoSendStream != nullptr) {
+    if (_videoSendStream == nullptr) {
         return -1;
     }
 	_videoSendStream->Stop();
 	_call->DestroyVideoSendStream(_videoSendStream);
+	_videoSendStream = nullptr;
+	_videoStreamCount = 0;
+	// The stream no longer uses the encoder, hand it back for the next one.
+	// The simulcast adapter returns its per-layer encoders itself.
+	if (_simulcastEncoder) {
+		delete _videoEncoder;
+		_simulcastEncoder = false;
+	}
+	else {
+		_videoCodecFactory->DestroyEncoder(_videoEncoder);
+	}
+	_videoEncoder = nullptr;
+	ReleaseSendTransport(MediaType::VIDEO);
 	return 0;
 }
 
 int FoxrtcImpl::CreateRemoteVideoStream(int ssrc, void* view)
 {
-	VideoReceiveStream::Config streamConfig(_videoSendTransport);
+	if (_videoReceiveStream != nullptr) {
+		return -1;
+	}
+	VideoReceiveStream::Config streamConfig(SendTransport(MediaType::VIDEO));
 	streamConfig.renderer = &_videoSink;
 	streamConfig.rtp.remote_ssrc = ssrc;
 	streamConfig.rtp.local_ssrc = VIE.LOCAL_SSRC;
-    webrtc::VideoReceiveStream::Decoder decoder;
-    decoder.decoder = webrtc::VideoDecoder::Create(webrtc::VideoDecoder::DecoderType::kVp8);
-    streamConfig.decoders.push_back(decoder);
+    for (webrtc::VideoCodecType type : _videoCodecs) {
+        if (!_videoCodecFactory->IsSupported(type)) {
+            continue;
+        }
+        webrtc::VideoCodec codec;
+        webrtc::VCMCodecDataBase::Codec(type, &codec);
+        webrtc::VideoReceiveStream::Decoder decoder;
+        decoder.decoder = _videoCodecFactory->CreateDecoder(type);
+        decoder.payload_type = VideoPayloadType(type);
+        decoder.payload_name = codec.plName;
+        streamConfig.decoders.push_back(decoder);
+        _videoDecoders.push_back(decoder.decoder);
+    }
+    if (streamConfig.decoders.empty()) {
+        return -1;
+    }
 	streamConfig.rtp.rtcp_xr.receiver_reference_time_report = true;
 	streamConfig.rtp.nack.rtp_history_ms = 2000;
 	_videoReceiveStream = _call->CreateVideoReceiveStream(std::move(streamConfig));
@@ -278,16 +604,62 @@ int FoxrtcImpl::DeleteRemoteVideoStream()
 	}
 	_videoReceiveStream->Stop();
 	_call->DestroyVideoReceiveStream(_videoReceiveStream);
+	_videoReceiveStream = nullptr;
+	for (webrtc::VideoDecoder* decoder : _videoDecoders) {
+		_videoCodecFactory->DestroyDecoder(decoder);
+	}
+	_videoDecoders.clear();
+	ReleaseSendTransport(MediaType::VIDEO);
 	return 0;
 }
 
 int FoxrtcImpl::IncomingData(const char* data, int len)
 {
 	if (_call != nullptr) {
-        webrtc::PacketTime pt;
-		_call->Receiver()->DeliverPacket(MediaType::ANY, (const uint8_t*)data, len, pt);
-		return 0;
+		if (data == nullptr || len < 0) {
+			return -1;
+		}
+		if (_srtpRecv == nullptr) {
+			webrtc::PacketTime pt;
+			_call->Receiver()->DeliverPacket(MediaType::ANY, (const uint8_t*)data, len, pt);
+			return 0;
+		}
+		if (len > (int)sizeof(_recvBuffer)) {
+			return -1;
+		}
+		webrtc::CriticalSectionScoped ls(_recvLocker.get());
+		memcpy(_recvBuffer, data, len);
+		return DeliverPacket(MediaType::ANY, _recvBuffer, len) ==
+			PacketReceiver::DELIVERY_OK ? 0 : -1;
 	}
 	return 0;
 }
 
+int FoxrtcImpl::IncomingDataInPlace(char* data, int len)
+{
+	if (_call != nullptr) {
+		if (data == nullptr || len < 0) {
+			return -1;
+		}
+		return DeliverPacket(MediaType::ANY, (uint8_t*)data, len) ==
+			PacketReceiver::DELIVERY_OK ? 0 : -1;
+	}
+	return 0;
+}
+
+PacketReceiver::DeliveryStatus FoxrtcImpl::DeliverPacket(MediaType mediaType, uint8_t* data, size_t len)
+{
+	if (_srtpRecv != nullptr) {
+		int outLen = 0;
+		bool ok = RtpHeaderParser::IsRtcp(data, len)
+			? _srtpRecv->UnprotectRtcp(data, (int)len, &outLen)
+			: _srtpRecv->UnprotectRtp(data, (int)len, &outLen);
+		if (!ok) {
+			return PacketReceiver::DELIVERY_PACKET_ERROR;
+		}
+		len = outLen;
+	}
+	webrtc::PacketTime pt;
+	return _call->Receiver()->DeliverPacket(mediaType, data, len, pt);
+}
+
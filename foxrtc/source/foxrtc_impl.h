@@ -11,6 +11,7 @@
 #include <webrtc/modules/audio_coding/codecs/builtin_audio_decoder_factory.h>
 #include <webrtc/system_wrappers/include/critical_section_wrapper.h>
 #include <webrtc/system_wrappers/include/rw_lock_wrapper.h>
+#include <webrtc/system_wrappers/include/cpu_info.h>
 #include <webrtc/system_wrappers/include/event_wrapper.h>
 #include <webrtc/modules/video_render/video_render.h>
 #include <webrtc/config.h>
@@ -24,39 +25,69 @@
 #include <webrtc/test/frame_generator_capturer.h>
 #include <webrtc/modules/video_capture/video_capture_factory.h>
 #include <webrtc/modules/video_capture/video_capture.h>
+#include <webrtc/modules/rtp_rtcp/include/rtp_header_parser.h>
 #include "video_sink_proxy.h"
 #include "video_capture_source.h"
+#include "desktop_capture_source.h"
 #include "video_process_bridge.h"
 #include "encoder_stream_factory.h"
+#include "srtp_transport.h"
+#include "video_codec_factory.h"
+#include "virtual_audio_device.h"
 
 using namespace webrtc;
 using namespace rtc;
 
-class AudioLoopbackTransport;
-class VideoLoopbackTransport;
-
 class FoxrtcImpl:public Foxrtc
 {
 public:
 	FoxrtcImpl();
 	virtual ~FoxrtcImpl();
 	virtual int Init(FoxrtcTransport* transport);
+	virtual int Init(FoxrtcTransport* transport, const FoxrtcCryptoParams& crypto);
+	virtual int Init(FoxrtcTransport* transport, const FoxrtcCryptoParams& crypto,
+		const FoxrtcVirtualAudioParams& audio);
 	virtual int Uninit();
 	virtual int GetDeviceInfo();
 	virtual int OpenCamera(int index);
 	virtual int CloseCamera();
+	virtual int StartScreenShare(int screenId, int maxFramerate);
+	virtual int StopScreenShare();
+	virtual int SetScreenShareDifferThreads(int threads);
 	virtual int CreateLocalAudioStream(unsigned int ssrc);
 	virtual int DeleteLocalAudioStream();
+	virtual int SetOpusCpuAdaptation(bool enable);
 	virtual int CreateRemoteAudioStream(unsigned int ssrc);
 	virtual int DeleteRemoteAudioStream();
+	virtual int SetVideoCodecPreference(const int* codecs, int count);
 	virtual int CreateLocalVideoStream(int ssrc, void* view);
+	virtual int CreateLocalVideoStream(const int* ssrcs, int count, void* view);
+	virtual int SetSimulcastEncodeThreads(int threads);
 	virtual int DeleteLocalVideoStream();
 	virtual int CreateRemoteVideoStream(int ssrc, void* view);
 	virtual int DeleteRemoteVideoStream();
 	virtual int IncomingData(const char* data, int len);
+	virtual int IncomingDataInPlace(char* data, int len);
 
 	Call* GetCall();
+	// Replaces the built-in pooled codec factory and takes ownership of
+	// |factory|. Only allowed while no video stream exists.
+	int SetVideoCodecFactory(VideoCodecFactory* factory);
+	// Removes SRTP in place when enabled and hands the packet to the call.
+	PacketReceiver::DeliveryStatus DeliverPacket(MediaType mediaType, uint8_t* data, size_t len);
 private:
+	// The transport the streams of |mediaType| send RTP and RTCP through,
+	// created on first use. Released again once no stream of that type is
+	// left.
+	webrtc::Transport* SendTransport(MediaType mediaType);
+	void ReleaseSendTransport(MediaType mediaType);
+	size_t MaxPacketSize() const;
+	// Encoder settings for |_videoCodec| sent as |streamCount| streams, for
+	// screen content while screen sharing.
+	webrtc::VideoEncoderConfig CreateVideoEncoderConfig(int streamCount);
+	// Applies |_opusCpuAdaptation| to the local audio channel.
+	int ApplyOpusCpuAdaptation();
+
 	Call* _call = nullptr;
 	webrtc::AudioSendStream* _audioSendStream = nullptr;
 	webrtc::AudioReceiveStream* _audioReceiveStream = nullptr;
@@ -67,8 +98,22 @@ private:
 	int _audioReceiveChannelId = -1;
 	int _videoSendChannelId = -1;
 	int _videoReceiveChannelId = -1;
+	bool _opusCpuAdaptation = false;
 
 	webrtc::VideoCodec _videoCodec;
+	std::vector<webrtc::VideoCodecType> _videoCodecs;
+	foxrtc::scoped_ptr<VideoCodecFactory> _videoCodecFactory;
+	webrtc::VideoEncoder* _videoEncoder = nullptr;
+	// Set while the local stream is simulcast; |_videoEncoder| is then a
+	// SimulcastEncoderAdapter, which hands its per-layer encoders back itself.
+	bool _simulcastEncoder = false;
+	int _simulcastEncodeThreads = 1;
+	std::vector<webrtc::VideoDecoder*> _videoDecoders;
+	int _videoStreamCount = 0;
+	// Set while screen sharing, replaces the camera as the local video source.
+	foxrtc::scoped_ptr<DesktopCaptureSource> _screenSource;
+	int _screenMaxFramerate = 0;
+	int _screenDifferThreads = 1;
 
 	VideoSinkProxy _videoSink;
 
@@ -76,7 +121,15 @@ private:
 	webrtc::Atomic32* _stream_id = new Atomic32(0);
 	rtc::scoped_refptr<webrtc::AudioDecoderFactory> _audioDecoderFactory = CreateBuiltinAudioDecoderFactory();
 
-	//for test
-	AudioLoopbackTransport* _audioSendTransport = nullptr;
-	VideoLoopbackTransport* _videoSendTransport = nullptr;
+	FoxrtcTransport* _transport = nullptr;
+	// Set when Init asked for a virtual audio device, replaces the sound card.
+	foxrtc::scoped_ptr<VirtualAudioDevice> _virtualAudio;
+	SrtpContext* _srtpSend = nullptr;
+	SrtpContext* _srtpRecv = nullptr;
+	// IncomingData gets a const buffer, so SRTP is removed from a copy.
+	foxrtc::scoped_ptr<webrtc::CriticalSectionWrapper> _recvLocker;
+	uint8_t _recvBuffer[IP_PACKET_SIZE + kSrtpMaxOverhead];
+
+	foxrtc::scoped_ptr<OwnedTransport> _audioSendTransport;
+	foxrtc::scoped_ptr<OwnedTransport> _videoSendTransport;
 };
@@ -0,0 +1,99 @@
+#include <math.h>
+#include <time.h>
+#include <vector>
+#include <webrtc/base/criticalsection.h>
+#include <webrtc/base/event.h>
+#include <webrtc/base/timeutils.h>
+#include <webrtc/test/gtest.h>
+#include <webrtc/test/testsupport/perf_test.h>
+#include "foxrtc.h"
+
+namespace {
+
+// The Foxrtc instance owns its call and reads the wall clock, so unlike
+// MultiSessionPerfTest this runs in real time.
+const int kWarmupMs = 1000;
+const int kMeasurementMs = 3000;
+const int kSampleRate = 48000;
+const unsigned int kAudioSsrc = 0x5000;
+
+// Counts the samples the virtual audio device plays out.
+class PlayoutCounter :public FoxrtcAudioSink {
+public:
+	virtual void OnPlayoutData(const short* samples, int samplesPerChannel, int channels, int sampleRate)
+	{
+		bool audible = false;
+		for (int i = 0; i < samplesPerChannel * channels; i++) {
+			if (samples[i] != 0) {
+				audible = true;
+				break;
+			}
+		}
+		rtc::CritScope lock(&_crit);
+		_samples += samplesPerChannel;
+		if (audible) {
+			_audibleSamples += samplesPerChannel;
+		}
+	}
+	int64_t Samples() {
+		rtc::CritScope lock(&_crit);
+		return _samples;
+	}
+	int64_t AudibleSamples() {
+		rtc::CritScope lock(&_crit);
+		return _audibleSamples;
+	}
+private:
+	rtc::CriticalSection _crit;
+	int64_t _samples = 0;
+	int64_t _audibleSamples = 0;
+};
+
+}
+
+// One audio session through the Foxrtc API, looped back into its own call,
+// with a virtual audio device instead of the sound card. Reports the CPU it
+// takes, next to the sessions MultiSessionPerfTest runs on Call directly.
+TEST(FoxrtcPerfTest, LoopbackAudioSession)
+{
+	// A second of a 440 Hz tone.
+	std::vector<short> tone(kSampleRate);
+	for (size_t i = 0; i < tone.size(); i++) {
+		tone[i] = static_cast<short>(8000 * sin(2 * M_PI * 440 * i / kSampleRate));
+	}
+	PlayoutCounter counter;
+	FoxrtcVirtualAudioParams audio;
+	audio.inputSamples = &tone[0];
+	audio.inputSampleCount = static_cast<int>(tone.size());
+	audio.outputSink = &counter;
+	audio.sampleRate = kSampleRate;
+	audio.channels = 1;
+
+	Foxrtc& foxrtc = Foxrtc::Instance();
+	ASSERT_EQ(0, foxrtc.Init(nullptr, FoxrtcCryptoParams(), audio));
+	EXPECT_EQ(0, foxrtc.CreateLocalAudioStream(kAudioSsrc));
+	EXPECT_EQ(0, foxrtc.CreateRemoteAudioStream(kAudioSsrc));
+
+	rtc::Event wait(false, false);
+	wait.Wait(kWarmupMs);
+	int64_t startSamples = counter.Samples();
+	int64_t startAudibleSamples = counter.AudibleSamples();
+	clock_t startCpu = clock();
+	int64_t startMs = rtc::TimeMillis();
+	wait.Wait(kMeasurementMs);
+	double cpuMs = 1000.0 * (clock() - startCpu) / CLOCKS_PER_SEC;
+	int64_t wallMs = rtc::TimeMillis() - startMs;
+	int64_t samples = counter.Samples() - startSamples;
+	int64_t audibleSamples = counter.AudibleSamples() - startAudibleSamples;
+
+	EXPECT_EQ(0, foxrtc.DeleteRemoteAudioStream());
+	EXPECT_EQ(0, foxrtc.DeleteLocalAudioStream());
+	EXPECT_EQ(0, foxrtc.Uninit());
+
+	// The device plays out on its own 10 ms schedule, received or not.
+	EXPECT_NEAR(kSampleRate * wallMs / 1000, samples, kSampleRate / 10);
+	EXPECT_GT(audibleSamples, samples / 2) << "The tone did not loop back.";
+	// In percent of one core.
+	webrtc::test::PrintResult("cpu_per_session", "", "foxrtc_loopback_audio",
+		static_cast<size_t>(100 * cpuMs / (wallMs > 0 ? wallMs : 1)), "%", true);
+}
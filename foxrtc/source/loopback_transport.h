@@ -1,44 +1,59 @@
 #pragma once
+#include <string.h>
 #include <webrtc/transport.h>
 #include <webrtc/call.h>
 #include "foxrtc_impl.h"
 
-class AudioLoopbackTransport :public webrtc::Transport {
+// Loops packets back into the local call. Packets go through
+// FoxrtcImpl::DeliverPacket so that SRTP, when enabled, is removed again.
+class LoopbackTransport :public OwnedTransport {
 public:
+	explicit LoopbackTransport(webrtc::MediaType mediaType) :_mediaType(mediaType) {}
 	virtual bool SendRtp(const uint8_t* packet, size_t length, const webrtc::PacketOptions& options)
 	{
-		webrtc::Call* call = ((FoxrtcImpl*)&Foxrtc::Instance())->GetCall();
-		rtc::PacketTime pTime = rtc::CreatePacketTime(0);
-		webrtc::PacketReceiver::DeliveryStatus status = call->Receiver()->DeliverPacket(webrtc::MediaType::AUDIO, packet, length, webrtc::PacketTime(pTime.timestamp, pTime.not_before));
-		assert(status == webrtc::PacketReceiver::DeliveryStatus::DELIVERY_OK);
-		return true;
+		return Deliver(packet, length);
 	}
 	virtual bool SendRtcp(const uint8_t* packet, size_t length)
 	{
-		Call* call = ((FoxrtcImpl*)&Foxrtc::Instance())->GetCall();
-		rtc::PacketTime pTime = rtc::CreatePacketTime(0);
-		webrtc::PacketReceiver::DeliveryStatus status = call->Receiver()->DeliverPacket(webrtc::MediaType::AUDIO, packet, length, webrtc::PacketTime(pTime.timestamp, pTime.not_before));
+		return Deliver(packet, length);
+	}
+private:
+	bool Deliver(const uint8_t* packet, size_t length)
+	{
+		uint8_t buffer[IP_PACKET_SIZE + kSrtpMaxOverhead];
+		if (length > sizeof(buffer)) {
+			return false;
+		}
+		memcpy(buffer, packet, length);
+		webrtc::PacketReceiver::DeliveryStatus status = ((FoxrtcImpl*)&Foxrtc::Instance())->DeliverPacket(_mediaType, buffer, length);
 		assert(status == webrtc::PacketReceiver::DeliveryStatus::DELIVERY_OK);
 		return true;
 	}
+	const webrtc::MediaType _mediaType;
+};
+
+class AudioLoopbackTransport :public LoopbackTransport {
+public:
+	AudioLoopbackTransport() :LoopbackTransport(webrtc::MediaType::AUDIO) {}
 };
 
-class VideoLoopbackTransport :public webrtc::Transport {
+class VideoLoopbackTransport :public LoopbackTransport {
 public:
+	VideoLoopbackTransport() :LoopbackTransport(webrtc::MediaType::VIDEO) {}
+};
+
+// Hands packets to the application supplied FoxrtcTransport.
+class FoxrtcTransportAdapter :public OwnedTransport {
+public:
+	explicit FoxrtcTransportAdapter(FoxrtcTransport* transport) :_transport(transport) {}
 	virtual bool SendRtp(const uint8_t* packet, size_t length, const webrtc::PacketOptions& options)
 	{
-		Call* call = ((FoxrtcImpl*)&Foxrtc::Instance())->GetCall();
-		rtc::PacketTime pTime = rtc::CreatePacketTime(0);
-		webrtc::PacketReceiver::DeliveryStatus status = call->Receiver()->DeliverPacket(webrtc::MediaType::VIDEO, packet, length, webrtc::PacketTime(pTime.timestamp, pTime.not_before));
-		assert(status == webrtc::PacketReceiver::DeliveryStatus::DELIVERY_OK);
-		return true;
+		return _transport->SendRtp((const char*)packet, (int)length) >= 0;
 	}
 	virtual bool SendRtcp(const uint8_t* packet, size_t length)
 	{
-		Call* call = ((FoxrtcImpl*)&Foxrtc::Instance())->GetCall();
-		rtc::PacketTime pTime = rtc::CreatePacketTime(0);
-		webrtc::PacketReceiver::DeliveryStatus status = call->Receiver()->DeliverPacket(webrtc::MediaType::VIDEO, packet, length, webrtc::PacketTime(pTime.timestamp, pTime.not_before));
-		assert(status == webrtc::PacketReceiver::DeliveryStatus::DELIVERY_OK);
-		return true;
+		return _transport->SendRtcp((const char*)packet, (int)length) >= 0;
 	}
+private:
+	FoxrtcTransport* _transport;
 };
@@ -0,0 +1,196 @@
+#pragma once
+#include <string.h>
+#include <webrtc/transport.h>
+#include <webrtc/base/logging.h>
+#include <webrtc/base/sslstreamadapter.h>
+#include <webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h>
+#include <webrtc/system_wrappers/include/critical_section_wrapper.h>
+#include "third_party/libsrtp/include/srtp.h"
+#include "scoped_ptr.h"
+
+// Upper bound of what protection adds to a packet: the auth tag plus, for
+// SRTCP, the 4 byte E-flag/index word.
+static const int kSrtpMaxOverhead = SRTP_MAX_TRAILER_LEN + 4;
+
+// One libsrtp session for a single direction. Unlike cricket::SrtpSession it
+// is not bound to a thread, since audio, video (pacer) and RTCP (process
+// thread) all send through the same context; calls are serialized instead.
+class SrtpContext
+{
+public:
+	SrtpContext() :
+		_locker(webrtc::CriticalSectionWrapper::CreateCriticalSection()) {
+	}
+	~SrtpContext() {
+		if (_session != nullptr) {
+			srtp_dealloc(_session);
+		}
+	}
+
+	bool SetSend(int suite, const uint8_t* key, size_t len) {
+		return SetKey(ssrc_any_outbound, suite, key, len);
+	}
+	bool SetRecv(int suite, const uint8_t* key, size_t len) {
+		return SetKey(ssrc_any_inbound, suite, key, len);
+	}
+
+	// All of these work in place. |max_len| must leave room for
+	// kSrtpMaxOverhead, which callers reserve when sizing their buffers.
+	bool ProtectRtp(uint8_t* data, int in_len, int max_len, int* out_len) {
+		webrtc::CriticalSectionScoped ls(_locker.get());
+		if (_session == nullptr || max_len < in_len + kSrtpMaxOverhead) {
+			return false;
+		}
+		*out_len = in_len;
+		return srtp_protect(_session, data, out_len) == srtp_err_status_ok;
+	}
+	bool ProtectRtcp(uint8_t* data, int in_len, int max_len, int* out_len) {
+		webrtc::CriticalSectionScoped ls(_locker.get());
+		if (_session == nullptr || max_len < in_len + kSrtpMaxOverhead) {
+			return false;
+		}
+		*out_len = in_len;
+		return srtp_protect_rtcp(_session, data, out_len) == srtp_err_status_ok;
+	}
+	bool UnprotectRtp(uint8_t* data, int in_len, int* out_len) {
+		webrtc::CriticalSectionScoped ls(_locker.get());
+		if (_session == nullptr) {
+			return false;
+		}
+		*out_len = in_len;
+		return srtp_unprotect(_session, data, out_len) == srtp_err_status_ok;
+	}
+	bool UnprotectRtcp(uint8_t* data, int in_len, int* out_len) {
+		webrtc::CriticalSectionScoped ls(_locker.get());
+		if (_session == nullptr) {
+			return false;
+		}
+		*out_len = in_len;
+		return srtp_unprotect_rtcp(_session, data, out_len) == srtp_err_status_ok;
+	}
+
+private:
+	bool SetKey(int type, int suite, const uint8_t* key, size_t len) {
+		webrtc::CriticalSectionScoped ls(_locker.get());
+		if (_session != nullptr) {
+			LOG(LS_ERROR) << "SRTP session already keyed";
+			return false;
+		}
+		if (!Init()) {
+			return false;
+		}
+		srtp_policy_t policy;
+		memset(&policy, 0, sizeof(policy));
+		// GCM goes through libsrtp's OpenSSL (BoringSSL) backend, which uses
+		// AES-NI/PCLMULQDQ when the CPU has them.
+		switch (suite) {
+		case rtc::SRTP_AES128_CM_SHA1_80:
+			srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtp);
+			srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtcp);
+			break;
+		case rtc::SRTP_AES128_CM_SHA1_32:
+			srtp_crypto_policy_set_aes_cm_128_hmac_sha1_32(&policy.rtp);
+			// RFC 5764: SRTCP always uses the 80 bit tag.
+			srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtcp);
+			break;
+		case rtc::SRTP_AEAD_AES_128_GCM:
+			srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy.rtp);
+			srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy.rtcp);
+			break;
+		case rtc::SRTP_AEAD_AES_256_GCM:
+			srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy.rtp);
+			srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy.rtcp);
+			break;
+		default:
+			LOG(LS_ERROR) << "Unsupported SRTP crypto suite " << suite;
+			return false;
+		}
+		int key_len;
+		int salt_len;
+		if (!rtc::GetSrtpKeyAndSaltLengths(suite, &key_len, &salt_len) ||
+			key == nullptr || len != static_cast<size_t>(key_len + salt_len)) {
+			LOG(LS_ERROR) << "Invalid SRTP key for crypto suite " << suite;
+			return false;
+		}
+		policy.ssrc.type = static_cast<srtp_ssrc_type_t>(type);
+		policy.ssrc.value = 0;
+		policy.key = const_cast<uint8_t*>(key);
+		policy.window_size = 1024;
+		policy.allow_repeat_tx = 1;
+		policy.next = nullptr;
+		int err = srtp_create(&_session, &policy);
+		if (err != srtp_err_status_ok) {
+			_session = nullptr;
+			LOG(LS_ERROR) << "Failed to create SRTP session, err=" << err;
+			return false;
+		}
+		return true;
+	}
+
+	static bool Init() {
+		// srtp_init() is idempotent and may already have been called by
+		// cricket::SrtpSession.
+		static bool inited = srtp_init() == srtp_err_status_ok;
+		return inited;
+	}
+
+	srtp_t _session = nullptr;
+	foxrtc::scoped_ptr<webrtc::CriticalSectionWrapper> _locker;
+};
+
+// webrtc::Transport hides its destructor. Transports that Foxrtc creates and
+// owns derive from this instead, so they can be deleted through it.
+class OwnedTransport :public webrtc::Transport
+{
+public:
+	virtual ~OwnedTransport() {}
+};
+
+// Protects every packet handed to it and forwards the result to |inner|,
+// which it owns. |context| must outlive it.
+// webrtc::Transport hands out const packets, so each one is copied exactly
+// once into a buffer that already has room for the auth tag; protection then
+// runs in place and the buffer is never grown.
+class SrtpTransport :public OwnedTransport
+{
+public:
+	SrtpTransport(OwnedTransport* inner, SrtpContext* context) :
+		_inner(inner)
+		, _context(context)
+		, _locker(webrtc::CriticalSectionWrapper::CreateCriticalSection()) {
+	}
+	virtual bool SendRtp(const uint8_t* packet, size_t length, const webrtc::PacketOptions& options)
+	{
+		webrtc::CriticalSectionScoped ls(_locker.get());
+		int len = 0;
+		if (!Prepare(packet, length) ||
+			!_context->ProtectRtp(_buffer, static_cast<int>(length), sizeof(_buffer), &len)) {
+			return false;
+		}
+		return _inner->SendRtp(_buffer, len, options);
+	}
+	virtual bool SendRtcp(const uint8_t* packet, size_t length)
+	{
+		webrtc::CriticalSectionScoped ls(_locker.get());
+		int len = 0;
+		if (!Prepare(packet, length) ||
+			!_context->ProtectRtcp(_buffer, static_cast<int>(length), sizeof(_buffer), &len)) {
+			return false;
+		}
+		return _inner->SendRtcp(_buffer, len);
+	}
+private:
+	bool Prepare(const uint8_t* packet, size_t length) {
+		if (length + kSrtpMaxOverhead > sizeof(_buffer)) {
+			LOG(LS_WARNING) << "Packet too large for SRTP: " << length;
+			return false;
+		}
+		memcpy(_buffer, packet, length);
+		return true;
+	}
+
+	foxrtc::scoped_ptr<OwnedTransport> _inner;
+	SrtpContext* _context;
+	foxrtc::scoped_ptr<webrtc::CriticalSectionWrapper> _locker;
+	uint8_t _buffer[IP_PACKET_SIZE + kSrtpMaxOverhead];
+};
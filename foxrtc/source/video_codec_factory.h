@@ -0,0 +1,393 @@
+#pragma once
+#include <string.h>
+#include <map>
+#include <vector>
+#include <webrtc/common_types.h>
+#include <webrtc/video_encoder.h>
+#include <webrtc/video_decoder.h>
+#include <webrtc/base/logging.h>
+#include <webrtc/modules/video_coding/include/video_error_codes.h>
+#include <webrtc/modules/video_coding/codecs/h264/include/h264.h>
+#include <webrtc/modules/video_coding/codecs/vp8/simulcast_encoder_adapter.h>
+#include <webrtc/system_wrappers/include/critical_section_wrapper.h>
+#include "scoped_ptr.h"
+
+// Builds the encoders and decoders used by FoxrtcImpl's video streams.
+// Every codec handed out is given back with Destroy* once the stream using it
+// has been destroyed.
+class VideoCodecFactory
+{
+public:
+	virtual ~VideoCodecFactory() {}
+	virtual bool IsSupported(webrtc::VideoCodecType type) = 0;
+	virtual webrtc::VideoEncoder* CreateEncoder(webrtc::VideoCodecType type) = 0;
+	virtual void DestroyEncoder(webrtc::VideoEncoder* encoder) = 0;
+	virtual webrtc::VideoDecoder* CreateDecoder(webrtc::VideoCodecType type) = 0;
+	virtual void DestroyDecoder(webrtc::VideoDecoder* decoder) = 0;
+};
+
+// Field by field, since memcmp would also compare padding and the inactive
+// members of the codecSpecific union.
+inline bool SameSimulcastStream(const webrtc::SimulcastStream& a, const webrtc::SimulcastStream& b)
+{
+	return a.width == b.width &&
+		a.height == b.height &&
+		a.numberOfTemporalLayers == b.numberOfTemporalLayers &&
+		a.maxBitrate == b.maxBitrate &&
+		a.targetBitrate == b.targetBitrate &&
+		a.minBitrate == b.minBitrate &&
+		a.qpMax == b.qpMax;
+}
+
+inline bool SameCodecSpecific(webrtc::VideoCodecType type,
+	const webrtc::VideoCodecUnion& a, const webrtc::VideoCodecUnion& b)
+{
+	switch (type) {
+	case webrtc::kVideoCodecVP8:
+		return a.VP8.pictureLossIndicationOn == b.VP8.pictureLossIndicationOn &&
+			a.VP8.feedbackModeOn == b.VP8.feedbackModeOn &&
+			a.VP8.complexity == b.VP8.complexity &&
+			a.VP8.resilience == b.VP8.resilience &&
+			a.VP8.numberOfTemporalLayers == b.VP8.numberOfTemporalLayers &&
+			a.VP8.denoisingOn == b.VP8.denoisingOn &&
+			a.VP8.errorConcealmentOn == b.VP8.errorConcealmentOn &&
+			a.VP8.automaticResizeOn == b.VP8.automaticResizeOn &&
+			a.VP8.frameDroppingOn == b.VP8.frameDroppingOn &&
+			a.VP8.keyFrameInterval == b.VP8.keyFrameInterval &&
+			a.VP8.tl_factory == b.VP8.tl_factory;
+	case webrtc::kVideoCodecVP9:
+		return a.VP9.complexity == b.VP9.complexity &&
+			a.VP9.resilience == b.VP9.resilience &&
+			a.VP9.numberOfTemporalLayers == b.VP9.numberOfTemporalLayers &&
+			a.VP9.denoisingOn == b.VP9.denoisingOn &&
+			a.VP9.frameDroppingOn == b.VP9.frameDroppingOn &&
+			a.VP9.keyFrameInterval == b.VP9.keyFrameInterval &&
+			a.VP9.adaptiveQpMode == b.VP9.adaptiveQpMode &&
+			a.VP9.automaticResizeOn == b.VP9.automaticResizeOn &&
+			a.VP9.numberOfSpatialLayers == b.VP9.numberOfSpatialLayers &&
+			a.VP9.flexibleMode == b.VP9.flexibleMode &&
+			a.VP9.numberOfThreads == b.VP9.numberOfThreads &&
+			a.VP9.frameParallelDecoding == b.VP9.frameParallelDecoding;
+	case webrtc::kVideoCodecH264:
+		return a.H264.profile == b.H264.profile &&
+			a.H264.frameDroppingOn == b.H264.frameDroppingOn &&
+			a.H264.keyFrameInterval == b.H264.keyFrameInterval &&
+			a.H264.spsLen == b.H264.spsLen &&
+			a.H264.ppsLen == b.H264.ppsLen &&
+			(a.H264.spsLen == 0 || memcmp(a.H264.spsData, b.H264.spsData, a.H264.spsLen) == 0) &&
+			(a.H264.ppsLen == 0 || memcmp(a.H264.ppsData, b.H264.ppsData, a.H264.ppsLen) == 0);
+	default:
+		return true;
+	}
+}
+
+// Keeps an encoder initialized across Release(), so that a stream re-created
+// with the same settings reuses the libvpx context instead of allocating a
+// new one. The first frame after such a reuse is forced to be a key frame.
+class PooledVideoEncoder :public webrtc::VideoEncoder
+{
+public:
+	PooledVideoEncoder(webrtc::VideoCodecType type, webrtc::VideoEncoder* encoder) :
+		_type(type)
+		, _encoder(encoder) {
+		memset(&_codec, 0, sizeof(_codec));
+	}
+	virtual ~PooledVideoEncoder() {
+		if (_inited) {
+			_encoder->Release();
+		}
+	}
+	webrtc::VideoCodecType type() const { return _type; }
+
+	virtual int32_t InitEncode(const webrtc::VideoCodec* codec_settings,
+		int32_t number_of_cores, size_t max_payload_size) {
+		if (_inited && SameSettings(*codec_settings, number_of_cores, max_payload_size)) {
+			_keyFrameRequired = true;
+			return _encoder->SetRates(codec_settings->startBitrate,
+				codec_settings->maxFramerate);
+		}
+		_inited = false;
+		int32_t ret = _encoder->InitEncode(codec_settings, number_of_cores, max_payload_size);
+		if (ret == WEBRTC_VIDEO_CODEC_OK) {
+			_inited = true;
+			_codec = *codec_settings;
+			_cores = number_of_cores;
+			_maxPayloadSize = max_payload_size;
+		}
+		return ret;
+	}
+	virtual int32_t RegisterEncodeCompleteCallback(webrtc::EncodedImageCallback* callback) {
+		return _encoder->RegisterEncodeCompleteCallback(callback);
+	}
+	// Deferred: the context stays alive until the settings change or the
+	// encoder is deleted.
+	virtual int32_t Release() {
+		return WEBRTC_VIDEO_CODEC_OK;
+	}
+	virtual int32_t Encode(const webrtc::VideoFrame& frame,
+		const webrtc::CodecSpecificInfo* codec_specific_info,
+		const std::vector<webrtc::FrameType>* frame_types) {
+		if (_keyFrameRequired) {
+			_keyFrameRequired = false;
+			size_t count = frame_types != nullptr && !frame_types->empty() ? frame_types->size() : 1;
+			std::vector<webrtc::FrameType> keyFrames(count, webrtc::kVideoFrameKey);
+			return _encoder->Encode(frame, codec_specific_info, &keyFrames);
+		}
+		return _encoder->Encode(frame, codec_specific_info, frame_types);
+	}
+	virtual int32_t SetChannelParameters(uint32_t packet_loss, int64_t rtt) {
+		return _encoder->SetChannelParameters(packet_loss, rtt);
+	}
+	virtual int32_t SetRates(uint32_t bitrate, uint32_t framerate) {
+		return _encoder->SetRates(bitrate, framerate);
+	}
+	virtual int32_t SetPeriodicKeyFrames(bool enable) {
+		return _encoder->SetPeriodicKeyFrames(enable);
+	}
+	virtual void OnDroppedFrame() {
+		_encoder->OnDroppedFrame();
+	}
+	virtual bool SupportsNativeHandle() const {
+		return _encoder->SupportsNativeHandle();
+	}
+	virtual const char* ImplementationName() const {
+		return _encoder->ImplementationName();
+	}
+
+private:
+	// Bitrates are left out since SetRates applies them without a re-init.
+	bool SameSettings(const webrtc::VideoCodec& codec, int cores, size_t maxPayloadSize) const {
+		return codec.codecType == _codec.codecType &&
+			codec.width == _codec.width &&
+			codec.height == _codec.height &&
+			codec.maxFramerate == _codec.maxFramerate &&
+			codec.qpMax == _codec.qpMax &&
+			codec.mode == _codec.mode &&
+			codec.numberOfSimulcastStreams == _codec.numberOfSimulcastStreams &&
+			cores == _cores &&
+			maxPayloadSize == _maxPayloadSize &&
+			SameSimulcastStreams(codec) &&
+			SameCodecSpecific(codec.codecType, codec.codecSpecific, _codec.codecSpecific);
+	}
+	// Only the configured streams; the rest of the array is unused.
+	bool SameSimulcastStreams(const webrtc::VideoCodec& codec) const {
+		for (unsigned char i = 0; i < codec.numberOfSimulcastStreams && i < webrtc::kMaxSimulcastStreams; ++i) {
+			if (!SameSimulcastStream(codec.simulcastStream[i], _codec.simulcastStream[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	const webrtc::VideoCodecType _type;
+	foxrtc::scoped_ptr<webrtc::VideoEncoder> _encoder;
+	webrtc::VideoCodec _codec;
+	int _cores = 0;
+	size_t _maxPayloadSize = 0;
+	bool _inited = false;
+	bool _keyFrameRequired = false;
+};
+
+// Decoder counterpart of PooledVideoEncoder. A reused decoder still holds
+// references from the previous stream, so input is dropped until a complete
+// key frame replaces them.
+class PooledVideoDecoder :public webrtc::VideoDecoder
+{
+public:
+	PooledVideoDecoder(webrtc::VideoCodecType type, webrtc::VideoDecoder* decoder) :
+		_type(type)
+		, _decoder(decoder) {
+		memset(&_codec, 0, sizeof(_codec));
+	}
+	virtual ~PooledVideoDecoder() {
+		if (_inited) {
+			_decoder->Release();
+		}
+	}
+	webrtc::VideoCodecType type() const { return _type; }
+
+	virtual int32_t InitDecode(const webrtc::VideoCodec* codec_settings, int32_t number_of_cores) {
+		if (_inited && codec_settings->codecType == _codec.codecType &&
+			number_of_cores == _cores &&
+			SameCodecSpecific(_codec.codecType, codec_settings->codecSpecific,
+				_codec.codecSpecific)) {
+			_keyFrameRequired = true;
+			return WEBRTC_VIDEO_CODEC_OK;
+		}
+		_inited = false;
+		int32_t ret = _decoder->InitDecode(codec_settings, number_of_cores);
+		if (ret == WEBRTC_VIDEO_CODEC_OK) {
+			_inited = true;
+			_codec = *codec_settings;
+			_cores = number_of_cores;
+			_keyFrameRequired = false;
+		}
+		return ret;
+	}
+	virtual int32_t Decode(const webrtc::EncodedImage& input_image,
+		bool missing_frames,
+		const webrtc::RTPFragmentationHeader* fragmentation,
+		const webrtc::CodecSpecificInfo* codec_specific_info,
+		int64_t render_time_ms) {
+		if (_keyFrameRequired) {
+			if (input_image._frameType != webrtc::kVideoFrameKey || !input_image._completeFrame) {
+				return WEBRTC_VIDEO_CODEC_ERROR;
+			}
+			_keyFrameRequired = false;
+		}
+		return _decoder->Decode(input_image, missing_frames, fragmentation,
+			codec_specific_info, render_time_ms);
+	}
+	virtual int32_t RegisterDecodeCompleteCallback(webrtc::DecodedImageCallback* callback) {
+		return _decoder->RegisterDecodeCompleteCallback(callback);
+	}
+	// Deferred, see PooledVideoEncoder::Release.
+	virtual int32_t Release() {
+		return WEBRTC_VIDEO_CODEC_OK;
+	}
+	virtual bool PrefersLateDecoding() const {
+		return _decoder->PrefersLateDecoding();
+	}
+	virtual const char* ImplementationName() const {
+		return _decoder->ImplementationName();
+	}
+
+private:
+	const webrtc::VideoCodecType _type;
+	foxrtc::scoped_ptr<webrtc::VideoDecoder> _decoder;
+	webrtc::VideoCodec _codec;
+	int _cores = 0;
+	bool _inited = false;
+	bool _keyFrameRequired = false;
+};
+
+// Built-in codecs, with up to kMaxIdlePerCodec (three) idle encoders and
+// decoders kept per codec type, one for each layer of a three layer simulcast
+// stream. Destroy* only parks a codec; it is deleted when the pool is full or
+// the factory goes away.
+class PooledVideoCodecFactory :public VideoCodecFactory
+{
+public:
+	static const size_t kMaxIdlePerCodec = 3;
+
+	PooledVideoCodecFactory() :
+		_locker(webrtc::CriticalSectionWrapper::CreateCriticalSection()) {
+	}
+	virtual ~PooledVideoCodecFactory() {
+		for (auto& pool : _encoders) {
+			for (PooledVideoEncoder* encoder : pool.second) {
+				delete encoder;
+			}
+		}
+		for (auto& pool : _decoders) {
+			for (PooledVideoDecoder* decoder : pool.second) {
+				delete decoder;
+			}
+		}
+	}
+
+	virtual bool IsSupported(webrtc::VideoCodecType type) {
+		switch (type) {
+		case webrtc::kVideoCodecVP8:
+		case webrtc::kVideoCodecVP9:
+			return true;
+		case webrtc::kVideoCodecH264:
+			return webrtc::H264Encoder::IsSupported() && webrtc::H264Decoder::IsSupported();
+		default:
+			return false;
+		}
+	}
+
+	virtual webrtc::VideoEncoder* CreateEncoder(webrtc::VideoCodecType type) {
+		if (!IsSupported(type)) {
+			return nullptr;
+		}
+		{
+			webrtc::CriticalSectionScoped ls(_locker.get());
+			std::vector<PooledVideoEncoder*>& pool = _encoders[type];
+			if (!pool.empty()) {
+				PooledVideoEncoder* encoder = pool.back();
+				pool.pop_back();
+				return encoder;
+			}
+		}
+		webrtc::VideoEncoder::EncoderType encoderType =
+			type == webrtc::kVideoCodecVP8 ? webrtc::VideoEncoder::kVp8 :
+			type == webrtc::kVideoCodecVP9 ? webrtc::VideoEncoder::kVp9 :
+			webrtc::VideoEncoder::kH264;
+		return new PooledVideoEncoder(type, webrtc::VideoEncoder::Create(encoderType));
+	}
+	virtual void DestroyEncoder(webrtc::VideoEncoder* encoder) {
+		if (encoder == nullptr) {
+			return;
+		}
+		PooledVideoEncoder* pooled = static_cast<PooledVideoEncoder*>(encoder);
+		{
+			webrtc::CriticalSectionScoped ls(_locker.get());
+			std::vector<PooledVideoEncoder*>& pool = _encoders[pooled->type()];
+			if (pool.size() < kMaxIdlePerCodec) {
+				pool.push_back(pooled);
+				return;
+			}
+		}
+		delete pooled;
+	}
+
+	virtual webrtc::VideoDecoder* CreateDecoder(webrtc::VideoCodecType type) {
+		if (!IsSupported(type)) {
+			return nullptr;
+		}
+		{
+			webrtc::CriticalSectionScoped ls(_locker.get());
+			std::vector<PooledVideoDecoder*>& pool = _decoders[type];
+			if (!pool.empty()) {
+				PooledVideoDecoder* decoder = pool.back();
+				pool.pop_back();
+				return decoder;
+			}
+		}
+		webrtc::VideoDecoder::DecoderType decoderType =
+			type == webrtc::kVideoCodecVP8 ? webrtc::VideoDecoder::kVp8 :
+			type == webrtc::kVideoCodecVP9 ? webrtc::VideoDecoder::kVp9 :
+			webrtc::VideoDecoder::kH264;
+		return new PooledVideoDecoder(type, webrtc::VideoDecoder::Create(decoderType));
+	}
+	virtual void DestroyDecoder(webrtc::VideoDecoder* decoder) {
+		if (decoder == nullptr) {
+			return;
+		}
+		PooledVideoDecoder* pooled = static_cast<PooledVideoDecoder*>(decoder);
+		{
+			webrtc::CriticalSectionScoped ls(_locker.get());
+			std::vector<PooledVideoDecoder*>& pool = _decoders[pooled->type()];
+			if (pool.size() < kMaxIdlePerCodec) {
+				pool.push_back(pooled);
+				return;
+			}
+		}
+		delete pooled;
+	}
+
+private:
+	std::map<webrtc::VideoCodecType, std::vector<PooledVideoEncoder*>> _encoders;
+	std::map<webrtc::VideoCodecType, std::vector<PooledVideoDecoder*>> _decoders;
+	foxrtc::scoped_ptr<webrtc::CriticalSectionWrapper> _locker;
+};
+
+// Hands SimulcastEncoderAdapter one VP8 encoder per layer from |factory|.
+class SimulcastVideoEncoderFactory :public webrtc::VideoEncoderFactory
+{
+public:
+	explicit SimulcastVideoEncoderFactory(VideoCodecFactory* factory) :
+		_factory(factory) {
+	}
+	virtual webrtc::VideoEncoder* Create() {
+		return _factory->CreateEncoder(webrtc::kVideoCodecVP8);
+	}
+	virtual void Destroy(webrtc::VideoEncoder* encoder) {
+		_factory->DestroyEncoder(encoder);
+	}
+
+private:
+	VideoCodecFactory* _factory;
+};
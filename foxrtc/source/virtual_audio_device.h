@@ -0,0 +1,260 @@
+#pragma once
+#include <stdio.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <webrtc/base/event.h>
+#include <webrtc/base/platform_thread.h>
+#include <webrtc/base/timeutils.h>
+#include <webrtc/common_audio/wav_file.h>
+#include <webrtc/modules/audio_device/include/fake_audio_device.h>
+#include <webrtc/system_wrappers/include/critical_section_wrapper.h>
+#include "foxrtc.h"
+#include "scoped_ptr.h"
+
+// Audio device without sound hardware, for server-side sessions and
+// benchmarks. The microphone loops a WAV file or an in-memory buffer, and
+// playout goes to a WAV file and/or a FoxrtcAudioSink. One thread exchanges a
+// 10 ms block in each direction per tick, |speed| ticks per 10 ms of wall
+// clock, or back to back when |speed| is 0. Only audio capture, encoding and
+// playout are accelerated; the rest of the engine still runs on the wall
+// clock, so received audio is concealed when playout outruns the network.
+class VirtualAudioDevice : public webrtc::FakeAudioDeviceModule
+{
+public:
+	explicit VirtualAudioDevice(const FoxrtcVirtualAudioParams& params)
+		: _params(params)
+		, _stopEvent(true, false)
+		, _locker(webrtc::CriticalSectionWrapper::CreateCriticalSection())
+	{
+		if (params.inputWavFile != nullptr) {
+			_inputWavFile = params.inputWavFile;
+		}
+		if (params.outputWavFile != nullptr) {
+			_outputWavFile = params.outputWavFile;
+		}
+	}
+	virtual ~VirtualAudioDevice() {
+		Terminate();
+	}
+
+	virtual int32_t RegisterAudioCallback(webrtc::AudioTransport* audioCallback) {
+		webrtc::CriticalSectionScoped ls(_locker.get());
+		_audioCallback = audioCallback;
+		return 0;
+	}
+	virtual int32_t Init() {
+		if (_thread.get() != nullptr) {
+			return 0;
+		}
+		// Audio moves in 10 ms blocks, so rates such as 22050 Hz, which do
+		// not split into whole blocks, are not supported.
+		if (_params.sampleRate <= 0 || _params.sampleRate % 100 != 0 ||
+			_params.channels < 1 || _params.channels > 2 || _params.speed < 0) {
+			return -1;
+		}
+		// WavReader and WavWriter treat a file they cannot open as fatal.
+		if (!_inputWavFile.empty()) {
+			if (!CanOpen(_inputWavFile, "rb")) {
+				return -1;
+			}
+			_wavReader.reset(new webrtc::WavReader(_inputWavFile));
+			if (_wavReader->num_channels() > 2 || _wavReader->sample_rate() % 100 != 0) {
+				_wavReader.reset();
+				return -1;
+			}
+			_recordRate = _wavReader->sample_rate();
+			_recordChannels = _wavReader->num_channels();
+		}
+		else {
+			_recordRate = _params.sampleRate;
+			_recordChannels = _params.channels;
+		}
+		if (!_outputWavFile.empty()) {
+			if (!CanOpen(_outputWavFile, "wb")) {
+				_wavReader.reset();
+				return -1;
+			}
+			_wavWriter.reset(new webrtc::WavWriter(_outputWavFile, _params.sampleRate, _params.channels));
+		}
+		_recordBuffer.assign(_recordRate / 100 * _recordChannels, 0);
+		_playoutBuffer.assign(_params.sampleRate / 100 * _params.channels, 0);
+		_inputPosition = 0;
+		_intervalUs = _params.speed > 0
+			? static_cast<int64_t>(10 * rtc::kNumMicrosecsPerMillisec / _params.speed)
+			: 0;
+		_nextTickUs = rtc::TimeMicros();
+		_stopEvent.Reset();
+		_thread.reset(new rtc::PlatformThread(&VirtualAudioDevice::AudioThread, this, "VirtualAudio"));
+		_thread->Start();
+		// Running back to back, the thread never sleeps, and at realtime
+		// priority it would starve the threads that encode and decode.
+		if (_intervalUs > 0) {
+			_thread->SetPriority(rtc::kRealtimePriority);
+		}
+		return 0;
+	}
+	virtual int32_t Terminate() {
+		if (_thread.get() == nullptr) {
+			return 0;
+		}
+		_stopEvent.Set();
+		_thread->Stop();
+		_thread.reset();
+		_wavReader.reset();
+		_wavWriter.reset();
+		return 0;
+	}
+	virtual bool Initialized() const {
+		return _thread.get() != nullptr;
+	}
+	// Registered with the voice engine's process thread, which has nothing
+	// to poll here.
+	virtual int64_t TimeUntilNextProcess() {
+		return 1000;
+	}
+
+	virtual int32_t StartPlayout() {
+		webrtc::CriticalSectionScoped ls(_locker.get());
+		_playing = true;
+		return 0;
+	}
+	virtual int32_t StopPlayout() {
+		webrtc::CriticalSectionScoped ls(_locker.get());
+		_playing = false;
+		return 0;
+	}
+	virtual bool Playing() const {
+		webrtc::CriticalSectionScoped ls(_locker.get());
+		return _playing;
+	}
+	virtual int32_t StartRecording() {
+		webrtc::CriticalSectionScoped ls(_locker.get());
+		_recording = true;
+		return 0;
+	}
+	virtual int32_t StopRecording() {
+		webrtc::CriticalSectionScoped ls(_locker.get());
+		_recording = false;
+		return 0;
+	}
+	virtual bool Recording() const {
+		webrtc::CriticalSectionScoped ls(_locker.get());
+		return _recording;
+	}
+	virtual int32_t StereoPlayoutIsAvailable(bool* available) const {
+		*available = _params.channels == 2;
+		return 0;
+	}
+	virtual int32_t PlayoutDelay(uint16_t* delayMS) const {
+		*delayMS = 0;
+		return 0;
+	}
+	virtual int32_t RecordingDelay(uint16_t* delayMS) const {
+		*delayMS = 0;
+		return 0;
+	}
+private:
+	static bool CanOpen(const std::string& filename, const char* mode) {
+		FILE* file = fopen(filename.c_str(), mode);
+		if (file == nullptr) {
+			return false;
+		}
+		fclose(file);
+		return true;
+	}
+	static bool AudioThread(void* obj) {
+		return static_cast<VirtualAudioDevice*>(obj)->AudioProcess();
+	}
+	bool AudioProcess() {
+		webrtc::AudioTransport* callback;
+		bool recording;
+		bool playing;
+		{
+			webrtc::CriticalSectionScoped ls(_locker.get());
+			callback = _audioCallback;
+			recording = _recording;
+			playing = _playing;
+		}
+		if (callback != nullptr && recording) {
+			Record(callback);
+		}
+		if (callback != nullptr && playing) {
+			Play(callback);
+		}
+		if (_intervalUs == 0) {
+			return !_stopEvent.Wait(0);
+		}
+		// Ticks follow a fixed schedule, so that a late tick is made up for by
+		// a shorter wait instead of slowing the session down.
+		_nextTickUs += _intervalUs;
+		int64_t waitUs = _nextTickUs - rtc::TimeMicros();
+		if (waitUs < -10 * _intervalUs) {
+			// Too far behind to catch up, start a new schedule.
+			_nextTickUs = rtc::TimeMicros();
+		}
+		return !_stopEvent.Wait(static_cast<int>(std::max<int64_t>(waitUs, 0) / rtc::kNumMicrosecsPerMillisec));
+	}
+	void Record(webrtc::AudioTransport* callback) {
+		size_t samples = _recordBuffer.size();
+		if (_wavReader.get() != nullptr) {
+			size_t read = _wavReader->ReadSamples(samples, &_recordBuffer[0]);
+			if (read < samples) {
+				// Loop, WavReader cannot seek back to the first sample.
+				_wavReader.reset(new webrtc::WavReader(_inputWavFile));
+				read += _wavReader->ReadSamples(samples - read, &_recordBuffer[read]);
+				std::fill(_recordBuffer.begin() + read, _recordBuffer.end(), 0);
+			}
+		}
+		else if (_params.inputSamples != nullptr && _params.inputSampleCount > 0) {
+			for (size_t i = 0; i < samples; i++) {
+				_recordBuffer[i] = _params.inputSamples[_inputPosition];
+				if (++_inputPosition == _params.inputSampleCount) {
+					_inputPosition = 0;
+				}
+			}
+		}
+		uint32_t newMicLevel = 0;
+		callback->RecordedDataIsAvailable(&_recordBuffer[0], samples / _recordChannels,
+			2 * _recordChannels, _recordChannels, _recordRate, 0, 0, 0, false, newMicLevel);
+	}
+	void Play(webrtc::AudioTransport* callback) {
+		size_t frames = _playoutBuffer.size() / _params.channels;
+		size_t framesOut = 0;
+		int64_t elapsedTimeMs = -1;
+		int64_t ntpTimeMs = -1;
+		if (callback->NeedMorePlayData(frames, 2 * _params.channels, _params.channels,
+			_params.sampleRate, &_playoutBuffer[0], framesOut, &elapsedTimeMs, &ntpTimeMs) != 0) {
+			return;
+		}
+		framesOut = std::min(framesOut, frames);
+		if (_wavWriter.get() != nullptr) {
+			_wavWriter->WriteSamples(&_playoutBuffer[0], framesOut * _params.channels);
+		}
+		if (_params.outputSink != nullptr) {
+			_params.outputSink->OnPlayoutData(&_playoutBuffer[0], static_cast<int>(framesOut),
+				_params.channels, _params.sampleRate);
+		}
+	}
+
+	const FoxrtcVirtualAudioParams _params;
+	std::string _inputWavFile;
+	std::string _outputWavFile;
+	// Only touched on the audio thread while it runs.
+	foxrtc::scoped_ptr<webrtc::WavReader> _wavReader;
+	foxrtc::scoped_ptr<webrtc::WavWriter> _wavWriter;
+	std::vector<int16_t> _recordBuffer;
+	std::vector<int16_t> _playoutBuffer;
+	int _recordRate = 0;
+	size_t _recordChannels = 0;
+	int _inputPosition = 0;
+	int64_t _intervalUs = 0;
+	int64_t _nextTickUs = 0;
+
+	foxrtc::scoped_ptr<rtc::PlatformThread> _thread;
+	rtc::Event _stopEvent;
+	webrtc::AudioTransport* _audioCallback = nullptr;
+	bool _playing = false;
+	bool _recording = false;
+	foxrtc::scoped_ptr<webrtc::CriticalSectionWrapper> _locker;
+};
@@ -0,0 +1,204 @@
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <webrtc/base/criticalsection.h>
+#include <webrtc/base/event.h>
+#include <webrtc/common_audio/wav_file.h>
+#include <webrtc/test/gtest.h>
+#include <webrtc/test/testsupport/fileutils.h>
+#include "virtual_audio_device.h"
+
+namespace {
+
+const int kEventTimeoutMs = 5000;
+
+// Records what the device captures and plays a constant back, until
+// |recordLimit| samples per channel have been captured.
+class RecordingTransport :public webrtc::AudioTransport {
+public:
+	explicit RecordingTransport(size_t recordLimit)
+		: _recordLimit(recordLimit)
+		, _done(true, false) {}
+
+	virtual int32_t RecordedDataIsAvailable(const void* audioSamples, const size_t nSamples,
+		const size_t nBytesPerSample, const size_t nChannels, const uint32_t samplesPerSec,
+		const uint32_t totalDelayMS, const int32_t clockDrift, const uint32_t currentMicLevel,
+		const bool keyPressed, uint32_t& newMicLevel)
+	{
+		rtc::CritScope lock(&_crit);
+		if (_recordedFrames >= _recordLimit) {
+			return 0;
+		}
+		_sampleRate = samplesPerSec;
+		_channels = nChannels;
+		_blockFrames.push_back(nSamples);
+		const int16_t* samples = static_cast<const int16_t*>(audioSamples);
+		_recorded.insert(_recorded.end(), samples, samples + nSamples * nChannels);
+		_recordedFrames += nSamples;
+		if (_recordedFrames >= _recordLimit) {
+			_done.Set();
+		}
+		return 0;
+	}
+	virtual int32_t NeedMorePlayData(const size_t nSamples, const size_t nBytesPerSample,
+		const size_t nChannels, const uint32_t samplesPerSec, void* audioSamples,
+		size_t& nSamplesOut, int64_t* elapsed_time_ms, int64_t* ntp_time_ms)
+	{
+		int16_t* samples = static_cast<int16_t*>(audioSamples);
+		std::fill(samples, samples + nSamples * nChannels, 1000);
+		nSamplesOut = nSamples;
+		return 0;
+	}
+	virtual void PushCaptureData(int voe_channel, const void* audio_data,
+		int bits_per_sample, int sample_rate, size_t number_of_channels,
+		size_t number_of_frames) {}
+	virtual void PullRenderData(int bits_per_sample, int sample_rate,
+		size_t number_of_channels, size_t number_of_frames, void* audio_data,
+		int64_t* elapsed_time_ms, int64_t* ntp_time_ms) {}
+
+	bool Wait() { return _done.Wait(kEventTimeoutMs); }
+	std::vector<int16_t> Recorded() {
+		rtc::CritScope lock(&_crit);
+		return _recorded;
+	}
+	std::vector<size_t> BlockFrames() {
+		rtc::CritScope lock(&_crit);
+		return _blockFrames;
+	}
+	uint32_t SampleRate() {
+		rtc::CritScope lock(&_crit);
+		return _sampleRate;
+	}
+	size_t Channels() {
+		rtc::CritScope lock(&_crit);
+		return _channels;
+	}
+private:
+	const size_t _recordLimit;
+	rtc::Event _done;
+	rtc::CriticalSection _crit;
+	std::vector<int16_t> _recorded;
+	std::vector<size_t> _blockFrames;
+	size_t _recordedFrames = 0;
+	uint32_t _sampleRate = 0;
+	size_t _channels = 0;
+};
+
+// Counts what the device plays out.
+class CountingSink :public FoxrtcAudioSink {
+public:
+	virtual void OnPlayoutData(const short* samples, int samplesPerChannel, int channels, int sampleRate)
+	{
+		rtc::CritScope lock(&_crit);
+		_frames += samplesPerChannel;
+		_channels = channels;
+		_sampleRate = sampleRate;
+		for (int i = 0; i < samplesPerChannel * channels; i++) {
+			if (samples[i] != 1000) {
+				_wrongSamples++;
+			}
+		}
+	}
+	int Frames() {
+		rtc::CritScope lock(&_crit);
+		return _frames;
+	}
+	int Channels() {
+		rtc::CritScope lock(&_crit);
+		return _channels;
+	}
+	int SampleRate() {
+		rtc::CritScope lock(&_crit);
+		return _sampleRate;
+	}
+	int WrongSamples() {
+		rtc::CritScope lock(&_crit);
+		return _wrongSamples;
+	}
+private:
+	rtc::CriticalSection _crit;
+	int _frames = 0;
+	int _channels = 0;
+	int _sampleRate = 0;
+	int _wrongSamples = 0;
+};
+
+// Writes |frames| of a ramp to a new WAV file and returns its name.
+std::string WriteRampWav(int sampleRate, size_t channels, size_t frames)
+{
+	std::string filename = webrtc::test::TempFilename(webrtc::test::OutputPath(), "virtual_audio");
+	std::vector<int16_t> samples(frames * channels);
+	for (size_t i = 0; i < samples.size(); i++) {
+		samples[i] = static_cast<int16_t>(i);
+	}
+	webrtc::WavWriter writer(filename, sampleRate, channels);
+	writer.WriteSamples(&samples[0], samples.size());
+	return filename;
+}
+
+}
+
+TEST(VirtualAudioDeviceTest, PlaysWavFileInTenMsBlocks)
+{
+	// 0.25 s, so that the device loops the file once.
+	const int kFileRate = 16000;
+	const size_t kFileFrames = kFileRate / 4;
+	std::string filename = WriteRampWav(kFileRate, 2, kFileFrames);
+
+	CountingSink sink;
+	FoxrtcVirtualAudioParams params;
+	params.inputWavFile = filename.c_str();
+	params.outputSink = &sink;
+	params.sampleRate = 48000;
+	params.channels = 1;
+	params.speed = 0;
+	RecordingTransport transport(2 * kFileFrames);
+	{
+		VirtualAudioDevice device(params);
+		ASSERT_EQ(0, device.RegisterAudioCallback(&transport));
+		ASSERT_EQ(0, device.StartRecording());
+		ASSERT_EQ(0, device.StartPlayout());
+		ASSERT_EQ(0, device.Init());
+		EXPECT_TRUE(transport.Wait());
+		EXPECT_EQ(0, device.Terminate());
+	}
+	remove(filename.c_str());
+
+	EXPECT_EQ(static_cast<uint32_t>(kFileRate), transport.SampleRate());
+	EXPECT_EQ(2u, transport.Channels());
+	std::vector<size_t> blockFrames = transport.BlockFrames();
+	ASSERT_EQ(2 * kFileFrames / (kFileRate / 100), blockFrames.size());
+	for (size_t frames : blockFrames) {
+		EXPECT_EQ(static_cast<size_t>(kFileRate / 100), frames);
+	}
+	// The file twice over, sample for sample.
+	std::vector<int16_t> recorded = transport.Recorded();
+	ASSERT_EQ(2 * 2 * kFileFrames, recorded.size());
+	for (size_t i = 0; i < recorded.size(); i++) {
+		ASSERT_EQ(static_cast<int16_t>(i % (2 * kFileFrames)), recorded[i]) << i;
+	}
+
+	// Playout ticks along with capture, 10 ms at the playout rate each.
+	EXPECT_EQ(48000, sink.SampleRate());
+	EXPECT_EQ(1, sink.Channels());
+	EXPECT_GE(sink.Frames(), static_cast<int>(blockFrames.size() - 1) * 480);
+	EXPECT_EQ(0, sink.Frames() % 480);
+	EXPECT_EQ(0, sink.WrongSamples());
+}
+
+TEST(VirtualAudioDeviceTest, RejectsRatesWithoutWholeTenMsBlocks)
+{
+	std::string filename = WriteRampWav(22050, 1, 2205);
+	FoxrtcVirtualAudioParams params;
+	params.inputWavFile = filename.c_str();
+	{
+		VirtualAudioDevice device(params);
+		EXPECT_EQ(-1, device.Init());
+	}
+	remove(filename.c_str());
+
+	params.inputWavFile = nullptr;
+	params.sampleRate = 22050;
+	VirtualAudioDevice device(params);
+	EXPECT_EQ(-1, device.Init());
+}
@@ -10,6 +10,7 @@
 
 #include "webrtc/modules/video_render/linux/video_x11_channel.h"
 
+#include "libyuv/convert_from.h"
 #include "webrtc/system_wrappers/include/critical_section_wrapper.h"
 #include "webrtc/system_wrappers/include/trace.h"
 
@@ -23,13 +24,21 @@ static int dispCount = 0;
 
 VideoX11Channel::VideoX11Channel(int32_t id) :
     _crit(*CriticalSectionWrapper::CreateCriticalSection()), _display(NULL),
-          _shminfo(), _image(NULL), _window(0L), _gc(NULL),
+          _completionEventType(0), _window(0L), _gc(NULL),
           _width(DEFAULT_RENDER_FRAME_WIDTH),
           _height(DEFAULT_RENDER_FRAME_HEIGHT), _outWidth(0), _outHeight(0),
-          _xPos(0), _yPos(0), _prepared(false), _dispCount(0), _buffer(NULL),
-          _top(0.0), _left(0.0), _right(0.0), _bottom(0.0),
+          _xPos(0), _yPos(0), _prepared(false), _dispCount(0),
+          _droppedFrames(0), _top(0.0), _left(0.0), _right(0.0), _bottom(0.0),
           _Id(id)
 {
+    for (int i = 0; i < kNumImages; ++i)
+    {
+        _images[i].shminfo.shmid = -1;
+        _images[i].shminfo.shmaddr = NULL;
+        _images[i].image = NULL;
+        _images[i].attached = false;
+        _images[i].busy = false;
+    }
 }
 
 VideoX11Channel::~VideoX11Channel()
@@ -60,15 +69,9 @@ int32_t VideoX11Channel::FrameSizeChange(int32_t width,
                                          int32_t /*numberOfStreams */)
 {
     CriticalSectionScoped cs(&_crit);
-    if (_prepared)
-    {
-        RemoveRenderer();
-    }
-    if (CreateLocalRenderer(width, height) == -1)
-    {
-        return -1;
-    }
-
+    // The images have the size of the render area, frames are scaled to it.
+    _width = width;
+    _height = height;
     return 0;
 }
 
@@ -82,17 +85,66 @@ int32_t VideoX11Channel::DeliverFrame(const VideoFrame& videoFrame) {
     return -1;
   }
 
-  ConvertFromI420(videoFrame, kARGB, 0, _buffer);
+  ProcessCompletionEvents();
+  ShmImage* target = NULL;
+  for (int i = 0; i < kNumImages; ++i) {
+    if (!_images[i].busy) {
+      target = &_images[i];
+      break;
+    }
+  }
+  if (!target) {
+    // The X server has not caught up with the last two frames, rendering
+    // this one as well would only add latency.
+    ++_droppedFrames;
+    return 0;
+  }
 
-  // Put image in window.
-  XShmPutImage(_display, _window, _gc, _image, 0, 0, _xPos, _yPos, _width,
-               _height, True);
+  ConvertFrame(videoFrame, target->image);
 
-  // Very important for the image to update properly!
-  XSync(_display, False);
+  // Put image in window. The X server sends an XShmCompletionEvent once it
+  // has read the image, until then it must not be written to.
+  XShmPutImage(_display, _window, _gc, target->image, 0, 0, _xPos, _yPos,
+               _outWidth, _outHeight, True);
+  target->busy = true;
+  XFlush(_display);
   return 0;
 }
 
+void VideoX11Channel::ProcessCompletionEvents() {
+  XEvent event;
+  while (XCheckTypedEvent(_display, _completionEventType, &event)) {
+    const XShmCompletionEvent* completion =
+        reinterpret_cast<const XShmCompletionEvent*>(&event);
+    for (int i = 0; i < kNumImages; ++i) {
+      if (_images[i].shminfo.shmseg == completion->shmseg) {
+        _images[i].busy = false;
+      }
+    }
+  }
+}
+
+void VideoX11Channel::ConvertFrame(const VideoFrame& videoFrame,
+                                   XImage* image) {
+  rtc::scoped_refptr<VideoFrameBuffer> buffer =
+      videoFrame.video_frame_buffer();
+  if (buffer->width() != _outWidth || buffer->height() != _outHeight) {
+    // Scaling in I420 touches 1.5 instead of 4 bytes per pixel, and when
+    // shrinking tiles the conversion then only runs on the smaller frame.
+    if (!_scaledBuffer || _scaledBuffer->width() != _outWidth ||
+        _scaledBuffer->height() != _outHeight) {
+      _scaledBuffer = I420Buffer::Create(_outWidth, _outHeight);
+    }
+    _scaledBuffer->ScaleFrom(buffer);
+    buffer = _scaledBuffer;
+  }
+  libyuv::I420ToARGB(buffer->DataY(), buffer->StrideY(),
+                     buffer->DataU(), buffer->StrideU(),
+                     buffer->DataV(), buffer->StrideV(),
+                     reinterpret_cast<uint8_t*>(image->data),
+                     image->bytes_per_line, _outWidth, _outHeight);
+}
+
 int32_t VideoX11Channel::GetFrameSize(int32_t& width, int32_t& height)
 {
     width = _width;
@@ -163,7 +215,7 @@ int32_t VideoX11Channel::Init(Window window, float left, float top,
       return -1;
     }
 
-    if (CreateLocalRenderer(winWidth, winHeight) == -1)
+    if (CreateLocalRenderer() == -1)
     {
         return -1;
     }
@@ -200,7 +252,7 @@ int32_t VideoX11Channel::ChangeWindow(Window window)
         _outHeight++;
 
     // Prepare rendering using the
-    if (CreateLocalRenderer(_width, _height) == -1)
+    if (CreateLocalRenderer() == -1)
     {
         return -1;
     }
@@ -226,7 +278,7 @@ int32_t VideoX11Channel::ReleaseWindow()
     return 0;
 }
 
-int32_t VideoX11Channel::CreateLocalRenderer(int32_t width, int32_t height)
+int32_t VideoX11Channel::CreateLocalRenderer()
 {
     WEBRTC_TRACE(kTraceInfo, kTraceVideoRenderer, _Id, "%s",
                  __FUNCTION__);
@@ -244,27 +296,50 @@ int32_t VideoX11Channel::CreateLocalRenderer(int32_t width, int32_t height)
         return -1;
     }
 
-    _width = width;
-    _height = height;
-
-    // create shared memory image
-    _image = XShmCreateImage(_display, CopyFromParent, 24, ZPixmap, NULL,
-                             &_shminfo, _width, _height); // this parameter needs to be the same for some reason.
-    _shminfo.shmid = shmget(IPC_PRIVATE, (_image->bytes_per_line
-            * _image->height), IPC_CREAT | 0777);
-    _shminfo.shmaddr = _image->data = (char*) shmat(_shminfo.shmid, 0, 0);
-    if (_image->data == reinterpret_cast<char*>(-1))
+    if (_outWidth <= 0 || _outHeight <= 0)
     {
         return -1;
     }
-    _buffer = (unsigned char*) _image->data;
-    _shminfo.readOnly = False;
 
-    // attach image to display
-    if (!XShmAttach(_display, &_shminfo))
+    _completionEventType = XShmGetEventBase(_display) + ShmCompletion;
+    for (int i = 0; i < kNumImages; ++i)
     {
-        //printf("XShmAttach failed !\n");
-        return -1;
+        ShmImage& shm = _images[i];
+
+        // create shared memory image
+        shm.image = XShmCreateImage(_display, CopyFromParent, 24, ZPixmap,
+                                    NULL, &shm.shminfo, _outWidth,
+                                    _outHeight);
+        if (!shm.image)
+        {
+            DestroyImages();
+            return -1;
+        }
+        shm.shminfo.shmid = shmget(IPC_PRIVATE, (shm.image->bytes_per_line
+                * shm.image->height), IPC_CREAT | 0777);
+        if (shm.shminfo.shmid == -1)
+        {
+            DestroyImages();
+            return -1;
+        }
+        shm.shminfo.shmaddr = shm.image->data =
+                (char*) shmat(shm.shminfo.shmid, 0, 0);
+        if (shm.image->data == reinterpret_cast<char*>(-1))
+        {
+            shm.shminfo.shmaddr = shm.image->data = NULL;
+            DestroyImages();
+            return -1;
+        }
+        shm.shminfo.readOnly = False;
+
+        // attach image to display
+        if (!XShmAttach(_display, &shm.shminfo))
+        {
+            DestroyImages();
+            return -1;
+        }
+        shm.attached = true;
+        shm.busy = false;
     }
     XSync(_display, False);
 
@@ -283,18 +358,51 @@ int32_t VideoX11Channel::RemoveRenderer()
     }
     _prepared = false;
 
-    // Free the memory.
-    XShmDetach(_display, &_shminfo);
-    XDestroyImage( _image );
-    _image = NULL;
-    shmdt(_shminfo.shmaddr);
-    _shminfo.shmaddr = NULL;
-    _buffer = NULL;
-    shmctl(_shminfo.shmid, IPC_RMID, 0);
-    _shminfo.shmid = 0;
+    if (_droppedFrames > 0)
+    {
+        WEBRTC_TRACE(kTraceInfo, kTraceVideoRenderer, _Id,
+                     "%d frames dropped while the X server was busy.",
+                     _droppedFrames);
+        _droppedFrames = 0;
+    }
+
+    // Let the X server finish reading the images before they go away.
+    XSync(_display, False);
+    ProcessCompletionEvents();
+    DestroyImages();
     return 0;
 }
 
+void VideoX11Channel::DestroyImages()
+{
+    for (int i = 0; i < kNumImages; ++i)
+    {
+        ShmImage& shm = _images[i];
+        if (shm.attached)
+        {
+            XShmDetach(_display, &shm.shminfo);
+            shm.attached = false;
+        }
+        if (shm.image)
+        {
+            XDestroyImage(shm.image);
+            shm.image = NULL;
+        }
+        // Free the memory.
+        if (shm.shminfo.shmaddr)
+        {
+            shmdt(shm.shminfo.shmaddr);
+            shm.shminfo.shmaddr = NULL;
+        }
+        if (shm.shminfo.shmid != -1)
+        {
+            shmctl(shm.shminfo.shmid, IPC_RMID, 0);
+            shm.shminfo.shmid = -1;
+        }
+        shm.busy = false;
+    }
+}
+
 int32_t VideoX11Channel::GetStreamProperties(uint32_t& zOrder,
                                              float& left, float& top,
                                              float& right, float& bottom) const
@@ -55,9 +55,26 @@ public:
 
 private:
 
-    int32_t
-            CreateLocalRenderer(int32_t width, int32_t height);
+    // Double buffering: XShmPutImage only queues the copy, the image must not
+    // be written again until the X server reports completion.
+    struct ShmImage
+    {
+        XShmSegmentInfo shminfo;
+        XImage* image;
+        bool attached;
+        bool busy;
+    };
+    static const int kNumImages = 2;
+
+    // Creates the images in the size of the render area of the window.
+    int32_t CreateLocalRenderer();
     int32_t RemoveRenderer();
+    // Frees whatever part of the images has been created.
+    void DestroyImages();
+    // Marks images the X server is done with as free again, without blocking.
+    void ProcessCompletionEvents();
+    // Scales and converts |videoFrame| into |image|.
+    void ConvertFrame(const VideoFrame& videoFrame, XImage* image);
 
     //FIXME a better place for this method? the GetWidthHeight no longer
     // supported by common_video.
@@ -67,8 +84,10 @@ private:
     CriticalSectionWrapper& _crit;
 
     Display* _display;
-    XShmSegmentInfo _shminfo;
-    XImage* _image;
+    ShmImage _images[kNumImages];
+    int _completionEventType;
+    // Frame scaled to the render size, before conversion to BGRA.
+    rtc::scoped_refptr<I420Buffer> _scaledBuffer;
     Window _window;
     GC _gc;
     int32_t _width; // incoming frame width
@@ -79,8 +98,9 @@ private:
     int32_t _yPos;
     bool _prepared; // true if ready to use
     int32_t _dispCount;
+    // Dropped because both images were still in use by the X server.
+    int32_t _droppedFrames;
 
-    unsigned char* _buffer;
     float _top;
     float _left;
     float _right;
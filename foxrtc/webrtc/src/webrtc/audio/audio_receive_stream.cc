@@ -270,7 +270,10 @@ bool AudioReceiveStream::DeliverRtp(const uint8_t* packet,
                                               header);
   }
 
-  return channel_proxy_->ReceivedRTPPacket(packet, length, packet_time);
+  // The channel parses with the same header extensions, so pass the header on
+  // instead of having it parsed again.
+  return channel_proxy_->ReceivedRTPPacket(packet, length, header,
+                                           packet_time);
 }
 
 VoiceEngine* AudioReceiveStream::voice_engine() const {
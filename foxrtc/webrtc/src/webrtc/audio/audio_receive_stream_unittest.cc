@@ -297,7 +297,7 @@ TEST(AudioReceiveStreamTest, ReceiveRtpPacket) {
   EXPECT_CALL(*helper.channel_proxy(),
               ReceivedRTPPacket(&rtp_packet[0],
                                 rtp_packet.size(),
-                                _))
+                                _, _))
       .WillOnce(Return(true));
   EXPECT_TRUE(
       recv_stream.DeliverRtp(&rtp_packet[0], rtp_packet.size(), packet_time));
@@ -57,6 +57,9 @@
         'exp_filter.h',
         'file.cc',
         'file.h',
+        'fork_join_batch.h',
+        'fork_join_threads.cc',
+        'fork_join_threads.h',
         'format_macros.h',
         'function_view.h',
         'ignore_wundef.h',
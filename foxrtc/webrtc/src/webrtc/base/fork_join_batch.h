@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_BASE_FORK_JOIN_BATCH_H_
+#define WEBRTC_BASE_FORK_JOIN_BATCH_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/fork_join_threads.h"
+#include "webrtc/base/function_view.h"
+#include "webrtc/base/timeutils.h"
+
+namespace rtc {
+
+// Wall-clock time of the work done for one member of a ForkJoinBatch.
+struct ForkJoinBatchStats {
+  int64_t last_us = 0;
+  int64_t max_us = 0;
+  int64_t total_us = 0;
+  uint64_t calls = 0;
+  // Number of calls whose work failed.
+  uint64_t errors = 0;
+};
+
+// Does the same work on many members once per call, e.g. a 10 ms audio tick,
+// spread over ForkJoinThreads::RunRanges(). Keeps a |State| per member for
+// the results of the work, and the timing of every member.
+//
+// Members are not owned and must outlive their membership. A member's index
+// is its position in the order of Add(); removing a member moves the ones
+// after it down one index.
+//
+// The class is not thread-safe; all methods must be called on one thread.
+template <typename Member, typename State>
+class ForkJoinBatch {
+ public:
+  // Uses up to |num_threads| threads, including the calling thread, each
+  // with at least |min_members_per_thread| members.
+  ForkJoinBatch(int num_threads,
+                const char* thread_name,
+                size_t min_members_per_thread)
+      : threads_(num_threads, thread_name, kRealtimePriority),
+        min_members_per_thread_(min_members_per_thread),
+        last_batch_us_(0) {}
+
+  size_t Add(Member* member) {
+    RTC_DCHECK(member);
+    entries_.emplace_back(member);
+    return entries_.size() - 1;
+  }
+
+  // Returns false if |member| was not added.
+  bool Remove(Member* member) {
+    auto it = std::find_if(
+        entries_.begin(), entries_.end(),
+        [member](const Entry& entry) { return entry.member == member; });
+    if (it == entries_.end())
+      return false;
+    entries_.erase(it);
+    return true;
+  }
+
+  size_t size() const { return entries_.size(); }
+  Member* member(size_t index) const { return entries_[index].member; }
+  State& state(size_t index) { return entries_[index].state; }
+  const State& state(size_t index) const { return entries_[index].state; }
+  const ForkJoinBatchStats& stats(size_t index) const {
+    return entries_[index].stats;
+  }
+
+  // Wall-clock time of the last Run(), for all members together.
+  int64_t last_batch_us() const { return last_batch_us_; }
+
+  // Calls |work| with the index of every member, and returns once all calls
+  // have returned. |work| returns false if it failed.
+  void Run(FunctionView<bool(size_t index)> work) {
+    const int64_t start_us = TimeMicros();
+    threads_.RunRanges(entries_.size(), min_members_per_thread_,
+                       [this, &work](size_t begin, size_t end) {
+                         for (size_t i = begin; i < end; ++i)
+                           RunOne(i, work);
+                       });
+    last_batch_us_ = TimeMicros() - start_us;
+  }
+
+ private:
+  struct Entry {
+    explicit Entry(Member* member) : member(member) {}
+
+    Member* member;
+    State state;
+    ForkJoinBatchStats stats;
+  };
+
+  void RunOne(size_t index, FunctionView<bool(size_t index)> work) {
+    const int64_t start_us = TimeMicros();
+    const bool ok = work(index);
+    const int64_t elapsed_us = TimeMicros() - start_us;
+
+    ForkJoinBatchStats& stats = entries_[index].stats;
+    stats.last_us = elapsed_us;
+    stats.max_us = std::max(stats.max_us, elapsed_us);
+    stats.total_us += elapsed_us;
+    ++stats.calls;
+    if (!ok)
+      ++stats.errors;
+  }
+
+  std::vector<Entry> entries_;
+  ForkJoinThreads threads_;
+  const size_t min_members_per_thread_;
+  int64_t last_batch_us_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ForkJoinBatch);
+};
+
+}  // namespace rtc
+
+#endif  // WEBRTC_BASE_FORK_JOIN_BATCH_H_
@@ -0,0 +1,79 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/fork_join_batch.h"
+
+#include <vector>
+
+#include "webrtc/test/gtest.h"
+
+namespace rtc {
+namespace {
+
+struct Counter {
+  int value = 0;
+};
+
+struct Result {
+  int value = -1;
+};
+
+using CounterBatch = ForkJoinBatch<Counter, Result>;
+
+}  // namespace
+
+TEST(ForkJoinBatchTest, AddAndRemoveMembers) {
+  Counter a, b, c;
+  CounterBatch batch(1, "ForkJoinBatchTest", 1);
+
+  EXPECT_EQ(0u, batch.Add(&a));
+  EXPECT_EQ(1u, batch.Add(&b));
+  EXPECT_EQ(2u, batch.Add(&c));
+  batch.state(2).value = 7;
+  EXPECT_TRUE(batch.Remove(&b));
+  EXPECT_FALSE(batch.Remove(&b));
+
+  ASSERT_EQ(2u, batch.size());
+  EXPECT_EQ(&a, batch.member(0));
+  EXPECT_EQ(&c, batch.member(1));
+  EXPECT_EQ(7, batch.state(1).value);
+}
+
+TEST(ForkJoinBatchTest, RunsEveryMemberOnceAndCountsErrors) {
+  const int kMembers = 13;
+  const int kRuns = 5;
+  for (int num_threads : {1, 4}) {
+    std::vector<Counter> counters(kMembers);
+    CounterBatch batch(num_threads, "ForkJoinBatchTest", 2);
+    for (Counter& counter : counters)
+      batch.Add(&counter);
+
+    for (int run = 0; run < kRuns; ++run) {
+      batch.Run([&batch](size_t index) {
+        Counter* counter = batch.member(index);
+        batch.state(index).value = ++counter->value;
+        // Every third member fails.
+        return index % 3 != 0;
+      });
+    }
+
+    for (int i = 0; i < kMembers; ++i) {
+      EXPECT_EQ(kRuns, batch.state(i).value);
+      const ForkJoinBatchStats& stats = batch.stats(i);
+      EXPECT_EQ(static_cast<uint64_t>(kRuns), stats.calls);
+      EXPECT_EQ(i % 3 == 0 ? static_cast<uint64_t>(kRuns) : 0u, stats.errors);
+      EXPECT_LE(stats.last_us, stats.max_us);
+      EXPECT_LE(stats.max_us, stats.total_us);
+    }
+    EXPECT_GE(batch.last_batch_us(), 0);
+  }
+}
+
+}  // namespace rtc
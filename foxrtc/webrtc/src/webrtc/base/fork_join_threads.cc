@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/fork_join_threads.h"
+
+#include <algorithm>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/event.h"
+
+namespace rtc {
+
+// Runs one task at a time on a thread of its own.
+class ForkJoinThreads::Thread {
+ public:
+  Thread(const char* thread_name, ThreadPriority priority)
+      : thread_(&Thread::Run, this, thread_name),
+        start_event_(false, false),
+        done_event_(false, false),
+        stopping_(false),
+        task_(nullptr),
+        index_(0) {
+    thread_.Start();
+    thread_.SetPriority(priority);
+  }
+
+  ~Thread() {
+    stopping_ = true;
+    start_event_.Set();
+    thread_.Stop();
+  }
+
+  // |task| must stay valid until Wait() returns.
+  void RunAsync(const FunctionView<void(size_t)>* task, size_t index) {
+    task_ = task;
+    index_ = index;
+    start_event_.Set();
+  }
+
+  void Wait() { done_event_.Wait(Event::kForever); }
+
+ private:
+  static bool Run(void* obj) { return static_cast<Thread*>(obj)->Process(); }
+
+  bool Process() {
+    start_event_.Wait(Event::kForever);
+    if (stopping_)
+      return false;
+    (*task_)(index_);
+    done_event_.Set();
+    return true;
+  }
+
+  PlatformThread thread_;
+  // |start_event_| and |done_event_| hand the members below back and forth
+  // between the calling thread and |thread_|.
+  Event start_event_;
+  Event done_event_;
+  bool stopping_;
+  const FunctionView<void(size_t)>* task_;
+  size_t index_;
+};
+
+ForkJoinThreads::ForkJoinThreads(int num_threads,
+                                 const char* thread_name,
+                                 ThreadPriority priority) {
+  RTC_DCHECK_GE(num_threads, 1);
+  for (int i = 1; i < num_threads; ++i)
+    threads_.emplace_back(new Thread(thread_name, priority));
+}
+
+ForkJoinThreads::~ForkJoinThreads() {}
+
+void ForkJoinThreads::Run(size_t num_tasks, FunctionView<void(size_t)> task) {
+  RTC_DCHECK_LE(num_tasks, num_threads());
+  if (num_tasks == 0)
+    return;
+  for (size_t i = 1; i < num_tasks; ++i)
+    threads_[i - 1]->RunAsync(&task, i);
+  task(0);
+  for (size_t i = 1; i < num_tasks; ++i)
+    threads_[i - 1]->Wait();
+}
+
+void ForkJoinThreads::RunRanges(
+    size_t count,
+    size_t min_per_thread,
+    FunctionView<void(size_t begin, size_t end)> task) {
+  RTC_DCHECK_GE(min_per_thread, 1u);
+  const size_t num_tasks = std::max<size_t>(
+      1, std::min(num_threads(), count / min_per_thread));
+  const size_t per_task = (count + num_tasks - 1) / num_tasks;
+  Run(num_tasks, [count, per_task, &task](size_t i) {
+    task(std::min(count, i * per_task), std::min(count, (i + 1) * per_task));
+  });
+}
+
+}  // namespace rtc
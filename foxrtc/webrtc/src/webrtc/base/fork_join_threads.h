@@ -0,0 +1,69 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_BASE_FORK_JOIN_THREADS_H_
+#define WEBRTC_BASE_FORK_JOIN_THREADS_H_
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/function_view.h"
+#include "webrtc/base/platform_thread.h"
+
+namespace rtc {
+
+// Runs a few tasks in parallel and returns once all of them are done, for
+// work that has to be finished within a deadline, such as one 10 ms audio
+// tick. The calling thread runs the first task. The other tasks run on
+// threads that are started once and then wait for work, so no thread is
+// created per call.
+//
+// Handing a task to a thread and waiting for it costs two thread wake-ups,
+// about 15 us on one x86-64 core, so every task should take considerably
+// longer than that. RunRanges() only wakes as many threads as the work per
+// thread justifies.
+//
+// The class is not thread-safe; all methods must be called on one thread.
+class ForkJoinThreads {
+ public:
+  // Runs tasks on up to |num_threads| threads, including the calling thread.
+  ForkJoinThreads(int num_threads,
+                  const char* thread_name,
+                  ThreadPriority priority);
+  ~ForkJoinThreads();
+
+  // Includes the calling thread.
+  size_t num_threads() const { return threads_.size() + 1; }
+
+  // Calls |task| once with every index in [0, num_tasks), each call on a
+  // different thread, and returns when all calls have returned. |num_tasks|
+  // must not exceed num_threads().
+  void Run(size_t num_tasks, FunctionView<void(size_t)> task);
+
+  // Splits [0, count) into contiguous ranges, one per thread, and calls
+  // |task| with the bounds of every range, like Run(). Every range but the
+  // last holds at least |min_per_thread| items, so an item stays on the same
+  // thread from call to call as long as |count| does not change.
+  void RunRanges(size_t count,
+                 size_t min_per_thread,
+                 FunctionView<void(size_t begin, size_t end)> task);
+
+ private:
+  class Thread;
+
+  std::vector<std::unique_ptr<Thread>> threads_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ForkJoinThreads);
+};
+
+}  // namespace rtc
+
+#endif  // WEBRTC_BASE_FORK_JOIN_THREADS_H_
@@ -0,0 +1,83 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/fork_join_threads.h"
+
+#include <vector>
+
+#include "webrtc/test/gtest.h"
+
+namespace rtc {
+
+TEST(ForkJoinThreadsTest, RunsEveryTaskOnceOnItsOwnThread) {
+  ForkJoinThreads threads(4, "ForkJoinThreadsTest", kNormalPriority);
+  EXPECT_EQ(4u, threads.num_threads());
+  const PlatformThreadRef caller = CurrentThreadRef();
+
+  for (int run = 0; run < 10; ++run) {
+    std::vector<int> calls(4, 0);
+    std::vector<PlatformThreadRef> refs(4);
+    threads.Run(4, [&](size_t index) {
+      ++calls[index];
+      refs[index] = CurrentThreadRef();
+    });
+    for (size_t i = 0; i < calls.size(); ++i)
+      EXPECT_EQ(1, calls[i]);
+    EXPECT_TRUE(IsThreadRefEqual(caller, refs[0]));
+    for (size_t i = 0; i < refs.size(); ++i) {
+      for (size_t j = i + 1; j < refs.size(); ++j)
+        EXPECT_FALSE(IsThreadRefEqual(refs[i], refs[j]));
+    }
+  }
+}
+
+TEST(ForkJoinThreadsTest, RunsFewerTasksThanThreads) {
+  ForkJoinThreads threads(4, "ForkJoinThreadsTest", kNormalPriority);
+  std::vector<int> calls(4, 0);
+  threads.Run(2, [&](size_t index) { ++calls[index]; });
+  EXPECT_EQ(std::vector<int>({1, 1, 0, 0}), calls);
+  threads.Run(0, [&](size_t index) { ++calls[index]; });
+  EXPECT_EQ(std::vector<int>({1, 1, 0, 0}), calls);
+}
+
+TEST(ForkJoinThreadsTest, SingleThreadRunsOnCaller) {
+  ForkJoinThreads threads(1, "ForkJoinThreadsTest", kNormalPriority);
+  EXPECT_EQ(1u, threads.num_threads());
+  PlatformThreadRef ref;
+  threads.Run(1, [&](size_t index) { ref = CurrentThreadRef(); });
+  EXPECT_TRUE(IsThreadRefEqual(CurrentThreadRef(), ref));
+}
+
+TEST(ForkJoinThreadsTest, RunRangesCoversEveryItemOnce) {
+  ForkJoinThreads threads(4, "ForkJoinThreadsTest", kNormalPriority);
+  for (size_t count : {0, 3, 8, 17, 100}) {
+    std::vector<int> calls(count, 0);
+    threads.RunRanges(count, 4, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i)
+        ++calls[i];
+    });
+    EXPECT_EQ(std::vector<int>(count, 1), calls) << "count " << count;
+  }
+}
+
+TEST(ForkJoinThreadsTest, RunRangesKeepsMinimumPerThread) {
+  ForkJoinThreads threads(4, "ForkJoinThreadsTest", kNormalPriority);
+  // Maps the begin of every range to its end. 11 items at 4 per thread only
+  // justify two threads.
+  std::vector<size_t> ends(11, 0);
+  threads.RunRanges(11, 4,
+                    [&](size_t begin, size_t end) { ends[begin] = end; });
+  std::vector<size_t> expected(11, 0);
+  expected[0] = 6;
+  expected[6] = 11;
+  EXPECT_EQ(expected, ends);
+}
+
+}  // namespace rtc
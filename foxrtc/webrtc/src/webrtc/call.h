@@ -91,6 +91,10 @@ class Call {
     // Audio Processing Module to be used in this call.
     // TODO(solenberg): Change this to a shared_ptr once we can use C++11.
     AudioProcessing* audio_processing = nullptr;
+
+    // If > 0, all video receive streams share this many decode threads
+    // instead of each running its own.
+    int num_decode_threads = 0;
   };
 
   struct Stats {
@@ -42,6 +42,7 @@
 #include "webrtc/system_wrappers/include/rw_lock_wrapper.h"
 #include "webrtc/system_wrappers/include/trace.h"
 #include "webrtc/video/call_stats.h"
+#include "webrtc/video/decode_worker_pool.h"
 #include "webrtc/video/send_delay_stats.h"
 #include "webrtc/video/stats_counter.h"
 #include "webrtc/video/video_receive_stream.h"
@@ -197,6 +198,8 @@ class Call : public webrtc::Call,
   std::map<std::string, rtc::NetworkRoute> network_routes_;
 
   VieRemb remb_;
+  // Null unless |config_.num_decode_threads| > 0.
+  const std::unique_ptr<DecodeWorkerPool> decode_worker_pool_;
   const std::unique_ptr<CongestionController> congestion_controller_;
   const std::unique_ptr<SendDelayStats> video_send_delay_stats_;
   const int64_t start_ms_;
@@ -251,6 +254,10 @@ Call::Call(const Call::Config& config)
       estimated_send_bitrate_kbps_counter_(clock_, nullptr, true),
       pacer_bitrate_kbps_counter_(clock_, nullptr, true),
       remb_(clock_),
+      decode_worker_pool_(
+          config.num_decode_threads > 0
+              ? new DecodeWorkerPool(clock_, config.num_decode_threads)
+              : nullptr),
       congestion_controller_(
           new CongestionController(clock_, this, &remb_, event_log_.get())),
       video_send_delay_stats_(new SendDelayStats(clock_)),
@@ -531,7 +538,8 @@ webrtc::VideoReceiveStream* Call::CreateVideoReceiveStream(
   RTC_DCHECK(configuration_thread_checker_.CalledOnValidThread());
   VideoReceiveStream* receive_stream = new VideoReceiveStream(
       num_cpu_cores_, congestion_controller_.get(), std::move(configuration),
-      voice_engine(), module_process_thread_.get(), call_stats_.get(), &remb_);
+      voice_engine(), module_process_thread_.get(), call_stats_.get(), &remb_,
+      decode_worker_pool_.get());
 
   const webrtc::VideoReceiveStream::Config& config = receive_stream->config();
   {
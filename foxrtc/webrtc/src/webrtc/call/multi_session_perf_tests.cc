@@ -0,0 +1,532 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#if defined(WEBRTC_WIN)
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
+#include "webrtc/base/fakeclock.h"
+#include "webrtc/base/thread_annotations.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/call.h"
+#include "webrtc/config.h"
+#include "webrtc/media/base/videosourceinterface.h"
+#include "webrtc/modules/audio_device/include/fake_audio_device.h"
+#include "webrtc/test/call_test.h"
+#include "webrtc/test/direct_transport.h"
+#include "webrtc/test/encoder_settings.h"
+#include "webrtc/test/frame_generator.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/fileutils.h"
+#include "webrtc/test/testsupport/perf_test.h"
+#include "webrtc/voice_engine/include/voe_base.h"
+#include "webrtc/voice_engine/include/voe_codec.h"
+
+namespace webrtc {
+namespace {
+
+// Frames and stats from the first seconds are skipped, while the bandwidth
+// estimate ramps up and the jitter buffers settle. All times are on the
+// simulated clock.
+const int kWarmupMs = 2000;
+const int kMeasurementMs = 5000;
+const int kStatsIntervalMs = 1000;
+const int kAudioTickMs = 10;
+
+const int kVideoWidth = 352;
+const int kVideoHeight = 288;
+const int kVideoFramerate = 30;
+const int kVideoMaxBitrateBps = 600000;
+
+const int kAudioSampleRateHz = 16000;
+const size_t kAudioSamplesPerTick = kAudioSampleRateHz / 100;
+
+const uint32_t kVideoSsrcBase = 0x1000;
+const uint32_t kAudioSsrcBase = 0x2000;
+const uint32_t kReceiverVideoSsrcBase = 0x3000;
+const uint32_t kReceiverAudioSsrcBase = 0x4000;
+
+// CPU time used by all threads of the process so far.
+int64_t ProcessCpuTimeUs() {
+#if defined(WEBRTC_WIN)
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (!GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time,
+                       &kernel_time, &user_time)) {
+    return 0;
+  }
+  // FILETIMEs count 100 ns intervals.
+  ULARGE_INTEGER kernel, user;
+  kernel.LowPart = kernel_time.dwLowDateTime;
+  kernel.HighPart = kernel_time.dwHighDateTime;
+  user.LowPart = user_time.dwLowDateTime;
+  user.HighPart = user_time.dwHighDateTime;
+  return static_cast<int64_t>((kernel.QuadPart + user.QuadPart) / 10);
+#else
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+  return (static_cast<int64_t>(usage.ru_utime.tv_sec) +
+          usage.ru_stime.tv_sec) * 1000000 +
+         usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+#endif
+}
+
+// Value at |percentile| (0-100) of |values|, which is sorted in place.
+int Percentile(std::vector<int>* values, int percentile) {
+  if (values->empty())
+    return 0;
+  std::sort(values->begin(), values->end());
+  size_t index = (values->size() - 1) * percentile / 100;
+  return (*values)[index];
+}
+
+// Audio device that exchanges 10 ms of audio with the voice engine when the
+// test calls Tick(), rather than on a timer of its own. The microphone loops
+// a 16 kHz mono PCM file.
+class SteppedAudioDevice : public FakeAudioDeviceModule {
+ public:
+  explicit SteppedAudioDevice(const std::string& filename)
+      : playout_buffer_(kAudioSamplesPerTick) {
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (!file)
+      return;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size > 0) {
+      input_.resize(static_cast<size_t>(size) / sizeof(int16_t));
+      input_.resize(fread(&input_[0], sizeof(int16_t), input_.size(), file));
+    }
+    fclose(file);
+  }
+
+  int32_t RegisterAudioCallback(AudioTransport* callback) override {
+    rtc::CritScope lock(&crit_);
+    callback_ = callback;
+    return 0;
+  }
+
+  size_t num_input_samples() const { return input_.size(); }
+
+  void Tick() {
+    rtc::CritScope lock(&crit_);
+    if (!callback_ || input_.size() < kAudioSamplesPerTick)
+      return;
+    if (input_position_ + kAudioSamplesPerTick > input_.size())
+      input_position_ = 0;
+    uint32_t new_mic_level = 0;
+    callback_->RecordedDataIsAvailable(&input_[input_position_],
+                                       kAudioSamplesPerTick, 2, 1,
+                                       kAudioSampleRateHz, 0, 0, 0, false,
+                                       new_mic_level);
+    input_position_ += kAudioSamplesPerTick;
+    size_t samples_out = 0;
+    int64_t elapsed_time_ms = -1;
+    int64_t ntp_time_ms = -1;
+    callback_->NeedMorePlayData(kAudioSamplesPerTick, 2, 1, kAudioSampleRateHz,
+                                &playout_buffer_[0], samples_out,
+                                &elapsed_time_ms, &ntp_time_ms);
+  }
+
+ private:
+  rtc::CriticalSection crit_;
+  AudioTransport* callback_ GUARDED_BY(crit_) = nullptr;
+  std::vector<int16_t> input_;
+  size_t input_position_ GUARDED_BY(crit_) = 0;
+  std::vector<int16_t> playout_buffer_ GUARDED_BY(crit_);
+};
+
+// Video source that sends the next frame of |frame_generator|, which it takes
+// ownership of, when the test calls InsertFrame(). Frames are captured at the
+// current time of |clock|.
+class SteppedFrameSource : public rtc::VideoSourceInterface<VideoFrame> {
+ public:
+  SteppedFrameSource(test::FrameGenerator* frame_generator, Clock* clock)
+      : frame_generator_(frame_generator), clock_(clock) {}
+
+  void AddOrUpdateSink(rtc::VideoSinkInterface<VideoFrame>* sink,
+                       const rtc::VideoSinkWants& wants) override {
+    rtc::CritScope lock(&crit_);
+    sink_ = sink;
+  }
+
+  void RemoveSink(rtc::VideoSinkInterface<VideoFrame>* sink) override {
+    rtc::CritScope lock(&crit_);
+    sink_ = nullptr;
+  }
+
+  void InsertFrame() {
+    rtc::CritScope lock(&crit_);
+    if (!sink_)
+      return;
+    VideoFrame* frame = frame_generator_->NextFrame();
+    // The send stream turns this into the RTP timestamp of the frame.
+    frame->set_ntp_time_ms(clock_->TimeInMilliseconds());
+    sink_->OnFrame(*frame);
+  }
+
+ private:
+  const std::unique_ptr<test::FrameGenerator> frame_generator_;
+  Clock* const clock_;
+  rtc::CriticalSection crit_;
+  rtc::VideoSinkInterface<VideoFrame>* sink_ GUARDED_BY(crit_) = nullptr;
+};
+
+// Collects the capture-to-render delay of the frames rendered by all
+// sessions. The sources capture at the time of |clock| and the send streams
+// derive the 90 kHz RTP timestamp from it, which the rendered frames keep.
+class LatencyObserver : public rtc::VideoSinkInterface<VideoFrame> {
+ public:
+  explicit LatencyObserver(Clock* clock) : clock_(clock), measuring_(false) {}
+
+  void OnFrame(const VideoFrame& video_frame) override {
+    uint32_t now_rtp = 90 * static_cast<uint32_t>(clock_->TimeInMilliseconds());
+    int latency_ms = static_cast<int>((now_rtp - video_frame.timestamp()) / 90);
+    rtc::CritScope lock(&crit_);
+    if (measuring_)
+      latencies_ms_.push_back(latency_ms);
+  }
+
+  void StartMeasuring() {
+    rtc::CritScope lock(&crit_);
+    measuring_ = true;
+  }
+
+  std::vector<int> StopMeasuring() {
+    rtc::CritScope lock(&crit_);
+    measuring_ = false;
+    return latencies_ms_;
+  }
+
+ private:
+  Clock* const clock_;
+  rtc::CriticalSection crit_;
+  bool measuring_ GUARDED_BY(crit_);
+  std::vector<int> latencies_ms_ GUARDED_BY(crit_);
+};
+
+}  // namespace
+
+// Runs a number of independent audio+video sessions, each a VP8 video stream
+// and an Opus audio stream, from one call to another through a simulated
+// network, and reports what they cost per session. Both calls live in this
+// process, so the CPU time of a session covers its sending and its receiving
+// side.
+//
+// The test steps a fake clock, and captures audio and video on its schedule.
+// The threads inside the calls still sleep on the wall clock until their next
+// deadline on the fake one, so the clock is never stepped ahead of the wall
+// clock; a faster clock would make every such sleep look longer.
+class MultiSessionPerfTest : public test::CallTest {
+ protected:
+  struct Session {
+    std::unique_ptr<VideoEncoder> encoder;
+    std::unique_ptr<SteppedFrameSource> source;
+    int64_t first_frame_ms = 0;
+    int num_frames = 0;
+    VideoSendStream* video_send_stream = nullptr;
+    VideoReceiveStream* video_receive_stream = nullptr;
+    int audio_send_channel = -1;
+    int audio_receive_channel = -1;
+    AudioSendStream* audio_send_stream = nullptr;
+    AudioReceiveStream* audio_receive_stream = nullptr;
+  };
+
+  void RunSessions(const std::string& test_label,
+                   size_t num_sessions,
+                   const FakeNetworkPipe::Config& net_config);
+};
+
+void MultiSessionPerfTest::RunSessions(
+    const std::string& test_label,
+    size_t num_sessions,
+    const FakeNetworkPipe::Config& net_config) {
+  // Installed before anything reads the time. Starts at 1 s, since some
+  // modules take a time of 0 for unset.
+  rtc::ScopedFakeClock fake_clock;
+  fake_clock.AdvanceTime(rtc::TimeDelta::FromSeconds(1));
+
+  // One voice engine plays both ends, like in CallPerfTest.
+  VoiceEngine* voice_engine = VoiceEngine::Create();
+  VoEBase* voe_base = VoEBase::GetInterface(voice_engine);
+  VoECodec* voe_codec = VoECodec::GetInterface(voice_engine);
+  const std::string audio_filename =
+      test::ResourcePath("voice_engine/audio_long16", "pcm");
+  ASSERT_STRNE("", audio_filename.c_str());
+  SteppedAudioDevice audio_device(audio_filename);
+  ASSERT_GE(audio_device.num_input_samples(), kAudioSamplesPerTick);
+  EXPECT_EQ(0, voe_base->Init(&audio_device, nullptr, decoder_factory_));
+
+  AudioState::Config audio_state_config;
+  audio_state_config.voice_engine = voice_engine;
+  Call::Config sender_config;
+  sender_config.audio_state = AudioState::Create(audio_state_config);
+  Call::Config receiver_config;
+  receiver_config.audio_state = sender_config.audio_state;
+  CreateCalls(sender_config, receiver_config);
+
+  test::DirectTransport send_transport(net_config, sender_call_.get());
+  test::DirectTransport receive_transport(net_config, receiver_call_.get());
+  send_transport.SetReceiver(receiver_call_->Receiver());
+  receive_transport.SetReceiver(sender_call_->Receiver());
+
+  LatencyObserver latency_observer(clock_);
+  std::vector<Session> sessions(num_sessions);
+  for (size_t i = 0; i < num_sessions; ++i) {
+    Session& session = sessions[i];
+    session.encoder.reset(VideoEncoder::Create(VideoEncoder::kVp8));
+
+    VideoSendStream::Config video_send_config(&send_transport);
+    video_send_config.encoder_settings.encoder = session.encoder.get();
+    video_send_config.encoder_settings.payload_name = "VP8";
+    video_send_config.encoder_settings.payload_type = kVideoSendPayloadType;
+    video_send_config.rtp.ssrcs.push_back(kVideoSsrcBase + i);
+    video_send_config.rtp.nack.rtp_history_ms = kNackRtpHistoryMs;
+    video_send_config.rtp.extensions.push_back(RtpExtension(
+        RtpExtension::kAbsSendTimeUri, test::kAbsSendTimeExtensionId));
+    VideoEncoderConfig encoder_config;
+    test::FillEncoderConfiguration(1, &encoder_config);
+    encoder_config.max_bitrate_bps = kVideoMaxBitrateBps;
+
+    VideoReceiveStream::Config video_receive_config(&receive_transport);
+    video_receive_config.rtp.remote_ssrc = kVideoSsrcBase + i;
+    video_receive_config.rtp.local_ssrc = kReceiverVideoSsrcBase + i;
+    video_receive_config.rtp.remb = true;
+    video_receive_config.rtp.nack.rtp_history_ms = kNackRtpHistoryMs;
+    video_receive_config.rtp.extensions = video_send_config.rtp.extensions;
+    VideoReceiveStream::Decoder decoder =
+        test::CreateMatchingDecoder(video_send_config.encoder_settings);
+    allocated_decoders_.push_back(
+        std::unique_ptr<VideoDecoder>(decoder.decoder));
+    video_receive_config.decoders.push_back(decoder);
+    video_receive_config.renderer = &latency_observer;
+
+    session.video_send_stream = sender_call_->CreateVideoSendStream(
+        video_send_config.Copy(), encoder_config.Copy());
+    session.video_receive_stream =
+        receiver_call_->CreateVideoReceiveStream(video_receive_config.Copy());
+    test::FrameGenerator* frame_generator =
+        test::FrameGenerator::CreateFromYuvFile(
+            std::vector<std::string>(1,
+                                     test::ResourcePath("foreman_cif", "yuv")),
+            kVideoWidth, kVideoHeight, 1);
+    ASSERT_TRUE(frame_generator);
+    session.source.reset(new SteppedFrameSource(frame_generator, clock_));
+    session.video_send_stream->SetSource(session.source.get());
+
+    VoEBase::ChannelConfig channel_config;
+    channel_config.enable_voice_pacing = true;
+    session.audio_send_channel = voe_base->CreateChannel(channel_config);
+    session.audio_receive_channel = voe_base->CreateChannel();
+    ASSERT_GE(session.audio_send_channel, 0);
+    ASSERT_GE(session.audio_receive_channel, 0);
+
+    AudioSendStream::Config audio_send_config(&send_transport);
+    audio_send_config.voe_channel_id = session.audio_send_channel;
+    audio_send_config.rtp.ssrc = kAudioSsrcBase + i;
+    session.audio_send_stream =
+        sender_call_->CreateAudioSendStream(audio_send_config);
+    CodecInst opus = {120, "opus", 48000, 960, 2, 32000};
+    EXPECT_EQ(0, voe_codec->SetSendCodec(session.audio_send_channel, opus));
+
+    AudioReceiveStream::Config audio_receive_config;
+    audio_receive_config.rtp.remote_ssrc = kAudioSsrcBase + i;
+    audio_receive_config.rtp.local_ssrc = kReceiverAudioSsrcBase + i;
+    audio_receive_config.rtcp_send_transport = &receive_transport;
+    audio_receive_config.voe_channel_id = session.audio_receive_channel;
+    audio_receive_config.decoder_factory = decoder_factory_;
+    session.audio_receive_stream =
+        receiver_call_->CreateAudioReceiveStream(audio_receive_config);
+  }
+
+  const int64_t start_ms = clock_->TimeInMilliseconds();
+  for (size_t i = 0; i < num_sessions; ++i) {
+    Session& session = sessions[i];
+    session.video_receive_stream->Start();
+    session.video_send_stream->Start();
+    session.audio_receive_stream->Start();
+    session.audio_send_stream->Start();
+    EXPECT_EQ(0, voe_base->StartPlayout(session.audio_receive_channel));
+    EXPECT_EQ(0, voe_base->StartReceive(session.audio_receive_channel));
+    EXPECT_EQ(0, voe_base->StartSend(session.audio_send_channel));
+    // Spread the sessions over a frame interval, like independent cameras.
+    session.first_frame_ms = start_ms + static_cast<int64_t>(i) * 1000 /
+                                            kVideoFramerate /
+                                            static_cast<int64_t>(num_sessions);
+  }
+
+  // Steps the fake clock by |duration_ms|, 1 ms at a time, and captures what
+  // falls due on the way. Waits for the wall clock to catch up whenever the
+  // fake clock is ahead of it.
+  rtc::Event wait(false, false);
+  const int64_t wall_start_ms = rtc::SystemTimeMillis();
+  auto advance_time = [&](int duration_ms) {
+    for (int step = 0; step < duration_ms; ++step) {
+      fake_clock.AdvanceTime(rtc::TimeDelta::FromMilliseconds(1));
+      int64_t elapsed_ms = clock_->TimeInMilliseconds() - start_ms;
+      if (elapsed_ms % kAudioTickMs == 0)
+        audio_device.Tick();
+      for (Session& session : sessions) {
+        if (clock_->TimeInMilliseconds() >=
+            session.first_frame_ms +
+                session.num_frames * 1000 / kVideoFramerate) {
+          session.source->InsertFrame();
+          ++session.num_frames;
+        }
+      }
+      int64_t ahead_ms =
+          elapsed_ms - (rtc::SystemTimeMillis() - wall_start_ms);
+      if (ahead_ms > 0)
+        wait.Wait(static_cast<int>(ahead_ms));
+    }
+  };
+
+  advance_time(kWarmupMs);
+
+  // Per-interval averages over all sessions.
+  std::vector<int> encode_ms;
+  std::vector<int> encode_usage_percent;
+  std::vector<int> decode_ms;
+  std::vector<int> video_jitter_buffer_ms;
+  std::vector<int> audio_jitter_buffer_ms;
+  std::vector<int> pacer_delay_ms;
+  latency_observer.StartMeasuring();
+  int64_t start_cpu_us = ProcessCpuTimeUs();
+  int64_t measurement_start_ms = clock_->TimeInMilliseconds();
+  for (int elapsed_ms = 0; elapsed_ms < kMeasurementMs;
+       elapsed_ms += kStatsIntervalMs) {
+    advance_time(kStatsIntervalMs);
+    int encode_sum = 0;
+    int encode_usage_sum = 0;
+    int decode_sum = 0;
+    int video_jitter_sum = 0;
+    int audio_jitter_sum = 0;
+    for (Session& session : sessions) {
+      VideoSendStream::Stats send_stats =
+          session.video_send_stream->GetStats();
+      VideoReceiveStream::Stats receive_stats =
+          session.video_receive_stream->GetStats();
+      encode_sum += send_stats.avg_encode_time_ms;
+      encode_usage_sum += send_stats.encode_usage_percent;
+      decode_sum += receive_stats.decode_ms;
+      video_jitter_sum += receive_stats.jitter_buffer_ms;
+      audio_jitter_sum +=
+          session.audio_receive_stream->GetStats().jitter_buffer_ms;
+    }
+    const int n = static_cast<int>(num_sessions);
+    encode_ms.push_back(encode_sum / n);
+    encode_usage_percent.push_back(encode_usage_sum / n);
+    decode_ms.push_back(decode_sum / n);
+    video_jitter_buffer_ms.push_back(video_jitter_sum / n);
+    audio_jitter_buffer_ms.push_back(audio_jitter_sum / n);
+    pacer_delay_ms.push_back(
+        static_cast<int>(sender_call_->GetStats().pacer_delay_ms));
+  }
+  int64_t cpu_us = ProcessCpuTimeUs() - start_cpu_us;
+  int64_t measured_ms = clock_->TimeInMilliseconds() - measurement_start_ms;
+  std::vector<int> latencies_ms = latency_observer.StopMeasuring();
+
+  for (Session& session : sessions) {
+    EXPECT_EQ(0, voe_base->StopSend(session.audio_send_channel));
+    EXPECT_EQ(0, voe_base->StopReceive(session.audio_receive_channel));
+    EXPECT_EQ(0, voe_base->StopPlayout(session.audio_receive_channel));
+    session.audio_send_stream->Stop();
+    session.audio_receive_stream->Stop();
+    session.video_send_stream->Stop();
+    session.video_receive_stream->Stop();
+  }
+  send_transport.StopSending();
+  receive_transport.StopSending();
+
+  for (Session& session : sessions) {
+    sender_call_->DestroyVideoSendStream(session.video_send_stream);
+    receiver_call_->DestroyVideoReceiveStream(session.video_receive_stream);
+    sender_call_->DestroyAudioSendStream(session.audio_send_stream);
+    receiver_call_->DestroyAudioReceiveStream(session.audio_receive_stream);
+    voe_base->DeleteChannel(session.audio_send_channel);
+    voe_base->DeleteChannel(session.audio_receive_channel);
+  }
+  sessions.clear();
+  allocated_decoders_.clear();
+  DestroyCalls();
+  voe_base->Release();
+  voe_codec->Release();
+  VoiceEngine::Delete(voice_engine);
+
+  EXPECT_FALSE(latencies_ms.empty()) << "No frame was rendered.";
+  // In percent of one core. The fake clock keeps pace with the wall clock.
+  test::PrintResult("cpu_per_session", "", test_label,
+                    static_cast<size_t>(cpu_us / 10 /
+                                        std::max<int64_t>(measured_ms, 1) /
+                                        static_cast<int64_t>(num_sessions)),
+                    "%", true);
+  test::PrintResult("e2e_latency_p50", "", test_label,
+                    Percentile(&latencies_ms, 50), "ms", true);
+  test::PrintResult("e2e_latency_p90", "", test_label,
+                    Percentile(&latencies_ms, 90), "ms", false);
+  test::PrintResult("e2e_latency_p99", "", test_label,
+                    Percentile(&latencies_ms, 99), "ms", true);
+  test::PrintResultList("encode_time", "", test_label,
+                        test::ValuesToString(encode_ms), "ms", false);
+  test::PrintResultList("encode_usage", "", test_label,
+                        test::ValuesToString(encode_usage_percent), "%",
+                        false);
+  test::PrintResultList("decode_time", "", test_label,
+                        test::ValuesToString(decode_ms), "ms", false);
+  test::PrintResultList("video_jitter_buffer", "", test_label,
+                        test::ValuesToString(video_jitter_buffer_ms), "ms",
+                        false);
+  test::PrintResultList("audio_jitter_buffer", "", test_label,
+                        test::ValuesToString(audio_jitter_buffer_ms), "ms",
+                        false);
+  test::PrintResultList("pacer_delay", "", test_label,
+                        test::ValuesToString(pacer_delay_ms), "ms", false);
+}
+
+TEST_F(MultiSessionPerfTest, OneSessionNoLoss) {
+  RunSessions("1_session_no_loss", 1, FakeNetworkPipe::Config());
+}
+
+TEST_F(MultiSessionPerfTest, FourSessionsNoLoss) {
+  RunSessions("4_sessions_no_loss", 4, FakeNetworkPipe::Config());
+}
+
+TEST_F(MultiSessionPerfTest, FourSessionsLossAndDelay) {
+  FakeNetworkPipe::Config net_config;
+  net_config.loss_percent = 5;
+  net_config.queue_delay_ms = 50;
+  net_config.delay_standard_deviation_ms = 10;
+  RunSessions("4_sessions_loss_delay", 4, net_config);
+}
+
+TEST_F(MultiSessionPerfTest, FourSessionsLimitedCapacity) {
+  FakeNetworkPipe::Config net_config;
+  net_config.link_capacity_kbps = 2000;
+  net_config.queue_length_packets = 100;
+  net_config.queue_delay_ms = 20;
+  RunSessions("4_sessions_2mbps", 4, net_config);
+}
+
+TEST_F(MultiSessionPerfTest, EightSessionsNoLoss) {
+  RunSessions("8_sessions_no_loss", 8, FakeNetworkPipe::Config());
+}
+
+}  // namespace webrtc
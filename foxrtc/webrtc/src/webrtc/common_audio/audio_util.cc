@@ -11,8 +11,28 @@
 #include "webrtc/common_audio/include/audio_util.h"
 
 #include "webrtc/typedefs.h"
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "webrtc/common_audio/audio_util_sse2.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+#endif
 
 namespace webrtc {
+namespace {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+bool UseSse2() {
+#if defined(__SSE2__)
+  return true;
+#else
+  // Querying the CPU features is comparatively expensive, and these
+  // functions run several times per channel and 10 ms frame.
+  static const bool use_sse2 = WebRtc_GetCPUInfo(kSSE2) != 0;
+  return use_sse2;
+#endif
+}
+#endif
+
+}  // namespace
 
 void FloatToS16(const float* src, size_t size, int16_t* dest) {
   for (size_t i = 0; i < size; ++i)
@@ -24,21 +44,94 @@ void S16ToFloat(const int16_t* src, size_t size, float* dest) {
     dest[i] = S16ToFloat(src[i]);
 }
 
+void S16ToFloatS16(const int16_t* src, size_t size, float* dest) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (UseSse2()) {
+    S16ToFloatS16_SSE2(src, size, dest);
+    return;
+  }
+#endif
+  for (size_t i = 0; i < size; ++i)
+    dest[i] = src[i];
+}
+
 void FloatS16ToS16(const float* src, size_t size, int16_t* dest) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (UseSse2()) {
+    FloatS16ToS16_SSE2(src, size, dest);
+    return;
+  }
+#endif
   for (size_t i = 0; i < size; ++i)
     dest[i] = FloatS16ToS16(src[i]);
 }
 
 void FloatToFloatS16(const float* src, size_t size, float* dest) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (UseSse2()) {
+    FloatToFloatS16_SSE2(src, size, dest);
+    return;
+  }
+#endif
   for (size_t i = 0; i < size; ++i)
     dest[i] = FloatToFloatS16(src[i]);
 }
 
 void FloatS16ToFloat(const float* src, size_t size, float* dest) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (UseSse2()) {
+    FloatS16ToFloat_SSE2(src, size, dest);
+    return;
+  }
+#endif
   for (size_t i = 0; i < size; ++i)
     dest[i] = FloatS16ToFloat(src[i]);
 }
 
+template <>
+void Deinterleave<int16_t>(const int16_t* interleaved,
+                           size_t samples_per_channel,
+                           size_t num_channels,
+                           int16_t* const* deinterleaved) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (num_channels == 2 && UseSse2()) {
+    DeinterleaveStereo_SSE2(interleaved, samples_per_channel,
+                            deinterleaved[0], deinterleaved[1]);
+    return;
+  }
+#endif
+  for (size_t i = 0; i < num_channels; ++i) {
+    int16_t* channel = deinterleaved[i];
+    size_t interleaved_idx = i;
+    for (size_t j = 0; j < samples_per_channel; ++j) {
+      channel[j] = interleaved[interleaved_idx];
+      interleaved_idx += num_channels;
+    }
+  }
+}
+
+template <>
+void Interleave<int16_t>(const int16_t* const* deinterleaved,
+                         size_t samples_per_channel,
+                         size_t num_channels,
+                         int16_t* interleaved) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (num_channels == 2 && UseSse2()) {
+    InterleaveStereo_SSE2(deinterleaved[0], deinterleaved[1],
+                          samples_per_channel, interleaved);
+    return;
+  }
+#endif
+  for (size_t i = 0; i < num_channels; ++i) {
+    const int16_t* channel = deinterleaved[i];
+    size_t interleaved_idx = i;
+    for (size_t j = 0; j < samples_per_channel; ++j) {
+      interleaved[interleaved_idx] = channel[j];
+      interleaved_idx += num_channels;
+    }
+  }
+}
+
 template <>
 void DownmixInterleavedToMono<int16_t>(const int16_t* interleaved,
                                        size_t num_frames,
@@ -0,0 +1,140 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/audio_util_sse2.h"
+
+#include <emmintrin.h>
+
+#include "webrtc/common_audio/include/audio_util.h"
+
+namespace webrtc {
+
+void S16ToFloatS16_SSE2(const int16_t* src, size_t size, float* dest) {
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+    // Sign extend by moving each sample to the top half of a 32-bit lane.
+    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+    _mm_storeu_ps(&dest[i], _mm_cvtepi32_ps(lo));
+    _mm_storeu_ps(&dest[i + 4], _mm_cvtepi32_ps(hi));
+  }
+  for (; i < size; ++i)
+    dest[i] = src[i];
+}
+
+void FloatS16ToS16_SSE2(const float* src, size_t size, int16_t* dest) {
+  // Rounds half away from zero and saturates, like FloatS16ToS16(float).
+  // Clamping before the rounding keeps the truncation within int32, and
+  // gives the same saturated values as the C version's comparisons.
+  const __m128 sign_mask = _mm_set1_ps(-0.f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 max = _mm_set1_ps(limits_int16::max());
+  const __m128 min = _mm_set1_ps(limits_int16::min());
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m128 v0 = _mm_loadu_ps(&src[i]);
+    __m128 v1 = _mm_loadu_ps(&src[i + 4]);
+    const __m128 half0 = _mm_or_ps(half, _mm_and_ps(v0, sign_mask));
+    const __m128 half1 = _mm_or_ps(half, _mm_and_ps(v1, sign_mask));
+    v0 = _mm_add_ps(_mm_min_ps(_mm_max_ps(v0, min), max), half0);
+    v1 = _mm_add_ps(_mm_min_ps(_mm_max_ps(v1, min), max), half1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[i]),
+                     _mm_packs_epi32(_mm_cvttps_epi32(v0),
+                                     _mm_cvttps_epi32(v1)));
+  }
+  for (; i < size; ++i)
+    dest[i] = FloatS16ToS16(src[i]);
+}
+
+void FloatToFloatS16_SSE2(const float* src, size_t size, float* dest) {
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 positive_scale = _mm_set1_ps(limits_int16::max());
+  const __m128 negative_scale = _mm_set1_ps(-limits_int16::min());
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const __m128 v = _mm_loadu_ps(&src[i]);
+    const __m128 positive = _mm_cmpgt_ps(v, zero);
+    const __m128 scale = _mm_or_ps(_mm_and_ps(positive, positive_scale),
+                                   _mm_andnot_ps(positive, negative_scale));
+    _mm_storeu_ps(&dest[i], _mm_mul_ps(v, scale));
+  }
+  for (; i < size; ++i)
+    dest[i] = FloatToFloatS16(src[i]);
+}
+
+void FloatS16ToFloat_SSE2(const float* src, size_t size, float* dest) {
+  static const float kMaxInt16Inverse = 1.f / limits_int16::max();
+  static const float kMinInt16Inverse = 1.f / limits_int16::min();
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 positive_scale = _mm_set1_ps(kMaxInt16Inverse);
+  const __m128 negative_scale = _mm_set1_ps(-kMinInt16Inverse);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const __m128 v = _mm_loadu_ps(&src[i]);
+    const __m128 positive = _mm_cmpgt_ps(v, zero);
+    const __m128 scale = _mm_or_ps(_mm_and_ps(positive, positive_scale),
+                                   _mm_andnot_ps(positive, negative_scale));
+    _mm_storeu_ps(&dest[i], _mm_mul_ps(v, scale));
+  }
+  for (; i < size; ++i)
+    dest[i] = FloatS16ToFloat(src[i]);
+}
+
+void DeinterleaveStereo_SSE2(const int16_t* interleaved,
+                             size_t samples_per_channel,
+                             int16_t* left,
+                             int16_t* right) {
+  size_t i = 0;
+  for (; i + 8 <= samples_per_channel; i += 8) {
+    const __m128i v0 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&interleaved[2 * i]));
+    const __m128i v1 = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&interleaved[2 * i + 8]));
+    // Each 32-bit lane holds one left and one right sample. Sign extending
+    // either half makes the saturating pack an exact narrowing.
+    const __m128i left0 = _mm_srai_epi32(_mm_slli_epi32(v0, 16), 16);
+    const __m128i left1 = _mm_srai_epi32(_mm_slli_epi32(v1, 16), 16);
+    const __m128i right0 = _mm_srai_epi32(v0, 16);
+    const __m128i right1 = _mm_srai_epi32(v1, 16);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&left[i]),
+                     _mm_packs_epi32(left0, left1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&right[i]),
+                     _mm_packs_epi32(right0, right1));
+  }
+  for (; i < samples_per_channel; ++i) {
+    left[i] = interleaved[2 * i];
+    right[i] = interleaved[2 * i + 1];
+  }
+}
+
+void InterleaveStereo_SSE2(const int16_t* left,
+                           const int16_t* right,
+                           size_t samples_per_channel,
+                           int16_t* interleaved) {
+  size_t i = 0;
+  for (; i + 8 <= samples_per_channel; i += 8) {
+    const __m128i l =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&left[i]));
+    const __m128i r =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&right[i]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&interleaved[2 * i]),
+                     _mm_unpacklo_epi16(l, r));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&interleaved[2 * i + 8]),
+                     _mm_unpackhi_epi16(l, r));
+  }
+  for (; i < samples_per_channel; ++i) {
+    interleaved[2 * i] = left[i];
+    interleaved[2 * i + 1] = right[i];
+  }
+}
+
+}  // namespace webrtc
@@ -9,6 +9,10 @@
  */
 
 #include "webrtc/common_audio/include/audio_util.h"
+
+#include <vector>
+
+#include "webrtc/base/random.h"
 #include "webrtc/test/gmock.h"
 #include "webrtc/test/gtest.h"
 #include "webrtc/typedefs.h"
@@ -136,6 +140,79 @@ TEST(AudioUtilTest, InterleavingMonoIsIdentical) {
   ExpectArraysEq(mono, interleaved, kSamplesPerChannel);
 }
 
+TEST(AudioUtilTest, S16ToFloatS16) {
+  const size_t kSize = 7;
+  const int16_t kInput[kSize] = {0, 1, -1, 16384, -16384, 32767, -32768};
+  const float kReference[kSize] = {0.f,       1.f,     -1.f,    16384.f,
+                                   -16384.f, 32767.f, -32768.f};
+  float output[kSize];
+  S16ToFloatS16(kInput, kSize, output);
+  ExpectArraysEq(kReference, output, kSize);
+}
+
+// The array functions may be vectorized, and should give exactly the same
+// results as the scalar functions, also for the samples left over at the end.
+TEST(AudioUtilTest, ArrayConversionsMatchScalarConversions) {
+  const float kEdges[] = {0.f,      -0.f,      0.5f,      -0.5f,    1.5f,
+                          -1.5f,    32766.4f,  32766.5f,  32767.f,  32767.5f,
+                          40000.f,  -32767.4f, -32767.5f, -32768.f, -32768.5f,
+                          -40000.f, 1.f,       -1.f,      1.1f,     -1.1f};
+  const size_t kEdgesSize = sizeof(kEdges) / sizeof(kEdges[0]);
+  const size_t kSize = 163;
+  Random random(42);
+  std::vector<float> float_s16(kSize);
+  std::vector<float> float_unit(kSize);
+  std::vector<int16_t> s16(kSize);
+  for (size_t i = 0; i < kSize; ++i) {
+    float_s16[i] = i < kEdgesSize
+                       ? kEdges[i]
+                       : static_cast<float>(random.Gaussian(0, 20000));
+    float_unit[i] = float_s16[i] / 32768.f;
+    s16[i] = static_cast<int16_t>(random.Rand(-32768, 32767));
+  }
+
+  std::vector<float> float_output(kSize);
+  std::vector<int16_t> s16_output(kSize);
+  S16ToFloatS16(s16.data(), kSize, float_output.data());
+  for (size_t i = 0; i < kSize; ++i)
+    EXPECT_EQ(static_cast<float>(s16[i]), float_output[i]) << i;
+  FloatS16ToS16(float_s16.data(), kSize, s16_output.data());
+  for (size_t i = 0; i < kSize; ++i)
+    EXPECT_EQ(FloatS16ToS16(float_s16[i]), s16_output[i]) << i;
+  FloatToFloatS16(float_unit.data(), kSize, float_output.data());
+  for (size_t i = 0; i < kSize; ++i)
+    EXPECT_EQ(FloatToFloatS16(float_unit[i]), float_output[i]) << i;
+  FloatS16ToFloat(float_s16.data(), kSize, float_output.data());
+  for (size_t i = 0; i < kSize; ++i)
+    EXPECT_EQ(FloatS16ToFloat(float_s16[i]), float_output[i]) << i;
+}
+
+TEST(AudioUtilTest, InterleavingLongBuffers) {
+  const size_t kSamplesPerChannel = 37;
+  for (size_t num_channels = 1; num_channels <= 3; ++num_channels) {
+    std::vector<int16_t> interleaved(kSamplesPerChannel * num_channels);
+    for (size_t i = 0; i < interleaved.size(); ++i)
+      interleaved[i] = static_cast<int16_t>(i % 2 ? -250 * i : 250 * i);
+    std::vector<std::vector<int16_t>> channels(
+        num_channels, std::vector<int16_t>(kSamplesPerChannel));
+    std::vector<int16_t*> deinterleaved;
+    for (auto& channel : channels)
+      deinterleaved.push_back(channel.data());
+
+    Deinterleave(interleaved.data(), kSamplesPerChannel, num_channels,
+                 deinterleaved.data());
+    for (size_t i = 0; i < kSamplesPerChannel; ++i) {
+      for (size_t j = 0; j < num_channels; ++j)
+        EXPECT_EQ(interleaved[i * num_channels + j], channels[j][i]);
+    }
+
+    std::vector<int16_t> output(interleaved.size());
+    Interleave(deinterleaved.data(), kSamplesPerChannel, num_channels,
+               output.data());
+    EXPECT_THAT(output, ElementsAreArray(interleaved));
+  }
+}
+
 TEST(AudioUtilTest, DownmixInterleavedToMono) {
   {
     const size_t kNumFrames = 4;
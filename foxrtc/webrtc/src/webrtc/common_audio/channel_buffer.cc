@@ -53,9 +53,7 @@ void IFChannelBuffer::RefreshF() const {
     const int16_t* const* int_channels = ibuf_.channels();
     float* const* float_channels = fbuf_.channels();
     for (size_t i = 0; i < ibuf_.num_channels(); ++i) {
-      for (size_t j = 0; j < ibuf_.num_frames(); ++j) {
-        float_channels[i][j] = int_channels[i][j];
-      }
+      S16ToFloatS16(int_channels[i], ibuf_.num_frames(), float_channels[i]);
     }
     fvalid_ = true;
   }
@@ -12,8 +12,11 @@
 
 #include <cmath>
 #include <algorithm>
+#include <map>
+#include <vector>
 
 #include "webrtc/base/checks.h"
+#include "webrtc/base/criticalsection.h"
 #include "webrtc/common_audio/fft4g.h"
 
 namespace webrtc {
@@ -32,17 +35,52 @@ size_t ComputeWorkIpSize(size_t fft_length) {
       static_cast<float>(fft_length))));
 }
 
+struct WorkArrays {
+  std::unique_ptr<size_t[]> ip;
+  std::unique_ptr<float[]> w;
+};
+
+rtc::GlobalLockPod g_work_arrays_lock;
+
+// Returns the work arrays for |fft_order| as initialized by the first
+// transform. Only the |w| twiddle table is shared by all transforms of that
+// order; servers running many audio streams would otherwise hold one copy of
+// it per stream. Every transform rewrites the bit reversal table in ip[2...],
+// so each instance needs an |ip| of its own, with ip[0] and ip[1] copied from
+// here to mark |w| as initialized.
+const WorkArrays& GetWorkArrays(int fft_order) {
+  RTC_CHECK_GE(fft_order, 1);
+  rtc::GlobalLockScope lock(&g_work_arrays_lock);
+  // Leaked on purpose, to not depend on the order of static destructors.
+  static std::map<int, WorkArrays>* const work_arrays =
+      new std::map<int, WorkArrays>();
+  auto it = work_arrays->find(fft_order);
+  if (it == work_arrays->end()) {
+    const size_t length = RealFourier::FftLength(fft_order);
+    WorkArrays& arrays = (*work_arrays)[fft_order];
+    // Zero-initializing ip will cause rdft to initialize the work arrays on
+    // the first call, so make that call here, before they are shared.
+    arrays.ip.reset(new size_t[ComputeWorkIpSize(length)]());
+    arrays.w.reset(new float[RealFourier::ComplexLength(fft_order)]());
+    std::vector<float> scratch(length, 0.f);
+    WebRtc_rdft(length, 1, scratch.data(), arrays.ip.get(), arrays.w.get());
+    return arrays;
+  }
+  return it->second;
+}
+
 }  // namespace
 
 RealFourierOoura::RealFourierOoura(int fft_order)
     : order_(fft_order),
       length_(FftLength(order_)),
       complex_length_(ComplexLength(order_)),
-      // Zero-initializing work_ip_ will cause rdft to initialize these work
-      // arrays on the first call.
       work_ip_(new size_t[ComputeWorkIpSize(length_)]()),
-      work_w_(new float[complex_length_]()) {
+      work_w_(GetWorkArrays(fft_order).w.get()) {
   RTC_CHECK_GE(fft_order, 1);
+  const WorkArrays& shared = GetWorkArrays(fft_order);
+  work_ip_[0] = shared.ip[0];
+  work_ip_[1] = shared.ip[1];
 }
 
 void RealFourierOoura::Forward(const float* src, complex<float>* dest) const {
@@ -51,7 +89,7 @@ void RealFourierOoura::Forward(const float* src, complex<float>* dest) const {
     // http://en.cppreference.com/w/cpp/numeric/complex
     auto dest_float = reinterpret_cast<float*>(dest);
     std::copy(src, src + length_, dest_float);
-    WebRtc_rdft(length_, 1, dest_float, work_ip_.get(), work_w_.get());
+    WebRtc_rdft(length_, 1, dest_float, work_ip_.get(), work_w_);
   }
 
   // Ooura places real[n/2] in imag[0].
@@ -75,7 +113,7 @@ void RealFourierOoura::Inverse(const complex<float>* src, float* dest) const {
                                      src[complex_length_ - 1].real());
   }
 
-  WebRtc_rdft(length_, -1, dest, work_ip_.get(), work_w_.get());
+  WebRtc_rdft(length_, -1, dest, work_ip_.get(), work_w_);
 
   // Ooura returns a scaled version.
   const float scale = 2.0f / length_;
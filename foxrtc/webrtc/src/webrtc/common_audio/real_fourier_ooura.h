@@ -34,9 +34,10 @@ class RealFourierOoura : public RealFourier {
   const size_t length_;
   const size_t complex_length_;
   // These are work arrays for Ooura. The names are based on the comments in
-  // fft4g.c.
+  // fft4g.c. |work_w_| is shared by all instances of the same order and only
+  // read, while every transform writes |work_ip_|.
   const std::unique_ptr<size_t[]> work_ip_;
-  const std::unique_ptr<float[]> work_w_;
+  float* const work_w_;
 };
 
 }  // namespace webrtc
@@ -12,6 +12,9 @@
 
 #include <stdlib.h>
 
+#include <vector>
+
+#include "webrtc/base/platform_thread.h"
 #include "webrtc/common_audio/real_fourier_ooura.h"
 #include "webrtc/common_audio/real_fourier_openmax.h"
 #include "webrtc/test/gtest.h"
@@ -105,5 +108,60 @@ TYPED_TEST(RealFourierTest, SimpleBackwardTransform) {
   EXPECT_NEAR(this->real_buffer_[3], 4.0f, 1e-8f);
 }
 
+namespace {
+
+const int kConcurrentOrder = 8;
+const int kConcurrentTransforms = 2000;
+
+std::vector<complex<float>> TransformOoura(const std::vector<float>& input) {
+  RealFourierOoura rf(kConcurrentOrder);
+  std::vector<complex<float>> output(
+      RealFourier::ComplexLength(kConcurrentOrder));
+  rf.Forward(input.data(), output.data());
+  return output;
+}
+
+// Repeatedly transforms |input| with a transform of its own and counts the
+// results that differ from |expected|.
+struct ConcurrentTransforms {
+  static bool Run(void* obj) {
+    ConcurrentTransforms* self = static_cast<ConcurrentTransforms*>(obj);
+    RealFourierOoura rf(kConcurrentOrder);
+    std::vector<complex<float>> output(self->expected->size());
+    for (int i = 0; i < kConcurrentTransforms; ++i) {
+      rf.Forward(self->input->data(), output.data());
+      if (output != *self->expected)
+        ++self->mismatches;
+    }
+    return false;
+  }
+
+  const std::vector<float>* input;
+  const std::vector<complex<float>>* expected;
+  int mismatches;
+};
+
+}  // namespace
+
+TEST(RealFourierOouraTest, InstancesOfOneOrderRunConcurrently) {
+  std::vector<float> input(RealFourier::FftLength(kConcurrentOrder));
+  for (size_t i = 0; i < input.size(); ++i)
+    input[i] = static_cast<float>((i * 37) % 101);
+  const std::vector<complex<float>> expected = TransformOoura(input);
+
+  ConcurrentTransforms transforms[2] = {{&input, &expected, 0},
+                                        {&input, &expected, 0}};
+  rtc::PlatformThread thread0(&ConcurrentTransforms::Run, &transforms[0],
+                              "Transform0");
+  rtc::PlatformThread thread1(&ConcurrentTransforms::Run, &transforms[1],
+                              "Transform1");
+  thread0.Start();
+  thread1.Start();
+  thread0.Stop();
+  thread1.Stop();
+  EXPECT_EQ(0, transforms[0].mismatches);
+  EXPECT_EQ(0, transforms[1].mismatches);
+}
+
 }  // namespace webrtc
 
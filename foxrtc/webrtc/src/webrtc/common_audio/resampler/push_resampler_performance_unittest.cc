@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "webrtc/base/timeutils.h"
+#include "webrtc/common_audio/resampler/include/push_resampler.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+const int kNumFrames = 1000;
+
+// Prints the average time to resample 10 ms of audio from |src_rate_hz| to
+// |dst_rate_hz|.
+template <typename T>
+void RunResampling(const std::string& format,
+                   int src_rate_hz,
+                   int dst_rate_hz,
+                   size_t num_channels) {
+  const size_t src_length = src_rate_hz / 100 * num_channels;
+  const size_t dst_length = dst_rate_hz / 100 * num_channels;
+  std::vector<T> src(src_length);
+  std::vector<T> dst(dst_length);
+  for (size_t i = 0; i < src_length; ++i)
+    src[i] = static_cast<T>((i * 37) % 2000);
+
+  PushResampler<T> resampler;
+  ASSERT_EQ(0, resampler.InitializeIfNeeded(src_rate_hz, dst_rate_hz,
+                                            num_channels));
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kNumFrames; ++i) {
+    ASSERT_EQ(static_cast<int>(dst_length),
+              resampler.Resample(src.data(), src_length, dst.data(),
+                                 dst_length));
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+
+  test::PrintResult("push_resampler_" + format,
+                    "_" + std::to_string(src_rate_hz) + "_to_" +
+                        std::to_string(dst_rate_hz) + "Hz",
+                    "PushResampler",
+                    static_cast<size_t>(elapsed_ns / kNumFrames), "ns",
+                    false);
+}
+
+}  // namespace
+
+// Covers the sample rate pairs that AudioConverter and the mixers use,
+// int16_t for the mixers and device I/O, float for AudioConverter.
+TEST(PushResamplerPerformanceTest, RatePairs) {
+  const int kRates[] = {8000, 16000, 32000, 44100, 48000};
+  for (int src_rate_hz : kRates) {
+    for (int dst_rate_hz : kRates) {
+      if (src_rate_hz == dst_rate_hz)
+        continue;
+      RunResampling<int16_t>("int16_mono", src_rate_hz, dst_rate_hz, 1);
+      RunResampling<int16_t>("int16_stereo", src_rate_hz, dst_rate_hz, 2);
+      RunResampling<float>("float_mono", src_rate_hz, dst_rate_hz, 1);
+    }
+  }
+}
+
+}  // namespace webrtc
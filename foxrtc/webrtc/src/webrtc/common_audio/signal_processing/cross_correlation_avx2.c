@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+
+#include <immintrin.h>
+
+static inline int32_t HorizontalSum(__m256i sum_256) {
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(sum_256),
+                              _mm256_extracti128_si256(sum_256, 1));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sum);
+}
+
+// Same as the SSE2 version, 16 samples at a time.
+static inline int32_t DotProductWithShiftAVX2(const int16_t* vector1,
+                                              const int16_t* vector2,
+                                              size_t length,
+                                              int right_shifts) {
+  size_t i = 0;
+  int32_t sum = 0;
+  __m256i sum_256 = _mm256_setzero_si256();
+
+  if (right_shifts == 0) {
+    for (; i + 16 <= length; i += 16) {
+      __m256i v1 = _mm256_loadu_si256((const __m256i*)&vector1[i]);
+      __m256i v2 = _mm256_loadu_si256((const __m256i*)&vector2[i]);
+      sum_256 = _mm256_add_epi32(sum_256, _mm256_madd_epi16(v1, v2));
+    }
+  } else {
+    __m128i shift = _mm_cvtsi32_si128(right_shifts);
+    for (; i + 16 <= length; i += 16) {
+      __m256i v1 = _mm256_loadu_si256((const __m256i*)&vector1[i]);
+      __m256i v2 = _mm256_loadu_si256((const __m256i*)&vector2[i]);
+      __m256i lo = _mm256_mullo_epi16(v1, v2);
+      __m256i hi = _mm256_mulhi_epi16(v1, v2);
+      // The unpacks work within 128-bit lanes, which does not matter for
+      // a sum.
+      sum_256 = _mm256_add_epi32(
+          sum_256, _mm256_sra_epi32(_mm256_unpacklo_epi16(lo, hi), shift));
+      sum_256 = _mm256_add_epi32(
+          sum_256, _mm256_sra_epi32(_mm256_unpackhi_epi16(lo, hi), shift));
+    }
+  }
+  sum = HorizontalSum(sum_256);
+
+  for (; i < length; i++)
+    sum += (vector1[i] * vector2[i]) >> right_shifts;
+  return sum;
+}
+
+// AVX2 version of WebRtcSpl_CrossCorrelation() for x86 platforms.
+void WebRtcSpl_CrossCorrelationAVX2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2) {
+  size_t i = 0;
+
+  for (i = 0; i < dim_cross_correlation; i++) {
+    *cross_correlation++ =
+        DotProductWithShiftAVX2(seq1, seq2, dim_seq, right_shifts);
+    seq2 += step_seq2;
+  }
+}
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+
+#include <emmintrin.h>
+
+static inline int32_t HorizontalSum(__m128i sum) {
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sum);
+}
+
+// Like the C version, every product is shifted before it is added, and the
+// sum wraps around on overflow, so the result is bit exact in any order.
+static inline int32_t DotProductWithShiftSSE2(const int16_t* vector1,
+                                              const int16_t* vector2,
+                                              size_t length,
+                                              int right_shifts) {
+  size_t i = 0;
+  int32_t sum = 0;
+  __m128i sum_128 = _mm_setzero_si128();
+
+  if (right_shifts == 0) {
+    // Adding pairs of products before the shift makes no difference here.
+    for (; i + 8 <= length; i += 8) {
+      __m128i v1 = _mm_loadu_si128((const __m128i*)&vector1[i]);
+      __m128i v2 = _mm_loadu_si128((const __m128i*)&vector2[i]);
+      sum_128 = _mm_add_epi32(sum_128, _mm_madd_epi16(v1, v2));
+    }
+  } else {
+    __m128i shift = _mm_cvtsi32_si128(right_shifts);
+    for (; i + 8 <= length; i += 8) {
+      __m128i v1 = _mm_loadu_si128((const __m128i*)&vector1[i]);
+      __m128i v2 = _mm_loadu_si128((const __m128i*)&vector2[i]);
+      __m128i lo = _mm_mullo_epi16(v1, v2);
+      __m128i hi = _mm_mulhi_epi16(v1, v2);
+      sum_128 = _mm_add_epi32(
+          sum_128, _mm_sra_epi32(_mm_unpacklo_epi16(lo, hi), shift));
+      sum_128 = _mm_add_epi32(
+          sum_128, _mm_sra_epi32(_mm_unpackhi_epi16(lo, hi), shift));
+    }
+  }
+  sum = HorizontalSum(sum_128);
+
+  for (; i < length; i++)
+    sum += (vector1[i] * vector2[i]) >> right_shifts;
+  return sum;
+}
+
+// SSE2 version of WebRtcSpl_CrossCorrelation() for x86 platforms.
+void WebRtcSpl_CrossCorrelationSSE2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2) {
+  size_t i = 0;
+
+  for (i = 0; i < dim_cross_correlation; i++) {
+    *cross_correlation++ =
+        DotProductWithShiftSSE2(seq1, seq2, dim_seq, right_shifts);
+    seq2 += step_seq2;
+  }
+}
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+
+#include <emmintrin.h>
+
+#include "webrtc/base/checks.h"
+
+// Longer filters are left to the C version.
+#define MAX_COEFFICIENTS_LENGTH 64
+
+// SSE2 version of WebRtcSpl_DownsampleFast() for x86 platforms. The filters
+// used by NetEq are only a few taps long, so rather than vectorizing over the
+// taps of one output sample, each output sample is one or a few 8-sample
+// multiply-adds of the input window against the reversed, zero padded
+// coefficients.
+int WebRtcSpl_DownsampleFastSSE2(const int16_t* data_in,
+                                 size_t data_in_length,
+                                 int16_t* data_out,
+                                 size_t data_out_length,
+                                 const int16_t* __restrict coefficients,
+                                 size_t coefficients_length,
+                                 int factor,
+                                 size_t delay) {
+  int16_t* const original_data_out = data_out;
+  int16_t reversed[MAX_COEFFICIENTS_LENGTH];
+  __m128i taps[MAX_COEFFICIENTS_LENGTH / 8];
+  size_t padded_length = (coefficients_length + 7) & ~(size_t)7;
+  size_t i = 0;
+  size_t j = 0;
+  int32_t out_s32 = 0;
+  size_t endpos = delay + factor * (data_out_length - 1) + 1;
+
+  // Return error if any of the running conditions doesn't meet.
+  if (data_out_length == 0 || coefficients_length == 0
+                           || data_in_length < endpos) {
+    return -1;
+  }
+  if (coefficients_length > MAX_COEFFICIENTS_LENGTH) {
+    return WebRtcSpl_DownsampleFastC(data_in, data_in_length, data_out,
+                                     data_out_length, coefficients,
+                                     coefficients_length, factor, delay);
+  }
+
+  // Output sample i is the window data_in[i - coefficients_length + 1 .. i]
+  // times the reversed coefficients. The zero padding reaches past sample i,
+  // so the last outputs, where it would read past the input, are left to the
+  // scalar loop below.
+  for (j = 0; j < padded_length; j++) {
+    reversed[j] =
+        j < coefficients_length ? coefficients[coefficients_length - 1 - j] : 0;
+  }
+  for (j = 0; j < padded_length; j += 8)
+    taps[j / 8] = _mm_loadu_si128((const __m128i*)&reversed[j]);
+
+  for (i = delay; i < endpos; i += factor) {
+    const int16_t* window = &data_in[i + 1 - coefficients_length];
+    __m128i sum;
+    if (i + 1 - coefficients_length + padded_length > data_in_length)
+      break;
+    sum = _mm_setzero_si128();
+    for (j = 0; j < padded_length; j += 8) {
+      sum = _mm_add_epi32(
+          sum, _mm_madd_epi16(_mm_loadu_si128((const __m128i*)&window[j]),
+                              taps[j / 8]));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    out_s32 = 2048 + _mm_cvtsi128_si32(sum);  // Round value, 0.5 in Q12.
+    *data_out++ = WebRtcSpl_SatW32ToW16(out_s32 >> 12);  // Q0.
+  }
+
+  for (; i < endpos; i += factor) {
+    out_s32 = 2048;  // Round value, 0.5 in Q12.
+    for (j = 0; j < coefficients_length; j++)
+      out_s32 += coefficients[j] * data_in[i - j];  // Q12.
+    *data_out++ = WebRtcSpl_SatW32ToW16(out_s32 >> 12);  // Q0.
+  }
+
+  RTC_DCHECK_EQ(original_data_out + data_out_length, data_out);
+
+  return 0;
+}
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+#include <stdlib.h>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+
+// Maximum absolute value of word16 vector. AVX2 version for x86 platforms.
+int16_t WebRtcSpl_MaxAbsValueW16AVX2(const int16_t* vector, size_t length) {
+  size_t i = 0;
+  int absolute = 0, maximum = 0;
+  __m256i max_256 = _mm256_setzero_si256();
+  __m128i max_128;
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (; i + 16 <= length; i += 16) {
+    __m256i v = _mm256_loadu_si256((const __m256i*)&vector[i]);
+    // vpabsw leaves -32768 alone, which is 32768 as unsigned.
+    max_256 = _mm256_max_epu16(max_256, _mm256_abs_epi16(v));
+  }
+  max_128 = _mm_max_epu16(_mm256_castsi256_si128(max_256),
+                          _mm256_extracti128_si256(max_256, 1));
+  // The minimum of the complement is the complement of the maximum.
+  max_128 = _mm_minpos_epu16(_mm_xor_si128(max_128, _mm_set1_epi16(-1)));
+  maximum = 0xFFFF ^ (_mm_cvtsi128_si32(max_128) & 0xFFFF);
+
+  for (; i < length; i++) {
+    absolute = abs((int)vector[i]);
+    if (absolute > maximum) {
+      maximum = absolute;
+    }
+  }
+
+  // Guard the case for abs(-32768).
+  if (maximum > WEBRTC_SPL_WORD16_MAX) {
+    maximum = WEBRTC_SPL_WORD16_MAX;
+  }
+
+  return (int16_t)maximum;
+}
+
+// Maximum absolute value of word32 vector. AVX2 version for x86 platforms.
+int32_t WebRtcSpl_MaxAbsValueW32AVX2(const int32_t* vector, size_t length) {
+  size_t i = 0;
+  uint32_t absolute = 0, maximum = 0;
+  __m256i max_256 = _mm256_setzero_si256();
+  __m128i max_128;
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (; i + 8 <= length; i += 8) {
+    __m256i v = _mm256_loadu_si256((const __m256i*)&vector[i]);
+    // As unsigned, abs(0x80000000) is 0x80000000, like in the C version.
+    max_256 = _mm256_max_epu32(max_256, _mm256_abs_epi32(v));
+  }
+  max_128 = _mm_max_epu32(_mm256_castsi256_si128(max_256),
+                          _mm256_extracti128_si256(max_256, 1));
+  max_128 = _mm_max_epu32(max_128,
+                          _mm_shuffle_epi32(max_128, _MM_SHUFFLE(1, 0, 3, 2)));
+  max_128 = _mm_max_epu32(max_128,
+                          _mm_shuffle_epi32(max_128, _MM_SHUFFLE(2, 3, 0, 1)));
+  maximum = (uint32_t)_mm_cvtsi128_si32(max_128);
+
+  for (; i < length; i++) {
+    // Negate as unsigned; abs(0x80000000) is undefined.
+    absolute = vector[i] < 0 ? 0u - (uint32_t)vector[i] : (uint32_t)vector[i];
+    if (absolute > maximum) {
+      maximum = absolute;
+    }
+  }
+
+  maximum = WEBRTC_SPL_MIN(maximum, WEBRTC_SPL_WORD32_MAX);
+
+  return (int32_t)maximum;
+}
@@ -0,0 +1,199 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+#include <stdlib.h>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+
+// SSE2 has no 32-bit min and max, so they are built from a compare.
+static inline __m128i MaxEpi32(__m128i a, __m128i b) {
+  __m128i greater = _mm_cmpgt_epi32(a, b);
+  return _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, b));
+}
+
+static inline __m128i MinEpi32(__m128i a, __m128i b) {
+  __m128i greater = _mm_cmpgt_epi32(a, b);
+  return _mm_or_si128(_mm_and_si128(greater, b), _mm_andnot_si128(greater, a));
+}
+
+static inline int16_t HorizontalMaxEpi16(__m128i v) {
+  v = _mm_max_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = _mm_max_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  v = _mm_max_epi16(v, _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return (int16_t)_mm_cvtsi128_si32(v);
+}
+
+static inline int16_t HorizontalMinEpi16(__m128i v) {
+  v = _mm_min_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = _mm_min_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  v = _mm_min_epi16(v, _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return (int16_t)_mm_cvtsi128_si32(v);
+}
+
+static inline int32_t HorizontalMaxEpi32(__m128i v) {
+  v = MaxEpi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = MaxEpi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(v);
+}
+
+static inline int32_t HorizontalMinEpi32(__m128i v) {
+  v = MinEpi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = MinEpi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(v);
+}
+
+// Maximum absolute value of word16 vector. SSE2 version for x86 platforms.
+int16_t WebRtcSpl_MaxAbsValueW16SSE2(const int16_t* vector, size_t length) {
+  size_t i = 0;
+  int absolute = 0, maximum = 0;
+  __m128i zero = _mm_setzero_si128();
+  __m128i max_128 = zero;
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (; i + 8 <= length; i += 8) {
+    __m128i v = _mm_loadu_si128((const __m128i*)&vector[i]);
+    // The saturating negation turns -32768 into 32767, which is what the
+    // C version clamps it to.
+    max_128 = _mm_max_epi16(max_128, _mm_max_epi16(v, _mm_subs_epi16(zero, v)));
+  }
+  maximum = HorizontalMaxEpi16(max_128);
+
+  for (; i < length; i++) {
+    absolute = abs((int)vector[i]);
+    if (absolute > maximum) {
+      maximum = absolute;
+    }
+  }
+
+  // Guard the case for abs(-32768).
+  if (maximum > WEBRTC_SPL_WORD16_MAX) {
+    maximum = WEBRTC_SPL_WORD16_MAX;
+  }
+
+  return (int16_t)maximum;
+}
+
+// Maximum absolute value of word32 vector. SSE2 version for x86 platforms.
+int32_t WebRtcSpl_MaxAbsValueW32SSE2(const int32_t* vector, size_t length) {
+  size_t i = 0;
+  uint32_t absolute = 0, maximum = 0;
+  __m128i max_128 = _mm_setzero_si128();
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (; i + 4 <= length; i += 4) {
+    __m128i v = _mm_loadu_si128((const __m128i*)&vector[i]);
+    __m128i sign = _mm_srai_epi32(v, 31);
+    __m128i abs_v = _mm_sub_epi32(_mm_xor_si128(v, sign), sign);
+    // Only abs(0x80000000) still has the top bit set; clamp it to
+    // WEBRTC_SPL_WORD32_MAX like the C version does, so that a signed
+    // compare works for the rest.
+    abs_v = _mm_sub_epi32(abs_v, _mm_srli_epi32(abs_v, 31));
+    max_128 = MaxEpi32(max_128, abs_v);
+  }
+  maximum = (uint32_t)HorizontalMaxEpi32(max_128);
+
+  for (; i < length; i++) {
+    // Negate as unsigned; abs(0x80000000) is undefined.
+    absolute = vector[i] < 0 ? 0u - (uint32_t)vector[i] : (uint32_t)vector[i];
+    if (absolute > maximum) {
+      maximum = absolute;
+    }
+  }
+
+  maximum = WEBRTC_SPL_MIN(maximum, WEBRTC_SPL_WORD32_MAX);
+
+  return (int32_t)maximum;
+}
+
+// Maximum value of word16 vector. SSE2 version for x86 platforms.
+int16_t WebRtcSpl_MaxValueW16SSE2(const int16_t* vector, size_t length) {
+  size_t i = 0;
+  int16_t maximum = WEBRTC_SPL_WORD16_MIN;
+  __m128i max_128 = _mm_set1_epi16(WEBRTC_SPL_WORD16_MIN);
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (; i + 8 <= length; i += 8) {
+    max_128 = _mm_max_epi16(max_128,
+                            _mm_loadu_si128((const __m128i*)&vector[i]));
+  }
+  maximum = HorizontalMaxEpi16(max_128);
+
+  for (; i < length; i++) {
+    if (vector[i] > maximum)
+      maximum = vector[i];
+  }
+  return maximum;
+}
+
+// Maximum value of word32 vector. SSE2 version for x86 platforms.
+int32_t WebRtcSpl_MaxValueW32SSE2(const int32_t* vector, size_t length) {
+  size_t i = 0;
+  int32_t maximum = WEBRTC_SPL_WORD32_MIN;
+  __m128i max_128 = _mm_set1_epi32(WEBRTC_SPL_WORD32_MIN);
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (; i + 4 <= length; i += 4) {
+    max_128 = MaxEpi32(max_128, _mm_loadu_si128((const __m128i*)&vector[i]));
+  }
+  maximum = HorizontalMaxEpi32(max_128);
+
+  for (; i < length; i++) {
+    if (vector[i] > maximum)
+      maximum = vector[i];
+  }
+  return maximum;
+}
+
+// Minimum value of word16 vector. SSE2 version for x86 platforms.
+int16_t WebRtcSpl_MinValueW16SSE2(const int16_t* vector, size_t length) {
+  size_t i = 0;
+  int16_t minimum = WEBRTC_SPL_WORD16_MAX;
+  __m128i min_128 = _mm_set1_epi16(WEBRTC_SPL_WORD16_MAX);
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (; i + 8 <= length; i += 8) {
+    min_128 = _mm_min_epi16(min_128,
+                            _mm_loadu_si128((const __m128i*)&vector[i]));
+  }
+  minimum = HorizontalMinEpi16(min_128);
+
+  for (; i < length; i++) {
+    if (vector[i] < minimum)
+      minimum = vector[i];
+  }
+  return minimum;
+}
+
+// Minimum value of word32 vector. SSE2 version for x86 platforms.
+int32_t WebRtcSpl_MinValueW32SSE2(const int32_t* vector, size_t length) {
+  size_t i = 0;
+  int32_t minimum = WEBRTC_SPL_WORD32_MAX;
+  __m128i min_128 = _mm_set1_epi32(WEBRTC_SPL_WORD32_MAX);
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (; i + 4 <= length; i += 4) {
+    min_128 = MinEpi32(min_128, _mm_loadu_si128((const __m128i*)&vector[i]));
+  }
+  minimum = HorizontalMinEpi32(min_128);
+
+  for (; i < length; i++) {
+    if (vector[i] < minimum)
+      minimum = vector[i];
+  }
+  return minimum;
+}
@@ -9,9 +9,12 @@
  */
 
 #include <algorithm>
+#include <cstdlib>
 #include <sstream>
 
+#include "webrtc/base/random.h"
 #include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 #include "webrtc/test/gtest.h"
 
 static const size_t kVector16Size = 9;
@@ -475,7 +478,7 @@ TEST_F(SplTest, CrossCorrelationTest) {
   const int32_t kExpected[kCrossCorrelationDimension] =
       {-266947903, -15579555, -171282001};
   const int32_t* expected = kExpected;
-#if !defined(MIPS32_LE)
+#if defined(WEBRTC_HAS_NEON)
   const int32_t kExpectedNeon[kCrossCorrelationDimension] =
       {-266947901, -15579553, -171281999};
   if (WebRtcSpl_CrossCorrelation != WebRtcSpl_CrossCorrelationC) {
@@ -605,3 +608,156 @@ TEST_F(SplTest, Resample48WithSaturationTest) {
     EXPECT_EQ(kRefValue16kHz2, out_vector_w16[i]);
   }
 }
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+namespace {
+
+// Random samples, with a good share of the extreme values that the SIMD
+// versions have to treat like the C version does.
+void FillRandomW16(webrtc::Random* random, int16_t* vector, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    switch (random->Rand(0, 7)) {
+      case 0:
+        vector[i] = WEBRTC_SPL_WORD16_MIN;
+        break;
+      case 1:
+        vector[i] = WEBRTC_SPL_WORD16_MAX;
+        break;
+      default:
+        vector[i] = random->Rand<int16_t>();
+    }
+  }
+}
+
+void FillRandomW32(webrtc::Random* random, int32_t* vector, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    switch (random->Rand(0, 7)) {
+      case 0:
+        vector[i] = WEBRTC_SPL_WORD32_MIN;
+        break;
+      case 1:
+        vector[i] = WEBRTC_SPL_WORD32_MAX;
+        break;
+      default:
+        vector[i] = static_cast<int32_t>(random->Rand<uint32_t>());
+    }
+  }
+}
+
+// The C version relies on abs(0x80000000) wrapping, which an optimizing
+// compiler need not honor, so the expected value is computed in 64 bits.
+int32_t MaxAbsValueW32Reference(const int32_t* vector, size_t length) {
+  int64_t maximum = 0;
+  for (size_t i = 0; i < length; ++i)
+    maximum = std::max(maximum, std::abs(static_cast<int64_t>(vector[i])));
+  return static_cast<int32_t>(
+      std::min<int64_t>(maximum, WEBRTC_SPL_WORD32_MAX));
+}
+
+}  // namespace
+
+// The x86 versions are bit exact with the C versions, for all lengths around
+// the vector widths.
+TEST_F(SplTest, X86VersionsMatchC) {
+  const size_t kMaxLength = 80;
+  const bool have_sse2 = WebRtc_GetCPUInfo(kSSE2) != 0;
+  const bool have_avx2 = WebRtc_GetCPUInfo(kAVX2) != 0;
+  webrtc::Random random(0x5eed);
+  int16_t in16_1[2 * kMaxLength];
+  int16_t in16_2[2 * kMaxLength];
+  int32_t in32[kMaxLength];
+
+  for (int round = 0; round < 20; ++round) {
+    FillRandomW16(&random, in16_1, 2 * kMaxLength);
+    FillRandomW16(&random, in16_2, 2 * kMaxLength);
+    FillRandomW32(&random, in32, kMaxLength);
+
+    for (size_t length = 1; length <= kMaxLength; ++length) {
+      SCOPED_TRACE(length);
+      if (have_sse2) {
+        EXPECT_EQ(WebRtcSpl_MaxAbsValueW16C(in16_1, length),
+                  WebRtcSpl_MaxAbsValueW16SSE2(in16_1, length));
+        EXPECT_EQ(MaxAbsValueW32Reference(in32, length),
+                  WebRtcSpl_MaxAbsValueW32SSE2(in32, length));
+        EXPECT_EQ(WebRtcSpl_MaxValueW16C(in16_1, length),
+                  WebRtcSpl_MaxValueW16SSE2(in16_1, length));
+        EXPECT_EQ(WebRtcSpl_MaxValueW32C(in32, length),
+                  WebRtcSpl_MaxValueW32SSE2(in32, length));
+        EXPECT_EQ(WebRtcSpl_MinValueW16C(in16_1, length),
+                  WebRtcSpl_MinValueW16SSE2(in16_1, length));
+        EXPECT_EQ(WebRtcSpl_MinValueW32C(in32, length),
+                  WebRtcSpl_MinValueW32SSE2(in32, length));
+
+        const int16_t scale1 = random.Rand<int16_t>();
+        const int16_t scale2 = random.Rand<int16_t>();
+        const int shift = random.Rand(0, 16);
+        int16_t out_c[kMaxLength];
+        int16_t out_sse2[kMaxLength];
+        EXPECT_EQ(0, WebRtcSpl_ScaleAndAddVectorsWithRoundC(
+                         in16_1, scale1, in16_2, scale2, shift, out_c,
+                         length));
+        EXPECT_EQ(0, WebRtcSpl_ScaleAndAddVectorsWithRoundSSE2(
+                         in16_1, scale1, in16_2, scale2, shift, out_sse2,
+                         length));
+        for (size_t i = 0; i < length; ++i)
+          EXPECT_EQ(out_c[i], out_sse2[i]) << "at " << i;
+      }
+      if (have_avx2) {
+        EXPECT_EQ(WebRtcSpl_MaxAbsValueW16C(in16_1, length),
+                  WebRtcSpl_MaxAbsValueW16AVX2(in16_1, length));
+        EXPECT_EQ(MaxAbsValueW32Reference(in32, length),
+                  WebRtcSpl_MaxAbsValueW32AVX2(in32, length));
+      }
+
+      // Lags and steps like NetEq's, with and without scaling.
+      const size_t kDimCrossCorrelation = 8;
+      for (int step = -1; step <= 1; step += 2) {
+        for (int shift = 0; shift <= 6; shift += 3) {
+          const int16_t* seq2 =
+              step > 0 ? in16_2 : in16_2 + kDimCrossCorrelation;
+          int32_t corr_c[kDimCrossCorrelation];
+          int32_t corr_simd[kDimCrossCorrelation];
+          WebRtcSpl_CrossCorrelationC(corr_c, in16_1, seq2, length,
+                                      kDimCrossCorrelation, shift, step);
+          if (have_sse2) {
+            WebRtcSpl_CrossCorrelationSSE2(corr_simd, in16_1, seq2, length,
+                                           kDimCrossCorrelation, shift, step);
+            for (size_t i = 0; i < kDimCrossCorrelation; ++i)
+              EXPECT_EQ(corr_c[i], corr_simd[i]) << "SSE2 lag " << i;
+          }
+          if (have_avx2) {
+            WebRtcSpl_CrossCorrelationAVX2(corr_simd, in16_1, seq2, length,
+                                           kDimCrossCorrelation, shift, step);
+            for (size_t i = 0; i < kDimCrossCorrelation; ++i)
+              EXPECT_EQ(corr_c[i], corr_simd[i]) << "AVX2 lag " << i;
+          }
+        }
+      }
+
+      // NetEq's decimation filters are 3 to 7 taps long; longer ones take
+      // more than one vector per output.
+      if (have_sse2) {
+        for (size_t taps = 1; taps <= 20; taps += 3) {
+          for (int factor = 1; factor <= 6; factor += 5) {
+            const size_t delay = taps - 1;
+            if (delay + 1 > length)
+              continue;
+            const size_t out_length = (length - delay - 1) / factor + 1;
+            int16_t out_c[kMaxLength];
+            int16_t out_sse2[kMaxLength];
+            EXPECT_EQ(0, WebRtcSpl_DownsampleFastC(in16_1, length, out_c,
+                                                   out_length, in16_2, taps,
+                                                   factor, delay));
+            EXPECT_EQ(0, WebRtcSpl_DownsampleFastSSE2(in16_1, length,
+                                                      out_sse2, out_length,
+                                                      in16_2, taps, factor,
+                                                      delay));
+            for (size_t i = 0; i < out_length; ++i)
+              EXPECT_EQ(out_c[i], out_sse2[i]) << "at " << i;
+          }
+        }
+      }
+    }
+  }
+}
+#endif  // WEBRTC_ARCH_X86_FAMILY
@@ -9,7 +9,7 @@
  */
 
 /* The global function contained in this file initializes SPL function
- * pointers, currently only for ARM platforms.
+ * pointers for ARM, MIPS and x86 platforms.
  *
  * Some code came from common/rtcd.c in the WebM project.
  */
@@ -60,6 +60,30 @@ static void InitPointersToNeon() {
 }
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+/* Replace the generic C versions with the SSE2 and AVX2 versions the CPU
+ * supports. */
+static void InitPointersToX86() {
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    WebRtcSpl_MaxAbsValueW16 = WebRtcSpl_MaxAbsValueW16SSE2;
+    WebRtcSpl_MaxAbsValueW32 = WebRtcSpl_MaxAbsValueW32SSE2;
+    WebRtcSpl_MaxValueW16 = WebRtcSpl_MaxValueW16SSE2;
+    WebRtcSpl_MaxValueW32 = WebRtcSpl_MaxValueW32SSE2;
+    WebRtcSpl_MinValueW16 = WebRtcSpl_MinValueW16SSE2;
+    WebRtcSpl_MinValueW32 = WebRtcSpl_MinValueW32SSE2;
+    WebRtcSpl_CrossCorrelation = WebRtcSpl_CrossCorrelationSSE2;
+    WebRtcSpl_DownsampleFast = WebRtcSpl_DownsampleFastSSE2;
+    WebRtcSpl_ScaleAndAddVectorsWithRound =
+        WebRtcSpl_ScaleAndAddVectorsWithRoundSSE2;
+  }
+  if (WebRtc_GetCPUInfo(kAVX2)) {
+    WebRtcSpl_MaxAbsValueW16 = WebRtcSpl_MaxAbsValueW16AVX2;
+    WebRtcSpl_MaxAbsValueW32 = WebRtcSpl_MaxAbsValueW32AVX2;
+    WebRtcSpl_CrossCorrelation = WebRtcSpl_CrossCorrelationAVX2;
+  }
+}
+#endif
+
 #if defined(MIPS32_LE)
 /* Initialize function pointers to the MIPS version. */
 static void InitPointersToMIPS() {
@@ -89,6 +113,9 @@ static void InitFunctionPointers(void) {
   InitPointersToMIPS();
 #else
   InitPointersToC();
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  InitPointersToX86();
+#endif
 #endif  /* WEBRTC_HAS_NEON */
 }
 
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+
+// SSE2 version of WebRtcSpl_ScaleAndAddVectorsWithRound() for x86 platforms.
+int WebRtcSpl_ScaleAndAddVectorsWithRoundSSE2(const int16_t* in_vector1,
+                                              int16_t in_vector1_scale,
+                                              const int16_t* in_vector2,
+                                              int16_t in_vector2_scale,
+                                              int right_shifts,
+                                              int16_t* out_vector,
+                                              size_t length) {
+  size_t i = 0;
+  int round_value = (1 << right_shifts) >> 1;
+  __m128i scales;
+  __m128i round;
+  __m128i shift;
+
+  if (in_vector1 == NULL || in_vector2 == NULL || out_vector == NULL ||
+      length == 0 || right_shifts < 0) {
+    return -1;
+  }
+
+  // Interleaving the two inputs lets one multiply-add per 32-bit lane compute
+  // in1 * scale1 + in2 * scale2.
+  scales = _mm_set1_epi32((in_vector1_scale & 0xFFFF) |
+                          ((int32_t)in_vector2_scale << 16));
+  round = _mm_set1_epi32(round_value);
+  shift = _mm_cvtsi32_si128(right_shifts);
+  for (; i + 8 <= length; i += 8) {
+    __m128i v1 = _mm_loadu_si128((const __m128i*)&in_vector1[i]);
+    __m128i v2 = _mm_loadu_si128((const __m128i*)&in_vector2[i]);
+    __m128i lo = _mm_sra_epi32(
+        _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(v1, v2), scales),
+                      round),
+        shift);
+    __m128i hi = _mm_sra_epi32(
+        _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(v1, v2), scales),
+                      round),
+        shift);
+    // The C version truncates to 16 bits rather than saturating, so the
+    // results are sign extended from their low half before the pack.
+    lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+    hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+    _mm_storeu_si128((__m128i*)&out_vector[i], _mm_packs_epi32(lo, hi));
+  }
+
+  for (; i < length; i++) {
+    out_vector[i] = (int16_t)((
+        in_vector1[i] * in_vector1_scale + in_vector2[i] * in_vector2_scale +
+        round_value) >> right_shifts);
+  }
+
+  return 0;
+}
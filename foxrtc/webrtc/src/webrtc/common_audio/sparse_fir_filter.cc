@@ -10,6 +10,8 @@
 
 #include "webrtc/common_audio/sparse_fir_filter.h"
 
+#include <algorithm>
+
 #include "webrtc/base/checks.h"
 
 namespace webrtc {
@@ -30,8 +32,10 @@ SparseFIRFilter::~SparseFIRFilter() = default;
 
 void SparseFIRFilter::Filter(const float* in, size_t length, float* out) {
   // Convolves the input signal |in| with the filter kernel |nonzero_coeffs_|
-  // taking into account the previous state.
-  for (size_t i = 0; i < length; ++i) {
+  // taking into account the previous state. Only the first |state_.size()|
+  // outputs reach back into the state.
+  const size_t head = std::min(length, state_.size());
+  for (size_t i = 0; i < head; ++i) {
     out[i] = 0.f;
     size_t j;
     for (j = 0; i >= j * sparsity_ + offset_ &&
@@ -44,6 +48,20 @@ void SparseFIRFilter::Filter(const float* in, size_t length, float* out) {
     }
   }
 
+  // The remaining outputs only depend on |in|. Accumulating one coefficient
+  // at a time adds the products in the same order as above, without the
+  // branches, so that the compiler can vectorize the inner loop.
+  if (head < length) {
+    std::fill(out + head, out + length, 0.f);
+    for (size_t j = 0; j < nonzero_coeffs_.size(); ++j) {
+      const float coeff = nonzero_coeffs_[j];
+      const float* delayed = &in[head - j * sparsity_ - offset_];
+      float* tail = &out[head];
+      for (size_t i = 0; i < length - head; ++i)
+        tail[i] += delayed[i] * coeff;
+    }
+  }
+
   // Update current state.
   if (state_.size() > 0u) {
     if (length >= state_.size()) {
@@ -16,6 +16,37 @@ namespace webrtc {
 
 StreamDataCounters::StreamDataCounters() : first_packet_time_ms(-1) {}
 
+FrameTimeHistogram::FrameTimeHistogram()
+    : buckets(), num_frames(0), max_ms(0) {}
+
+void FrameTimeHistogram::Add(int time_ms) {
+  if (time_ms < 0)
+    time_ms = 0;
+  int bucket = time_ms / kBucketMs;
+  if (bucket >= kNumBuckets)
+    bucket = kNumBuckets - 1;
+  ++buckets[bucket];
+  ++num_frames;
+  if (time_ms > max_ms)
+    max_ms = time_ms;
+}
+
+int FrameTimeHistogram::Percentile(int percent) const {
+  if (num_frames == 0)
+    return -1;
+  // Smallest count that covers |percent| of the frames, rounded up.
+  uint64_t target = (static_cast<uint64_t>(num_frames) * percent + 99) / 100;
+  if (target == 0)
+    target = 1;
+  uint64_t count = 0;
+  for (int i = 0; i < kNumBuckets - 1; ++i) {
+    count += buckets[i];
+    if (count >= target)
+      return (i + 1) * kBucketMs;
+  }
+  return max_ms;
+}
+
 RTPHeaderExtension::RTPHeaderExtension()
     : hasTransmissionTimeOffset(false),
       transmissionTimeOffset(0),
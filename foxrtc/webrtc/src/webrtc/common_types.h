@@ -269,6 +269,24 @@ struct FrameCounts {
   int delta_frames;
 };
 
+// Distribution of per-frame processing times, e.g. encode or decode time.
+// Bucket i counts frames that took [i * kBucketMs, (i + 1) * kBucketMs) ms,
+// the last bucket also counts everything slower.
+struct FrameTimeHistogram {
+  static const int kBucketMs = 2;
+  static const int kNumBuckets = 32;
+
+  FrameTimeHistogram();
+  void Add(int time_ms);
+  // Returns the upper bound, in ms, of the bucket holding the |percent|th
+  // percentile, or -1 if no frames have been added.
+  int Percentile(int percent) const;
+
+  uint32_t buckets[kNumBuckets];
+  uint32_t num_frames;
+  int max_ms;
+};
+
 // Callback, used to notify an observer whenever frame counts have been updated.
 class FrameCountObserver {
  public:
@@ -539,6 +557,12 @@ struct VideoCodecVP9 {
   bool automaticResizeOn;
   unsigned char numberOfSpatialLayers;
   bool flexibleMode;
+  // Encoder/decoder thread count. 0 lets the encoder derive it from
+  // resolution and cores, and decodes on one thread.
+  int numberOfThreads;
+  // Decode consecutive frames on separate threads. Adds up to
+  // |numberOfThreads| - 1 frames of decode latency.
+  bool frameParallelDecoding;
 };
 
 // H264 specific.
@@ -13,7 +13,10 @@
 
 #include <memory>
 
+#include "libyuv/cpu_id.h"
+#include "libyuv/row.h"
 #include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 #include "webrtc/test/frame_utils.h"
 #include "webrtc/test/gtest.h"
 #include "webrtc/test/testsupport/fileutils.h"
@@ -253,4 +256,24 @@ TEST_F(TestLibYuv, RotateTest) {
                              rotated_res_i420_buffer.get()));
 }
 
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(MEMORY_SANITIZER)
+// Without its x86 rows, or when it fails to detect the CPU, libyuv silently
+// falls back to C rows that are several times slower. Checks the rows behind
+// the capture (ARGB, YUY2 to I420) and render (I420 to ARGB) conversions.
+TEST(TestLibYuvCpu, UsesSimdRows) {
+#if !defined(HAS_ARGBTOYROW_SSSE3) || !defined(HAS_ARGBTOUVROW_SSSE3) || \
+    !defined(HAS_I422TOARGBROW_SSSE3) || !defined(HAS_YUY2TOYROW_SSE2)
+  ADD_FAILURE() << "libyuv is built without its SSE2/SSSE3 rows.";
+#endif
+  EXPECT_TRUE(libyuv::TestCpuFlag(libyuv::kCpuHasSSE2));
+  if (WebRtc_GetCPUInfo(kAVX2)) {
+#if !defined(HAS_ARGBTOYROW_AVX2) || !defined(HAS_ARGBTOUVROW_AVX2) || \
+    !defined(HAS_I422TOARGBROW_AVX2) || !defined(HAS_YUY2TOYROW_AVX2)
+    ADD_FAILURE() << "libyuv is built without its AVX2 rows.";
+#endif
+    EXPECT_TRUE(libyuv::TestCpuFlag(libyuv::kCpuHasAVX2));
+  }
+}
+#endif
+
 }  // namespace webrtc
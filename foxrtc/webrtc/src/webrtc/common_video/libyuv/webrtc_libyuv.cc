@@ -79,6 +79,7 @@ size_t CalcBufferSize(VideoType type, int width, int height) {
     case kRGB24:
       buffer_size = width * height * 3;
       break;
+    case kABGR:
     case kBGRA:
     case kARGB:
       buffer_size = width * height * 4;
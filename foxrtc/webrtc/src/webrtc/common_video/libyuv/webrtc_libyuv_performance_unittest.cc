@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "webrtc/base/random.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+#include "webrtc/video_frame.h"
+
+namespace webrtc {
+namespace {
+
+// Every raw format webrtc_libyuv converts from and to. MJPG only decodes.
+const struct {
+  VideoType type;
+  const char* name;
+} kFormats[] = {
+    {kI420, "i420"},         {kIYUV, "iyuv"},         {kYV12, "yv12"},
+    {kNV12, "nv12"},         {kNV21, "nv21"},         {kYUY2, "yuy2"},
+    {kUYVY, "uyvy"},         {kRGB24, "rgb24"},       {kRGB565, "rgb565"},
+    {kARGB1555, "argb1555"}, {kARGB4444, "argb4444"}, {kARGB, "argb"},
+    {kABGR, "abgr"},         {kBGRA, "bgra"},
+};
+
+const struct {
+  int width;
+  int height;
+  const char* name;
+} kResolutions[] = {
+    {640, 360, "360p"},
+    {1280, 720, "720p"},
+    {1920, 1080, "1080p"},
+    {3840, 2160, "2160p"},
+};
+
+// Converts about 50 1080p frames per measurement, whatever the resolution.
+const int kPixelsPerMeasurement = 50 * 1920 * 1080;
+
+void FillRandom(Random* random, uint8_t* data, size_t size) {
+  for (size_t i = 0; i < size; ++i)
+    data[i] = random->Rand<uint8_t>();
+}
+
+rtc::scoped_refptr<I420Buffer> CreateRandomI420Buffer(Random* random,
+                                                      int width,
+                                                      int height) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width, height);
+  FillRandom(random, buffer->MutableDataY(), buffer->StrideY() * height);
+  FillRandom(random, buffer->MutableDataU(),
+             buffer->StrideU() * ((height + 1) / 2));
+  FillRandom(random, buffer->MutableDataV(),
+             buffer->StrideV() * ((height + 1) / 2));
+  return buffer;
+}
+
+void PrintMegapixelsPerSecond(const std::string& direction,
+                              const std::string& format,
+                              const std::string& resolution,
+                              int64_t pixels,
+                              int64_t elapsed_ns) {
+  // 1 pixel per ns is 1000 Mpixel/s.
+  test::PrintResult("webrtc_libyuv_" + direction, "_" + resolution, format,
+                    static_cast<size_t>(pixels * 1000 /
+                                        std::max<int64_t>(elapsed_ns, 1)),
+                    "Mpixel/s", false);
+}
+
+}  // namespace
+
+TEST(WebRtcLibyuvPerformanceTest, ConvertToI420) {
+  Random random(0x12345678);
+  for (const auto& resolution : kResolutions) {
+    const int width = resolution.width;
+    const int height = resolution.height;
+    const int frames = kPixelsPerMeasurement / (width * height);
+    rtc::scoped_refptr<I420Buffer> dst = I420Buffer::Create(width, height);
+    for (const auto& format : kFormats) {
+      SCOPED_TRACE(std::string(format.name) + " " + resolution.name);
+      const size_t size = CalcBufferSize(format.type, width, height);
+      std::unique_ptr<uint8_t[]> src(new uint8_t[size]);
+      FillRandom(&random, src.get(), size);
+
+      int64_t start_ns = rtc::TimeNanos();
+      for (int i = 0; i < frames; ++i) {
+        ASSERT_EQ(0, ConvertToI420(format.type, src.get(), 0, 0, width,
+                                   height, size, kVideoRotation_0, dst.get()));
+      }
+      PrintMegapixelsPerSecond("to_i420", format.name, resolution.name,
+                               static_cast<int64_t>(frames) * width * height,
+                               rtc::TimeNanos() - start_ns);
+    }
+  }
+}
+
+TEST(WebRtcLibyuvPerformanceTest, ConvertFromI420) {
+  Random random(0x12345678);
+  for (const auto& resolution : kResolutions) {
+    const int width = resolution.width;
+    const int height = resolution.height;
+    const int frames = kPixelsPerMeasurement / (width * height);
+    VideoFrame src(CreateRandomI420Buffer(&random, width, height), 0, 0,
+                   kVideoRotation_0);
+    for (const auto& format : kFormats) {
+      SCOPED_TRACE(std::string(format.name) + " " + resolution.name);
+      std::unique_ptr<uint8_t[]> dst(
+          new uint8_t[CalcBufferSize(format.type, width, height)]);
+
+      int64_t start_ns = rtc::TimeNanos();
+      for (int i = 0; i < frames; ++i)
+        ASSERT_EQ(0, ConvertFromI420(src, format.type, 0, dst.get()));
+      PrintMegapixelsPerSecond("from_i420", format.name, resolution.name,
+                               static_cast<int64_t>(frames) * width * height,
+                               rtc::TimeNanos() - start_ns);
+    }
+  }
+}
+
+}  // namespace webrtc
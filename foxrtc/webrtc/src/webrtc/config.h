@@ -229,10 +229,19 @@ struct VideoDecoderH264Settings {
   std::string sprop_parameter_sets;
 };
 
+struct VideoDecoderVp9Settings {
+  // 0 decodes on one thread.
+  int number_of_threads = 0;
+  // Decode consecutive frames on separate threads. Adds up to
+  // |number_of_threads| - 1 frames of decode latency.
+  bool frame_parallel_decoding = false;
+};
+
 class DecoderSpecificSettings {
  public:
   virtual ~DecoderSpecificSettings() {}
   rtc::Optional<VideoDecoderH264Settings> h264_extra_settings;
+  VideoDecoderVp9Settings vp9_settings;
 };
 
 }  // namespace webrtc
@@ -185,6 +185,8 @@ class AudioCodingModuleImpl final : public AudioCodingModule {
 
   int DisableOpusDtx() override;
 
+  int SetOpusCpuAdaptation(bool enable) override;
+
   int UnregisterReceiveCodec(uint8_t payload_type) override;
 
   int EnableNack(size_t max_nack_list_size) override;
@@ -396,6 +398,9 @@ class RawAudioEncoderWrapper final : public AudioEncoder {
   void Reset() override { return enc_->Reset(); }
   bool SetFec(bool enable) override { return enc_->SetFec(enable); }
   bool SetDtx(bool enable) override { return enc_->SetDtx(enable); }
+  bool SetCpuAdaptation(bool enable) override {
+    return enc_->SetCpuAdaptation(enable);
+  }
   bool SetApplication(Application application) override {
     return enc_->SetApplication(application);
   }
@@ -1214,6 +1219,14 @@ int AudioCodingModuleImpl::DisableOpusDtx() {
   return encoder_stack_->SetDtx(false) ? 0 : -1;
 }
 
+int AudioCodingModuleImpl::SetOpusCpuAdaptation(bool enable) {
+  rtc::CritScope lock(&acm_crit_sect_);
+  if (!HaveValidEncoder("SetOpusCpuAdaptation")) {
+    return -1;
+  }
+  return encoder_stack_->SetCpuAdaptation(enable) ? 0 : -1;
+}
+
 int32_t AudioCodingModuleImpl::PlayoutTimestamp(uint32_t* timestamp) {
   rtc::Optional<uint32_t> ts = PlayoutTimestamp();
   if (!ts)
@@ -54,6 +54,10 @@ bool AudioEncoder::GetDtx() const {
   return false;
 }
 
+bool AudioEncoder::SetCpuAdaptation(bool enable) {
+  return !enable;
+}
+
 bool AudioEncoder::SetApplication(Application application) {
   return false;
 }
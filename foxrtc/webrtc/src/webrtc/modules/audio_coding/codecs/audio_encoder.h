@@ -131,6 +131,12 @@ class AudioEncoder {
   // returns false.
   virtual bool GetDtx() const;
 
+  // Enables or disables adapting the encoder's complexity and packet length
+  // to the time encoding takes. Returns true if the codec was able to comply.
+  // The default implementation returns true when asked to disable and false
+  // when asked to enable it.
+  virtual bool SetCpuAdaptation(bool enable);
+
   // Sets the application mode. Returns true if the codec was able to comply.
   // The default implementation just returns false.
   enum class Application { kSpeech, kAudio };
@@ -171,6 +171,10 @@ bool AudioEncoderCng::SetDtx(bool enable) {
   return speech_encoder_->SetDtx(enable);
 }
 
+bool AudioEncoderCng::SetCpuAdaptation(bool enable) {
+  return speech_encoder_->SetCpuAdaptation(enable);
+}
+
 bool AudioEncoderCng::SetApplication(Application application) {
   return speech_encoder_->SetApplication(application);
 }
@@ -59,6 +59,7 @@ class AudioEncoderCng final : public AudioEncoder {
   void Reset() override;
   bool SetFec(bool enable) override;
   bool SetDtx(bool enable) override;
+  bool SetCpuAdaptation(bool enable) override;
   bool SetApplication(Application application) override;
   void SetMaxPlaybackRate(int frequency_hz) override;
   void SetProjectedPacketLossRate(double fraction) override;
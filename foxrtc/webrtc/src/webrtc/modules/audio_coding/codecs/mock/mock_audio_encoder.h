@@ -37,6 +37,7 @@ class MockAudioEncoder : public AudioEncoder {
   MOCK_METHOD0(Reset, void());
   MOCK_METHOD1(SetFec, bool(bool enable));
   MOCK_METHOD1(SetDtx, bool(bool enable));
+  MOCK_METHOD1(SetCpuAdaptation, bool(bool enable));
   MOCK_METHOD1(SetApplication, bool(Application application));
   MOCK_METHOD1(SetMaxPlaybackRate, void(int frequency_hz));
   MOCK_METHOD1(SetProjectedPacketLossRate, void(double fraction));
@@ -11,9 +11,12 @@
 #include "webrtc/modules/audio_coding/codecs/opus/audio_encoder_opus.h"
 
 #include <algorithm>
+#include <iterator>
 
 #include "webrtc/base/checks.h"
+#include "webrtc/base/logging.h"
 #include "webrtc/base/safe_conversions.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/common_types.h"
 #include "webrtc/modules/audio_coding/codecs/opus/opus_interface.h"
 
@@ -25,6 +28,24 @@ const int kSampleRateHz = 48000;
 const int kMinBitrateBps = 500;
 const int kMaxBitrateBps = 512000;
 
+// CPU adaptation takes a step down while the smoothed encode time is above
+// |kHighEncodeLoad| of the packet duration, and a step back up while it is
+// below |kLowEncodeLoad|.
+const float kHighEncodeLoad = 0.3f;
+const float kLowEncodeLoad = 0.1f;
+// Weight of the latest packet in the smoothed encode load.
+const float kEncodeLoadAlpha = 0.1f;
+// Audio to encode after a step before taking the next one, so that the load
+// is measured with the new settings. Stepping back up waits much longer, to
+// not oscillate around the threshold.
+const int kStepDownIntervalMs = 1000;
+const int kStepUpIntervalMs = 10000;
+// Each step first lowers the complexity by |kComplexityStep| down to
+// |kMinAdaptedComplexity|, then moves to the next longer frame size.
+const int kComplexityStep = 2;
+const int kMinAdaptedComplexity = 1;
+const int kAdaptedFrameSizesMs[] = {20, 40, 60};
+
 AudioEncoderOpus::Config CreateConfig(const CodecInst& codec_inst) {
   AudioEncoderOpus::Config config;
   config.frame_size_ms = rtc::CheckedDivExact(codec_inst.pacsize, 48);
@@ -76,6 +97,44 @@ double OptimizePacketLossRate(double new_loss_rate, double old_loss_rate) {
   }
 }
 
+int ComplexitySteps(const AudioEncoderOpus::Config& config) {
+  return std::max(0, (config.complexity - kMinAdaptedComplexity +
+                      kComplexityStep - 1) / kComplexityStep);
+}
+
+int FrameSizeSteps(const AudioEncoderOpus::Config& config) {
+  return std::count_if(std::begin(kAdaptedFrameSizesMs),
+                       std::end(kAdaptedFrameSizesMs),
+                       [&config](int frame_size_ms) {
+                         return frame_size_ms > config.frame_size_ms;
+                       });
+}
+
+int MaxAdaptationSteps(const AudioEncoderOpus::Config& config) {
+  return ComplexitySteps(config) + FrameSizeSteps(config);
+}
+
+int AdaptedComplexity(const AudioEncoderOpus::Config& config, int steps) {
+  return std::max(
+      std::min(config.complexity, kMinAdaptedComplexity),
+      config.complexity -
+          kComplexityStep * std::min(steps, ComplexitySteps(config)));
+}
+
+int AdaptedFrameSizeMs(const AudioEncoderOpus::Config& config, int steps) {
+  int frame_size_ms = config.frame_size_ms;
+  steps -= ComplexitySteps(config);
+  for (int adapted_frame_size_ms : kAdaptedFrameSizesMs) {
+    if (steps <= 0)
+      break;
+    if (adapted_frame_size_ms > frame_size_ms) {
+      frame_size_ms = adapted_frame_size_ms;
+      --steps;
+    }
+  }
+  return frame_size_ms;
+}
+
 }  // namespace
 
 AudioEncoderOpus::Config::Config() = default;
@@ -105,7 +164,11 @@ int AudioEncoderOpus::Config::GetBitrateBps() const {
 }
 
 AudioEncoderOpus::AudioEncoderOpus(const Config& config)
-    : packet_loss_rate_(0.0), inst_(nullptr) {
+    : packet_loss_rate_(0.0),
+      inst_(nullptr),
+      encode_load_(0.0f),
+      adaptation_steps_(0),
+      ms_since_adaptation_(0) {
   RTC_CHECK(RecreateEncoderInstance(config));
 }
 
@@ -129,6 +192,10 @@ size_t AudioEncoderOpus::Num10MsFramesInNextPacket() const {
 }
 
 size_t AudioEncoderOpus::Max10MsFramesInAPacket() const {
+  if (config_.cpu_adaptation_enabled) {
+    return static_cast<size_t>(
+        AdaptedFrameSizeMs(config_, MaxAdaptationSteps(config_)) / 10);
+  }
   return Num10msFramesPerPacket();
 }
 
@@ -156,6 +223,12 @@ bool AudioEncoderOpus::GetDtx() const {
   return config_.dtx_enabled;
 }
 
+bool AudioEncoderOpus::SetCpuAdaptation(bool enable) {
+  auto conf = config_;
+  conf.cpu_adaptation_enabled = enable;
+  return RecreateEncoderInstance(conf);
+}
+
 bool AudioEncoderOpus::SetApplication(Application application) {
   auto conf = config_;
   switch (application) {
@@ -192,6 +265,39 @@ void AudioEncoderOpus::SetTargetBitrate(int bits_per_second) {
   RTC_CHECK_EQ(0, WebRtcOpus_SetBitRate(inst_, config_.GetBitrateBps()));
 }
 
+void AudioEncoderOpus::OnEncodeTime(int64_t encode_time_us) {
+  if (!config_.cpu_adaptation_enabled)
+    return;
+  // A changed frame size applies to the next packet, so this must only be
+  // called between packets.
+  RTC_DCHECK(input_buffer_.empty());
+  const int frame_size_ms = FrameSizeMs();
+  const float load =
+      static_cast<float>(encode_time_us) / (frame_size_ms * 1000);
+  encode_load_ += kEncodeLoadAlpha * (load - encode_load_);
+  ms_since_adaptation_ += frame_size_ms;
+
+  if (encode_load_ > kHighEncodeLoad &&
+      ms_since_adaptation_ >= kStepDownIntervalMs &&
+      adaptation_steps_ < MaxAdaptationSteps(config_)) {
+    ++adaptation_steps_;
+  } else if (encode_load_ < kLowEncodeLoad &&
+             ms_since_adaptation_ >= kStepUpIntervalMs &&
+             adaptation_steps_ > 0) {
+    --adaptation_steps_;
+  } else {
+    return;
+  }
+  ms_since_adaptation_ = 0;
+  RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, complexity()));
+  LOG(LS_INFO) << "Opus encode load " << encode_load_ << ", complexity "
+               << complexity() << ", frame size " << FrameSizeMs() << " ms";
+}
+
+int AudioEncoderOpus::complexity() const {
+  return AdaptedComplexity(config_, adaptation_steps_);
+}
+
 AudioEncoder::EncodedInfo AudioEncoderOpus::EncodeImpl(
     uint32_t rtp_timestamp,
     rtc::ArrayView<const int16_t> audio,
@@ -209,6 +315,7 @@ AudioEncoder::EncodedInfo AudioEncoderOpus::EncodeImpl(
                Num10msFramesPerPacket() * SamplesPer10msFrame());
 
   const size_t max_encoded_bytes = SufficientOutputBufferSize();
+  const int64_t start_us = rtc::TimeMicros();
   EncodedInfo info;
   info.encoded_bytes =
       encoded->AppendData(
@@ -225,6 +332,7 @@ AudioEncoder::EncodedInfo AudioEncoderOpus::EncodeImpl(
             return static_cast<size_t>(status);
           });
   input_buffer_.clear();
+  OnEncodeTime(rtc::TimeMicros() - start_us);
 
   info.encoded_timestamp = first_timestamp_in_buffer_;
   info.payload_type = config_.payload_type;
@@ -235,7 +343,11 @@ AudioEncoder::EncodedInfo AudioEncoderOpus::EncodeImpl(
 }
 
 size_t AudioEncoderOpus::Num10msFramesPerPacket() const {
-  return static_cast<size_t>(rtc::CheckedDivExact(config_.frame_size_ms, 10));
+  return static_cast<size_t>(rtc::CheckedDivExact(FrameSizeMs(), 10));
+}
+
+int AudioEncoderOpus::FrameSizeMs() const {
+  return AdaptedFrameSizeMs(config_, adaptation_steps_);
 }
 
 size_t AudioEncoderOpus::SamplesPer10msFrame() const {
@@ -272,7 +384,15 @@ bool AudioEncoderOpus::RecreateEncoderInstance(const Config& config) {
   }
   RTC_CHECK_EQ(
       0, WebRtcOpus_SetMaxPlaybackRate(inst_, config.max_playback_rate_hz));
-  RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, config.complexity));
+  // Keep the CPU adaptation across reconfigurations, as far as the new config
+  // has steps to take. Steps beyond those would have to be undone before the
+  // encoder recovers.
+  adaptation_steps_ =
+      config.cpu_adaptation_enabled
+          ? std::min(adaptation_steps_, MaxAdaptationSteps(config))
+          : 0;
+  RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(
+                      inst_, AdaptedComplexity(config, adaptation_steps_)));
   if (config.dtx_enabled) {
     RTC_CHECK_EQ(0, WebRtcOpus_EnableDtx(inst_));
   } else {
@@ -47,6 +47,10 @@ class AudioEncoderOpus final : public AudioEncoder {
     int max_playback_rate_hz = 48000;
     int complexity = kDefaultComplexity;
     bool dtx_enabled = false;
+    // Lower the complexity, and then lengthen the frames up to 60 ms, while
+    // encoding takes too large a share of the audio duration, and undo it
+    // when the load has gone down again.
+    bool cpu_adaptation_enabled = false;
 
    private:
 #if defined(WEBRTC_ANDROID) || defined(WEBRTC_IOS) || defined(WEBRTC_ARCH_ARM)
@@ -76,15 +80,22 @@ class AudioEncoderOpus final : public AudioEncoder {
   // for signaling) about every 400 ms.
   bool SetDtx(bool enable) override;
   bool GetDtx() const override;
+  bool SetCpuAdaptation(bool enable) override;
 
   bool SetApplication(Application application) override;
   void SetMaxPlaybackRate(int frequency_hz) override;
   void SetProjectedPacketLossRate(double fraction) override;
   void SetTargetBitrate(int target_bps) override;
 
+  // Feeds the time spent encoding the last packet into the CPU adaptation.
+  // Called by EncodeImpl(); public for testing.
+  void OnEncodeTime(int64_t encode_time_us);
+
   // Getters for testing.
   double packet_loss_rate() const { return packet_loss_rate_; }
   ApplicationMode application() const { return config_.application; }
+  int complexity() const;
+  float encode_load() const { return encode_load_; }
 
  protected:
   EncodedInfo EncodeImpl(uint32_t rtp_timestamp,
@@ -93,6 +104,7 @@ class AudioEncoderOpus final : public AudioEncoder {
 
  private:
   size_t Num10msFramesPerPacket() const;
+  int FrameSizeMs() const;
   size_t SamplesPer10msFrame() const;
   size_t SufficientOutputBufferSize() const;
   bool RecreateEncoderInstance(const Config& config);
@@ -102,6 +114,12 @@ class AudioEncoderOpus final : public AudioEncoder {
   std::vector<int16_t> input_buffer_;
   OpusEncInst* inst_;
   uint32_t first_timestamp_in_buffer_;
+  // Smoothed encode time as a fraction of the packet duration.
+  float encode_load_;
+  // How far the CPU adaptation has lowered complexity and lengthened frames.
+  int adaptation_steps_;
+  // Audio encoded since |adaptation_steps_| last changed.
+  int ms_since_adaptation_;
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioEncoderOpus);
 };
 
@@ -150,4 +150,99 @@ TEST_F(AudioEncoderOpusTest, PacketLossRateOptimized) {
   // clang-format on
 }
 
+namespace {
+
+AudioEncoderOpus::Config CreateCpuAdaptationConfig(bool enabled) {
+  AudioEncoderOpus::Config config;
+  config.frame_size_ms = 20;
+  config.complexity = 9;
+  config.cpu_adaptation_enabled = enabled;
+  return config;
+}
+
+// Reports encode times of |load| times the packet duration for |duration_ms|
+// of audio.
+void ReportEncodeLoad(AudioEncoderOpus* encoder, float load, int duration_ms) {
+  for (int ms = 0; ms < duration_ms;) {
+    const int frame_size_ms =
+        static_cast<int>(encoder->Num10MsFramesInNextPacket()) * 10;
+    encoder->OnEncodeTime(static_cast<int64_t>(load * frame_size_ms * 1000));
+    ms += frame_size_ms;
+  }
+}
+
+}  // namespace
+
+TEST(AudioEncoderOpusCpuAdaptationTest, LowersComplexityThenLengthensFrames) {
+  AudioEncoderOpus encoder(CreateCpuAdaptationConfig(true));
+  EXPECT_EQ(6u, encoder.Max10MsFramesInAPacket());
+  EXPECT_EQ(9, encoder.complexity());
+  EXPECT_EQ(2u, encoder.Num10MsFramesInNextPacket());
+
+  const struct {
+    int complexity;
+    size_t num_10ms_frames;
+  } kSteps[] = {{7, 2}, {5, 2}, {3, 2}, {1, 2}, {1, 4}, {1, 6}, {1, 6}};
+  for (const auto& step : kSteps) {
+    ReportEncodeLoad(&encoder, 0.5f, 1000);
+    EXPECT_GT(encoder.encode_load(), 0.3f);
+    EXPECT_EQ(step.complexity, encoder.complexity());
+    EXPECT_EQ(step.num_10ms_frames, encoder.Num10MsFramesInNextPacket());
+  }
+}
+
+TEST(AudioEncoderOpusCpuAdaptationTest, RecoversWhenLoadDrops) {
+  AudioEncoderOpus encoder(CreateCpuAdaptationConfig(true));
+  ReportEncodeLoad(&encoder, 0.5f, 7000);
+  EXPECT_EQ(1, encoder.complexity());
+  EXPECT_EQ(6u, encoder.Num10MsFramesInNextPacket());
+
+  // Reconfiguring the encoder keeps the adaptation.
+  EXPECT_TRUE(encoder.SetDtx(true));
+  EXPECT_EQ(1, encoder.complexity());
+  EXPECT_EQ(6u, encoder.Num10MsFramesInNextPacket());
+
+  // A moderate load neither steps down nor up.
+  ReportEncodeLoad(&encoder, 0.2f, 20000);
+  EXPECT_EQ(1, encoder.complexity());
+  EXPECT_EQ(6u, encoder.Num10MsFramesInNextPacket());
+
+  // Once the load is low, the steps are undone in reverse order, one every
+  // 10 seconds.
+  ReportEncodeLoad(&encoder, 0.05f, 1000);
+  EXPECT_EQ(4u, encoder.Num10MsFramesInNextPacket());
+  ReportEncodeLoad(&encoder, 0.05f, 9000);
+  EXPECT_EQ(4u, encoder.Num10MsFramesInNextPacket());
+  ReportEncodeLoad(&encoder, 0.05f, 1000);
+  EXPECT_EQ(2u, encoder.Num10MsFramesInNextPacket());
+  EXPECT_EQ(1, encoder.complexity());
+  ReportEncodeLoad(&encoder, 0.05f, 50000);
+  EXPECT_EQ(9, encoder.complexity());
+  EXPECT_EQ(2u, encoder.Num10MsFramesInNextPacket());
+}
+
+TEST(AudioEncoderOpusCpuAdaptationTest, DisabledByDefault) {
+  EXPECT_FALSE(AudioEncoderOpus::Config().cpu_adaptation_enabled);
+  AudioEncoderOpus encoder(CreateCpuAdaptationConfig(false));
+  EXPECT_EQ(2u, encoder.Max10MsFramesInAPacket());
+  ReportEncodeLoad(&encoder, 0.9f, 10000);
+  EXPECT_EQ(9, encoder.complexity());
+  EXPECT_EQ(2u, encoder.Num10MsFramesInNextPacket());
+}
+
+TEST(AudioEncoderOpusCpuAdaptationTest, ToggledAtRuntime) {
+  AudioEncoderOpus encoder(CreateCpuAdaptationConfig(false));
+  EXPECT_TRUE(encoder.SetCpuAdaptation(true));
+  EXPECT_EQ(6u, encoder.Max10MsFramesInAPacket());
+  ReportEncodeLoad(&encoder, 0.5f, 7000);
+  EXPECT_EQ(1, encoder.complexity());
+  EXPECT_EQ(6u, encoder.Num10MsFramesInNextPacket());
+
+  // Disabling undoes all steps at once.
+  EXPECT_TRUE(encoder.SetCpuAdaptation(false));
+  EXPECT_EQ(9, encoder.complexity());
+  EXPECT_EQ(2u, encoder.Num10MsFramesInNextPacket());
+  EXPECT_EQ(2u, encoder.Max10MsFramesInAPacket());
+}
+
 }  // namespace webrtc
@@ -107,6 +107,10 @@ bool AudioEncoderCopyRed::SetDtx(bool enable) {
   return speech_encoder_->SetDtx(enable);
 }
 
+bool AudioEncoderCopyRed::SetCpuAdaptation(bool enable) {
+  return speech_encoder_->SetCpuAdaptation(enable);
+}
+
 bool AudioEncoderCopyRed::SetApplication(Application application) {
   return speech_encoder_->SetApplication(application);
 }
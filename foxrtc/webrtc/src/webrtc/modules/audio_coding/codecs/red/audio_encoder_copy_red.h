@@ -47,6 +47,7 @@ class AudioEncoderCopyRed final : public AudioEncoder {
   void Reset() override;
   bool SetFec(bool enable) override;
   bool SetDtx(bool enable) override;
+  bool SetCpuAdaptation(bool enable) override;
   bool SetApplication(Application application) override;
   void SetMaxPlaybackRate(int frequency_hz) override;
   void SetProjectedPacketLossRate(double fraction) override;
@@ -747,6 +747,21 @@ class AudioCodingModule {
   //
   virtual int DisableOpusDtx() = 0;
 
+  ///////////////////////////////////////////////////////////////////////////
+  // int SetOpusCpuAdaptation()
+  // If current send codec is Opus, enables or disables adapting its
+  // complexity and packet length to the time encoding takes.
+  //
+  // Input:
+  //   -enable                  : true to enable, false to disable.
+  //
+  // Return value:
+  //   -1 if current send codec is not Opus or error occurred in setting the
+  //      adaptation.
+  //    0 if the adaptation is set successfully.
+  //
+  virtual int SetOpusCpuAdaptation(bool enable) = 0;
+
   ///////////////////////////////////////////////////////////////////////////
   //   statistics
   //
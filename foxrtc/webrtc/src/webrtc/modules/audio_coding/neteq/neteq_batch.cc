@@ -0,0 +1,39 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_coding/neteq/neteq_batch.h"
+
+#include "webrtc/base/trace_event.h"
+#include "webrtc/modules/audio_coding/neteq/include/neteq.h"
+
+namespace webrtc {
+namespace {
+
+// GetAudio() takes 2 to 8 us on an instance decoding or concealing PCM.
+const size_t kMinInstancesPerThread = 4;
+
+}  // namespace
+
+NetEqBatch::NetEqBatch(int num_threads)
+    : batch_(num_threads, "NetEqBatchWorker", kMinInstancesPerThread) {}
+
+NetEqBatch::~NetEqBatch() {}
+
+void NetEqBatch::GetAudio() {
+  TRACE_EVENT1("webrtc", "NetEqBatch::GetAudio", "instances", batch_.size());
+  batch_.Run([this](size_t i) {
+    Output& output = batch_.state(i);
+    output.result =
+        batch_.member(i)->GetAudio(output.frame.get(), &output.muted);
+    return output.result == NetEq::kOK;
+  });
+}
+
+}  // namespace webrtc
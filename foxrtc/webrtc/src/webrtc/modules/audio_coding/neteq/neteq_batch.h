@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CODING_NETEQ_NETEQ_BATCH_H_
+#define WEBRTC_MODULES_AUDIO_CODING_NETEQ_NETEQ_BATCH_H_
+
+#include <memory>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/fork_join_batch.h"
+#include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+class NetEq;
+
+// Pulls 10 ms of audio from many NetEq instances in one call, for mixers that
+// serve many receive streams from one 10 ms tick. The output frame and return
+// value of every instance are kept, so that a mixer can walk the results of
+// the whole tick without touching the NetEq objects again.
+//
+// The instances are not owned. The class is not thread-safe; all methods
+// must be called on one thread.
+class NetEqBatch {
+ public:
+  explicit NetEqBatch(int num_threads);
+  ~NetEqBatch();
+
+  // See rtc::ForkJoinBatch for how indices change.
+  size_t AddInstance(NetEq* neteq) { return batch_.Add(neteq); }
+  bool RemoveInstance(NetEq* neteq) { return batch_.Remove(neteq); }
+  size_t num_instances() const { return batch_.size(); }
+
+  // Calls NetEq::GetAudio() once on every instance. The results stay
+  // available through the accessors below until the next call.
+  void GetAudio();
+
+  NetEq* instance(size_t index) const { return batch_.member(index); }
+  AudioFrame* frame(size_t index) { return batch_.state(index).frame.get(); }
+  bool muted(size_t index) const { return batch_.state(index).muted; }
+  int result(size_t index) const { return batch_.state(index).result; }
+  // Times NetEq::GetAudio(); errors are calls that did not return kOK.
+  const rtc::ForkJoinBatchStats& stats(size_t index) const {
+    return batch_.stats(index);
+  }
+  int64_t last_batch_us() const { return batch_.last_batch_us(); }
+
+ private:
+  struct Output {
+    Output() : frame(new AudioFrame()), muted(false), result(0) {}
+
+    std::unique_ptr<AudioFrame> frame;
+    bool muted;
+    int result;
+  };
+
+  rtc::ForkJoinBatch<NetEq, Output> batch_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(NetEqBatch);
+};
+
+}  // namespace webrtc
+#endif  // WEBRTC_MODULES_AUDIO_CODING_NETEQ_NETEQ_BATCH_H_
@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_coding/neteq/neteq_batch.h"
+
+#include <string.h>
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/modules/audio_coding/codecs/builtin_audio_decoder_factory.h"
+#include "webrtc/modules/audio_coding/neteq/include/neteq.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+const uint8_t kPayloadType = 17;
+const int kSampleRateHz = 8000;
+const size_t kPayloadLengthSamples = 80;  // 10 ms.
+
+std::unique_ptr<NetEq> CreateNetEq() {
+  NetEq::Config config;
+  std::unique_ptr<NetEq> neteq(
+      NetEq::Create(config, CreateBuiltinAudioDecoderFactory()));
+  EXPECT_EQ(NetEq::kOK, neteq->RegisterPayloadType(
+                            NetEqDecoder::kDecoderPCM16B, "", kPayloadType));
+  return neteq;
+}
+
+// Inserts |num_packets| 10 ms PCM16b packets into |neteq|. The content
+// depends on |stream| so that every stream decodes to different audio.
+void InsertPackets(NetEq* neteq, int stream, int num_packets) {
+  WebRtcRTPHeader rtp_header;
+  rtp_header.header.payloadType = kPayloadType;
+  rtp_header.header.ssrc = 0x1234 + stream;
+  for (int i = 0; i < num_packets; ++i) {
+    uint8_t payload[2 * kPayloadLengthSamples];
+    for (size_t j = 0; j < kPayloadLengthSamples; ++j) {
+      const int16_t sample = static_cast<int16_t>((stream + 1) * 100 + j);
+      payload[2 * j] = static_cast<uint8_t>(sample >> 8);  // Big endian.
+      payload[2 * j + 1] = static_cast<uint8_t>(sample);
+    }
+    rtp_header.header.sequenceNumber = i;
+    rtp_header.header.timestamp = i * kPayloadLengthSamples;
+    EXPECT_EQ(NetEq::kOK, neteq->InsertPacket(rtp_header, payload,
+                                              i * kPayloadLengthSamples));
+  }
+}
+
+}  // namespace
+
+// The batch, with or without threads, should give the same audio as calling
+// GetAudio() on every instance in turn.
+TEST(NetEqBatchTest, MatchesSerialGetAudio) {
+  const int kStreams = 17;
+  const int kPackets = 10;
+
+  for (int num_threads : {1, 4}) {
+    std::vector<std::unique_ptr<NetEq>> reference;
+    std::vector<std::unique_ptr<NetEq>> batched;
+    NetEqBatch batch(num_threads);
+    for (int i = 0; i < kStreams; ++i) {
+      reference.push_back(CreateNetEq());
+      batched.push_back(CreateNetEq());
+      InsertPackets(reference.back().get(), i, kPackets);
+      InsertPackets(batched.back().get(), i, kPackets);
+      batch.AddInstance(batched.back().get());
+    }
+
+    for (int tick = 0; tick < kPackets + 2; ++tick) {
+      batch.GetAudio();
+      for (int i = 0; i < kStreams; ++i) {
+        AudioFrame expected;
+        bool expected_muted;
+        ASSERT_EQ(NetEq::kOK,
+                  reference[i]->GetAudio(&expected, &expected_muted));
+        EXPECT_EQ(NetEq::kOK, batch.result(i));
+        EXPECT_EQ(expected_muted, batch.muted(i));
+        const AudioFrame* frame = batch.frame(i);
+        EXPECT_EQ(kSampleRateHz, frame->sample_rate_hz_);
+        ASSERT_EQ(expected.samples_per_channel_, frame->samples_per_channel_);
+        EXPECT_EQ(expected.speech_type_, frame->speech_type_);
+        EXPECT_EQ(0, memcmp(expected.data_, frame->data_,
+                            sizeof(int16_t) * frame->samples_per_channel_))
+            << "stream " << i << ", tick " << tick;
+      }
+    }
+  }
+}
+
+}  // namespace webrtc
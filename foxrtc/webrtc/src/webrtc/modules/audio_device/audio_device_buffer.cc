@@ -13,6 +13,7 @@
 #include "webrtc/modules/audio_device/audio_device_buffer.h"
 
 #include "webrtc/base/arraysize.h"
+#include "webrtc/base/atomicops.h"
 #include "webrtc/base/bind.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
@@ -31,6 +32,40 @@ static const size_t kTimerIntervalInSeconds = 10;
 static const size_t kTimerIntervalInMilliseconds =
     kTimerIntervalInSeconds * rtc::kNumMillisecsPerSec;
 
+namespace {
+
+void AtomicAdd(volatile int* value, int delta) {
+  int old_value = rtc::AtomicOps::AcquireLoad(value);
+  int previous;
+  while ((previous = rtc::AtomicOps::CompareAndSwap(
+              value, old_value, old_value + delta)) != old_value) {
+    old_value = previous;
+  }
+}
+
+void AtomicMax(volatile int* value, int candidate) {
+  int old_value = rtc::AtomicOps::AcquireLoad(value);
+  while (candidate > old_value) {
+    int previous = rtc::AtomicOps::CompareAndSwap(value, old_value, candidate);
+    if (previous == old_value)
+      return;
+    old_value = previous;
+  }
+}
+
+// Sets |*value| to zero and returns what it was.
+int AtomicTake(volatile int* value) {
+  int old_value = rtc::AtomicOps::AcquireLoad(value);
+  int previous;
+  while ((previous = rtc::AtomicOps::CompareAndSwap(value, old_value, 0)) !=
+         old_value) {
+    old_value = previous;
+  }
+  return old_value;
+}
+
+}  // namespace
+
 AudioDeviceBuffer::AudioDeviceBuffer()
     : audio_transport_cb_(nullptr),
       task_queue_(kTimerQueueName),
@@ -54,13 +89,11 @@ AudioDeviceBuffer::AudioDeviceBuffer()
       clock_drift_(0),
       num_stat_reports_(0),
       rec_callbacks_(0),
-      last_rec_callbacks_(0),
       play_callbacks_(0),
-      last_play_callbacks_(0),
-      rec_samples_(0),
-      last_rec_samples_(0),
-      play_samples_(0),
-      last_play_samples_(0),
+      new_rec_callbacks_(0),
+      new_rec_samples_(0),
+      new_play_callbacks_(0),
+      new_play_samples_(0),
       last_log_stat_time_(0),
       max_rec_level_(0),
       max_play_level_(0),
@@ -108,7 +141,8 @@ AudioDeviceBuffer::~AudioDeviceBuffer() {
 int32_t AudioDeviceBuffer::RegisterAudioCallback(
     AudioTransport* audio_callback) {
   LOG(INFO) << __FUNCTION__;
-  rtc::CritScope lock(&_critSectCb);
+  rtc::CritScope lock_rec(&lock_rec_);
+  rtc::CritScope lock_play(&lock_play_);
   audio_transport_cb_ = audio_callback;
   return 0;
 }
@@ -137,14 +171,14 @@ int32_t AudioDeviceBuffer::InitRecording() {
 
 int32_t AudioDeviceBuffer::SetRecordingSampleRate(uint32_t fsHz) {
   LOG(INFO) << "SetRecordingSampleRate(" << fsHz << ")";
-  rtc::CritScope lock(&_critSect);
+  rtc::CritScope lock(&lock_rec_);
   rec_sample_rate_ = fsHz;
   return 0;
 }
 
 int32_t AudioDeviceBuffer::SetPlayoutSampleRate(uint32_t fsHz) {
   LOG(INFO) << "SetPlayoutSampleRate(" << fsHz << ")";
-  rtc::CritScope lock(&_critSect);
+  rtc::CritScope lock(&lock_play_);
   play_sample_rate_ = fsHz;
   return 0;
 }
@@ -159,7 +193,7 @@ int32_t AudioDeviceBuffer::PlayoutSampleRate() const {
 
 int32_t AudioDeviceBuffer::SetRecordingChannels(size_t channels) {
   LOG(INFO) << "SetRecordingChannels(" << channels << ")";
-  rtc::CritScope lock(&_critSect);
+  rtc::CritScope lock(&lock_rec_);
   rec_channels_ = channels;
   rec_bytes_per_sample_ =
       2 * channels;  // 16 bits per sample in mono, 32 bits in stereo
@@ -168,7 +202,7 @@ int32_t AudioDeviceBuffer::SetRecordingChannels(size_t channels) {
 
 int32_t AudioDeviceBuffer::SetPlayoutChannels(size_t channels) {
   LOG(INFO) << "SetPlayoutChannels(" << channels << ")";
-  rtc::CritScope lock(&_critSect);
+  rtc::CritScope lock(&lock_play_);
   play_channels_ = channels;
   // 16 bits per sample in mono, 32 bits in stereo
   play_bytes_per_sample_ = 2 * channels;
@@ -177,7 +211,7 @@ int32_t AudioDeviceBuffer::SetPlayoutChannels(size_t channels) {
 
 int32_t AudioDeviceBuffer::SetRecordingChannel(
     const AudioDeviceModule::ChannelType channel) {
-  rtc::CritScope lock(&_critSect);
+  rtc::CritScope lock(&lock_rec_);
 
   if (rec_channels_ == 1) {
     return -1;
@@ -260,7 +294,7 @@ int32_t AudioDeviceBuffer::SetRecordedBuffer(const void* audio_buffer,
   // audio layer tries to deliver something else.
   RTC_CHECK_EQ(num_samples, rec_samples_per_10ms_);
 
-  rtc::CritScope lock(&_critSect);
+  rtc::CritScope lock(&lock_rec_);
 
   if (rec_channel_ == AudioDeviceModule::kChannelBoth) {
     // Copy the complete input buffer to the local buffer.
@@ -280,15 +314,12 @@ int32_t AudioDeviceBuffer::SetRecordedBuffer(const void* audio_buffer,
     }
   }
 
-  // Update some stats but do it on the task queue to ensure that the members
-  // are modified and read on the same thread.
-  task_queue_.PostTask(rtc::Bind(&AudioDeviceBuffer::UpdateRecStats, this,
-                                 audio_buffer, num_samples));
+  UpdateRecStats(audio_buffer, num_samples);
   return 0;
 }
 
 int32_t AudioDeviceBuffer::DeliverRecordedData() {
-  rtc::CritScope lock(&_critSectCb);
+  rtc::CritScope lock(&lock_rec_);
 
   if (!audio_transport_cb_) {
     LOG(LS_WARNING) << "Invalid audio transport";
@@ -328,7 +359,7 @@ int32_t AudioDeviceBuffer::RequestPlayoutData(size_t num_samples) {
   // audio layer asks for something else.
   RTC_CHECK_EQ(num_samples, play_samples_per_10ms_);
 
-  rtc::CritScope lock(&_critSectCb);
+  rtc::CritScope lock(&lock_play_);
 
   // It is currently supported to start playout without a valid audio
   // transport object. Leads to warning and silence.
@@ -349,22 +380,19 @@ int32_t AudioDeviceBuffer::RequestPlayoutData(size_t num_samples) {
     LOG(LS_ERROR) << "NeedMorePlayData() failed";
   }
 
-  // Update some stats but do it on the task queue to ensure that access of
-  // members is serialized hence avoiding usage of locks.
-  task_queue_.PostTask(rtc::Bind(&AudioDeviceBuffer::UpdatePlayStats, this,
-                                 &play_buffer_[0], num_samples_out));
+  UpdatePlayStats(&play_buffer_[0], num_samples_out);
   return static_cast<int32_t>(num_samples_out);
 }
 
 int32_t AudioDeviceBuffer::GetPlayoutData(void* audio_buffer) {
-  rtc::CritScope lock(&_critSect);
+  rtc::CritScope lock(&lock_play_);
   memcpy(audio_buffer, &play_buffer_[0], play_bytes_per_10ms_);
   return static_cast<int32_t>(play_samples_per_10ms_);
 }
 
 void AudioDeviceBuffer::UpdatePlayoutParameters() {
   RTC_CHECK(play_bytes_per_sample_);
-  rtc::CritScope lock(&_critSect);
+  rtc::CritScope lock(&lock_play_);
   // Update the required buffer size given sample rate and number of channels.
   play_samples_per_10ms_ = static_cast<size_t>(play_sample_rate_ * 10 / 1000);
   play_bytes_per_10ms_ = play_bytes_per_sample_ * play_samples_per_10ms_;
@@ -373,7 +401,7 @@ void AudioDeviceBuffer::UpdatePlayoutParameters() {
 
 void AudioDeviceBuffer::UpdateRecordingParameters() {
   RTC_CHECK(rec_bytes_per_sample_);
-  rtc::CritScope lock(&_critSect);
+  rtc::CritScope lock(&lock_rec_);
   // Update the required buffer size given sample rate and number of channels.
   rec_samples_per_10ms_ = static_cast<size_t>(rec_sample_rate_ * 10 / 1000);
   rec_bytes_per_10ms_ = rec_bytes_per_sample_ * rec_samples_per_10ms_;
@@ -395,44 +423,42 @@ void AudioDeviceBuffer::LogStats() {
   int64_t time_since_last = rtc::TimeDiff(now_time, last_log_stat_time_);
   last_log_stat_time_ = now_time;
 
+  const int rec_callbacks = AtomicTake(&new_rec_callbacks_);
+  const int rec_samples = AtomicTake(&new_rec_samples_);
+  const int max_rec_level = AtomicTake(&max_rec_level_);
+  const int play_callbacks = AtomicTake(&new_play_callbacks_);
+  const int play_samples = AtomicTake(&new_play_samples_);
+  const int max_play_level = AtomicTake(&max_play_level_);
+  rec_callbacks_ += rec_callbacks;
+  play_callbacks_ += play_callbacks;
+
   // Log the latest statistics but skip the first 10 seconds since we are not
   // sure of the exact starting point. I.e., the first log printout will be
   // after ~20 seconds.
   if (++num_stat_reports_ > 1 && time_since_last > 0) {
-    uint32_t diff_samples = rec_samples_ - last_rec_samples_;
-    float rate = diff_samples / (static_cast<float>(time_since_last) / 1000.0);
+    float rate = rec_samples / (static_cast<float>(time_since_last) / 1000.0);
     LOG(INFO) << "[REC : " << time_since_last << "msec, "
               << rec_sample_rate_ / 1000
-              << "kHz] callbacks: " << rec_callbacks_ - last_rec_callbacks_
-              << ", "
-              << "samples: " << diff_samples << ", "
+              << "kHz] callbacks: " << rec_callbacks << ", "
+              << "samples: " << rec_samples << ", "
               << "rate: " << static_cast<int>(rate + 0.5) << ", "
-              << "level: " << max_rec_level_;
+              << "level: " << max_rec_level;
 
-    diff_samples = play_samples_ - last_play_samples_;
-    rate = diff_samples / (static_cast<float>(time_since_last) / 1000.0);
+    rate = play_samples / (static_cast<float>(time_since_last) / 1000.0);
     LOG(INFO) << "[PLAY: " << time_since_last << "msec, "
               << play_sample_rate_ / 1000
-              << "kHz] callbacks: " << play_callbacks_ - last_play_callbacks_
-              << ", "
-              << "samples: " << diff_samples << ", "
+              << "kHz] callbacks: " << play_callbacks << ", "
+              << "samples: " << play_samples << ", "
               << "rate: " << static_cast<int>(rate + 0.5) << ", "
-              << "level: " << max_play_level_;
+              << "level: " << max_play_level;
   }
 
   // Count number of times we detect "no audio" corresponding to a case where
   // all level measurements have been zero.
-  if (max_rec_level_ == 0) {
+  if (max_rec_level == 0) {
     ++num_rec_level_is_zero_;
   }
 
-  last_rec_callbacks_ = rec_callbacks_;
-  last_play_callbacks_ = play_callbacks_;
-  last_rec_samples_ = rec_samples_;
-  last_play_samples_ = play_samples_;
-  max_rec_level_ = 0;
-  max_play_level_ = 0;
-
   int64_t time_to_wait_ms = next_callback_time - rtc::TimeMillis();
     if(time_to_wait_ms < 0) {
         time_to_wait_ms = rtc::TimeMillis() + 10;
@@ -447,55 +473,47 @@ void AudioDeviceBuffer::LogStats() {
 
 void AudioDeviceBuffer::ResetRecStats() {
   rec_callbacks_ = 0;
-  last_rec_callbacks_ = 0;
-  rec_samples_ = 0;
-  last_rec_samples_ = 0;
-  max_rec_level_ = 0;
+  AtomicTake(&new_rec_callbacks_);
+  AtomicTake(&new_rec_samples_);
+  AtomicTake(&max_rec_level_);
   num_rec_level_is_zero_ = 0;
 }
 
 void AudioDeviceBuffer::ResetPlayStats() {
   last_playout_time_ = rtc::TimeMillis();
   play_callbacks_ = 0;
-  last_play_callbacks_ = 0;
-  play_samples_ = 0;
-  last_play_samples_ = 0;
-  max_play_level_ = 0;
+  AtomicTake(&new_play_callbacks_);
+  AtomicTake(&new_play_samples_);
+  AtomicTake(&max_play_level_);
 }
 
 void AudioDeviceBuffer::UpdateRecStats(const void* audio_buffer,
                                        size_t num_samples) {
-  RTC_DCHECK(task_queue_.IsCurrent());
-  ++rec_callbacks_;
-  rec_samples_ += num_samples;
+  int callbacks = rtc::AtomicOps::Increment(&new_rec_callbacks_);
+  AtomicAdd(&new_rec_samples_, static_cast<int>(num_samples));
 
   // Find the max absolute value in an audio packet twice per second and update
   // |max_rec_level_| to track the largest value.
-  if (rec_callbacks_ % 50 == 0) {
+  if (callbacks % 50 == 0) {
     int16_t max_abs = WebRtcSpl_MaxAbsValueW16(
-        static_cast<int16_t*>(const_cast<void*>(audio_buffer)),
+        static_cast<const int16_t*>(audio_buffer),
         num_samples * rec_channels_);
-    if (max_abs > max_rec_level_) {
-      max_rec_level_ = max_abs;
-    }
+    AtomicMax(&max_rec_level_, max_abs);
   }
 }
 
 void AudioDeviceBuffer::UpdatePlayStats(const void* audio_buffer,
                                         size_t num_samples) {
-  RTC_DCHECK(task_queue_.IsCurrent());
-  ++play_callbacks_;
-  play_samples_ += num_samples;
+  int callbacks = rtc::AtomicOps::Increment(&new_play_callbacks_);
+  AtomicAdd(&new_play_samples_, static_cast<int>(num_samples));
 
   // Find the max absolute value in an audio packet twice per second and update
   // |max_play_level_| to track the largest value.
-  if (play_callbacks_ % 50 == 0) {
+  if (callbacks % 50 == 0) {
     int16_t max_abs = WebRtcSpl_MaxAbsValueW16(
-        static_cast<int16_t*>(const_cast<void*>(audio_buffer)),
+        static_cast<const int16_t*>(audio_buffer),
         num_samples * play_channels_);
-    if (max_abs > max_play_level_) {
-      max_play_level_ = max_abs;
-    }
+    AtomicMax(&max_play_level_, max_abs);
   }
 }
 
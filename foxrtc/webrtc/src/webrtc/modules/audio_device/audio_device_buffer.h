@@ -90,9 +90,9 @@ class AudioDeviceBuffer {
   void ResetRecStats();
   void ResetPlayStats();
 
-  // Updates counters in each play/record callback but does it on the task
-  // queue to ensure that they can be read by LogStats() without any locks since
-  // each task is serialized by the task queue.
+  // Updates counters in each play/record callback. Runs on the audio threads
+  // and only uses atomic operations, so that a callback never blocks on or
+  // allocates for the stats. LogStats() collects and clears the counters.
   void UpdateRecStats(const void* audio_buffer, size_t num_samples);
   void UpdatePlayStats(const void* audio_buffer, size_t num_samples);
 
@@ -104,10 +104,15 @@ class AudioDeviceBuffer {
   // and it must outlive this object.
   AudioTransport* audio_transport_cb_;
 
+  // Recording and playout callbacks run on different device threads, and each
+  // direction has its own lock for its parameters, buffer and callback. The
+  // recording thread runs the whole send side inside
+  // RecordedDataIsAvailable(), and with a shared lock every playout callback
+  // issued meanwhile had to wait for it. RegisterAudioCallback() takes both.
   // TODO(henrika): given usage of thread checker, it should be possible to
   // remove all locks in this class.
-  rtc::CriticalSection _critSect;
-  rtc::CriticalSection _critSectCb;
+  rtc::CriticalSection lock_rec_;
+  rtc::CriticalSection lock_play_;
 
   // Task queue used to invoke LogStats() periodically. Tasks are executed on a
   // worker thread but it does not necessarily have to be the same thread for
@@ -166,30 +171,19 @@ class AudioDeviceBuffer {
   size_t num_stat_reports_;
 
   // Total number of recording callbacks where the source provides 10ms audio
-  // data each time.
+  // data each time, as of the last timer task.
   uint64_t rec_callbacks_;
 
-  // Total number of recording callbacks stored at the last timer task.
-  uint64_t last_rec_callbacks_;
-
   // Total number of playback callbacks where the sink asks for 10ms audio
-  // data each time.
+  // data each time, as of the last timer task.
   uint64_t play_callbacks_;
 
-  // Total number of playout callbacks stored at the last timer task.
-  uint64_t last_play_callbacks_;
-
-  // Total number of recorded audio samples.
-  uint64_t rec_samples_;
-
-  // Total number of recorded samples stored at the previous timer task.
-  uint64_t last_rec_samples_;
-
-  // Total number of played audio samples.
-  uint64_t play_samples_;
-
-  // Total number of played samples stored at the previous timer task.
-  uint64_t last_play_samples_;
+  // Recording and playout callbacks and samples since the last timer task.
+  // Incremented atomically on the audio threads and cleared by LogStats().
+  volatile int new_rec_callbacks_;
+  volatile int new_rec_samples_;
+  volatile int new_play_callbacks_;
+  volatile int new_play_samples_;
 
   // Time stamp of last stat report.
   uint64_t last_log_stat_time_;
@@ -206,13 +200,13 @@ class AudioDeviceBuffer {
 
   // Contains max level (max(abs(x))) of recorded audio packets over the last
   // 10 seconds where a new measurement is done twice per second. The level
-  // is reset to zero at each call to LogStats(). Only modified on the task
-  // queue thread.
-  int16_t max_rec_level_;
+  // is raised atomically on the recording thread and reset to zero at each
+  // call to LogStats().
+  volatile int max_rec_level_;
 
   // Contains max level of recorded audio packets over the last 10 seconds
   // where a new measurement is done twice per second.
-  int16_t max_play_level_;
+  volatile int max_play_level_;
 
   // Counts number of times we detect "no audio" corresponding to a case where
   // all level measurements since the last log has been exactly zero.
@@ -13,6 +13,7 @@
 #include "webrtc/base/logging.h"
 #include "webrtc/modules/audio_device/audio_device_config.h"
 #include "webrtc/modules/audio_device/linux/audio_device_alsa_linux.h"
+#include "webrtc/modules/audio_device/linux/low_latency_linux.h"
 
 #include "webrtc/system_wrappers/include/event_wrapper.h"
 #include "webrtc/system_wrappers/include/sleep.h"
@@ -56,6 +57,16 @@ static const unsigned int ALSA_CAPTURE_CH = 2;
 static const unsigned int ALSA_CAPTURE_LATENCY = 40*1000; // in us
 static const unsigned int ALSA_CAPTURE_WAIT_TIMEOUT = 5; // in ms
 
+// snd_pcm_set_params() splits the requested latency into four periods. In low
+// latency mode the latency is chosen from the configured period instead. With
+// short periods the buffer has to hold more than four of them, which makes
+// the actual periods somewhat longer than configured.
+static unsigned int AlsaLatencyUs(unsigned int defaultLatencyUs)
+{
+    const int periodUs = LowLatencyPeriodUs();
+    return periodUs > 0 ? LowLatencyBufferUs(periodUs) : defaultLatencyUs;
+}
+
 #define FUNC_GET_NUM_OF_DEVICE 0
 #define FUNC_GET_DEVICE_NAME 1
 #define FUNC_GET_DEVICE_NAME_FOR_AN_ENUM 2
@@ -1097,7 +1108,7 @@ int32_t AudioDeviceLinuxALSA::InitPlayout()
         _playChannels, //channels
         _playoutFreq, //rate
         1, //soft_resample
-        ALSA_PLAYOUT_LATENCY //40*1000 //latency required overall latency in us
+        AlsaLatencyUs(ALSA_PLAYOUT_LATENCY) //overall latency in us
     )) < 0)
     {   /* 0.5sec */
         _playoutFramesIn10MS = 0;
@@ -1253,7 +1264,7 @@ int32_t AudioDeviceLinuxALSA::InitRecording()
         _recChannels, //channels
         _recordingFreq, //rate
         1, //soft_resample
-        ALSA_CAPTURE_LATENCY //latency in us
+        AlsaLatencyUs(ALSA_CAPTURE_LATENCY) //latency in us
     )) < 0)
     {
          // Fall back to another mode then.
@@ -1272,7 +1283,7 @@ int32_t AudioDeviceLinuxALSA::InitRecording()
              _recChannels, //channels
              _recordingFreq, //rate
              1, //soft_resample
-             ALSA_CAPTURE_LATENCY //latency in us
+             AlsaLatencyUs(ALSA_CAPTURE_LATENCY) //latency in us
          )) < 0)
          {
              _recordingFramesIn10MS = 0;
@@ -2053,7 +2064,6 @@ bool AudioDeviceLinuxALSA::RecThreadProcess()
     int err;
     snd_pcm_sframes_t frames;
     snd_pcm_sframes_t avail_frames;
-    int8_t buffer[_recordingBufferSizeIn10MS];
 
     Lock();
 
@@ -2085,8 +2095,12 @@ bool AudioDeviceLinuxALSA::RecThreadProcess()
     if (static_cast<uint32_t>(avail_frames) > _recordingFramesLeft)
         avail_frames = _recordingFramesLeft;
 
+    // Read straight into the 10 ms buffer, after what previous periods left.
+    int left_size = LATE(snd_pcm_frames_to_bytes)(_handleRecord,
+        _recordingFramesLeft);
     frames = LATE(snd_pcm_readi)(_handleRecord,
-        buffer, avail_frames); // frames to be written
+        &_recordingBuffer[_recordingBufferSizeIn10MS - left_size],
+        avail_frames); // frames to be written
     if (frames < 0)
     {
         WEBRTC_TRACE(kTraceError, kTraceAudioDevice, _id,
@@ -2099,13 +2113,6 @@ bool AudioDeviceLinuxALSA::RecThreadProcess()
     else if (frames > 0)
     {
         assert(frames == avail_frames);
-
-        int left_size = LATE(snd_pcm_frames_to_bytes)(_handleRecord,
-            _recordingFramesLeft);
-        int size = LATE(snd_pcm_frames_to_bytes)(_handleRecord, frames);
-
-        memcpy(&_recordingBuffer[_recordingBufferSizeIn10MS - left_size],
-               buffer, size);
         _recordingFramesLeft -= frames;
 
         if (!_recordingFramesLeft)
@@ -14,6 +14,7 @@
 #include "webrtc/base/logging.h"
 #include "webrtc/modules/audio_device/audio_device_config.h"
 #include "webrtc/modules/audio_device/linux/audio_device_pulse_linux.h"
+#include "webrtc/modules/audio_device/linux/low_latency_linux.h"
 #include "webrtc/system_wrappers/include/event_wrapper.h"
 #include "webrtc/system_wrappers/include/trace.h"
 
@@ -28,6 +29,12 @@ webrtc_adm_linux_pulse::PulseAudioSymbolTable PaSymbolTable;
 namespace webrtc
 {
 
+// Returns the number of bytes that |us| microseconds of audio take.
+static uint32_t PeriodBytes(size_t bytesPerSec, int us)
+{
+    return static_cast<uint32_t>(bytesPerSec / 1000 * us / 1000);
+}
+
 AudioDeviceLinuxPulse::AudioDeviceLinuxPulse(const int32_t id) :
     _ptrAudioBuffer(NULL),
     _critSect(*CriticalSectionWrapper::CreateCriticalSection()),
@@ -1179,6 +1186,13 @@ int32_t AudioDeviceLinuxPulse::InitPlayout()
         uint32_t latency = bytesPerSec *
                            WEBRTC_PA_PLAYBACK_LATENCY_MINIMUM_MSECS /
                            WEBRTC_PA_MSECS_PER_SEC;
+        // In low latency mode, buffer like ALSA does and rely on the
+        // underflow handler if that turns out to be too little.
+        const int periodUs = LowLatencyPeriodUs();
+        if (periodUs > 0)
+        {
+            latency = PeriodBytes(bytesPerSec, LowLatencyBufferUs(periodUs));
+        }
 
         // Set the play buffer attributes
         _playBufferAttr.maxlength = latency; // num bytes stored in the buffer
@@ -1294,6 +1308,12 @@ int32_t AudioDeviceLinuxPulse::InitRecording()
         size_t bytesPerSec = LATE(pa_bytes_per_second)(spec);
         uint32_t latency = bytesPerSec
             * WEBRTC_PA_LOW_CAPTURE_LATENCY_MSECS / WEBRTC_PA_MSECS_PER_SEC;
+        // In low latency mode, transfer one device period at a time.
+        const int periodUs = LowLatencyPeriodUs();
+        if (periodUs > 0)
+        {
+            latency = PeriodBytes(bytesPerSec, periodUs);
+        }
 
         // Set the rec buffer attributes
         // Note: fragsize specifies a maximum transfer size, not a minimum, so
@@ -2307,6 +2327,13 @@ void AudioDeviceLinuxPulse::PaStreamUnderflowCallbackHandler()
     uint32_t newLatency = _configuredLatencyPlay + bytesPerSec *
                           WEBRTC_PA_PLAYBACK_LATENCY_INCREMENT_MSECS /
                           WEBRTC_PA_MSECS_PER_SEC;
+    // In low latency mode, grow by one device period at a time instead.
+    const int periodUs = LowLatencyPeriodUs();
+    if (periodUs > 0)
+    {
+        newLatency = _configuredLatencyPlay +
+                     PeriodBytes(bytesPerSec, periodUs);
+    }
 
     // Set the play buffer attributes
     _playBufferAttr.maxlength = newLatency;
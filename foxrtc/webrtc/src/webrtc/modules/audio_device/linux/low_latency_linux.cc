@@ -0,0 +1,48 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_device/linux/low_latency_linux.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <string>
+
+#include "webrtc/system_wrappers/include/field_trial.h"
+
+namespace webrtc {
+
+namespace {
+const char kLowLatencyPeriodFieldTrial[] = "WebRTC-Audio-LowLatencyPeriod";
+const char kEnabledPrefix[] = "Enabled-";
+const int kChunkUs = 10000;
+}  // namespace
+
+int LowLatencyPeriodUs() {
+  const std::string group =
+      field_trial::FindFullName(kLowLatencyPeriodFieldTrial);
+  const size_t prefix_length = sizeof(kEnabledPrefix) - 1;
+  if (group.compare(0, prefix_length, kEnabledPrefix) != 0)
+    return 0;
+  float period_ms = 0.0f;
+  if (sscanf(group.c_str() + prefix_length, "%f", &period_ms) != 1 ||
+      period_ms <= 0.0f) {
+    return 0;
+  }
+  return std::min(std::max(static_cast<int>(period_ms * 1000 + 0.5f),
+                           kMinLowLatencyPeriodUs),
+                  kMaxLowLatencyPeriodUs);
+}
+
+int LowLatencyBufferUs(int period_us) {
+  return std::max(4 * period_us, kChunkUs + 2 * period_us);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,35 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_DEVICE_LINUX_LOW_LATENCY_LINUX_H_
+#define WEBRTC_MODULES_AUDIO_DEVICE_LINUX_LOW_LATENCY_LINUX_H_
+
+namespace webrtc {
+
+// Shortest and longest device period that the low latency mode accepts.
+const int kMinLowLatencyPeriodUs = 2500;
+const int kMaxLowLatencyPeriodUs = 10000;
+
+// Returns the device period in microseconds that the ALSA and PulseAudio
+// devices should run with, or 0 for their default buffering. The period is
+// set in milliseconds through the "WebRTC-Audio-LowLatencyPeriod" field
+// trial, e.g. "Enabled-2.5", and clamped to the range above. Audio is still
+// exchanged with the AudioDeviceBuffer in 10 ms chunks.
+int LowLatencyPeriodUs();
+
+// Returns the device buffer length in microseconds for |period_us|: four
+// periods, but at least one 10 ms chunk plus two periods. Otherwise every
+// 10 ms write would have to wait for a drained buffer, and a 10 ms read for a
+// full one.
+int LowLatencyBufferUs(int period_us);
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_DEVICE_LINUX_LOW_LATENCY_LINUX_H_
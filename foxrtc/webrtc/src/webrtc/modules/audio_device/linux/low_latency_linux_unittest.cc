@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_device/linux/low_latency_linux.h"
+#include "webrtc/test/field_trial.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+TEST(LowLatencyLinuxTest, DisabledByDefault) {
+  EXPECT_EQ(0, LowLatencyPeriodUs());
+}
+
+TEST(LowLatencyLinuxTest, ParsesPeriod) {
+  {
+    test::ScopedFieldTrials field_trials(
+        "WebRTC-Audio-LowLatencyPeriod/Enabled-2.5/");
+    EXPECT_EQ(2500, LowLatencyPeriodUs());
+  }
+  {
+    test::ScopedFieldTrials field_trials(
+        "WebRTC-Audio-LowLatencyPeriod/Enabled-5/");
+    EXPECT_EQ(5000, LowLatencyPeriodUs());
+  }
+}
+
+TEST(LowLatencyLinuxTest, ClampsPeriod) {
+  {
+    test::ScopedFieldTrials field_trials(
+        "WebRTC-Audio-LowLatencyPeriod/Enabled-1/");
+    EXPECT_EQ(kMinLowLatencyPeriodUs, LowLatencyPeriodUs());
+  }
+  {
+    test::ScopedFieldTrials field_trials(
+        "WebRTC-Audio-LowLatencyPeriod/Enabled-40/");
+    EXPECT_EQ(kMaxLowLatencyPeriodUs, LowLatencyPeriodUs());
+  }
+}
+
+TEST(LowLatencyLinuxTest, IgnoresInvalidGroups) {
+  {
+    test::ScopedFieldTrials field_trials(
+        "WebRTC-Audio-LowLatencyPeriod/Disabled/");
+    EXPECT_EQ(0, LowLatencyPeriodUs());
+  }
+  {
+    test::ScopedFieldTrials field_trials(
+        "WebRTC-Audio-LowLatencyPeriod/Enabled-fast/");
+    EXPECT_EQ(0, LowLatencyPeriodUs());
+  }
+}
+
+TEST(LowLatencyLinuxTest, BufferHoldsAChunkAndTwoPeriods) {
+  EXPECT_EQ(15000, LowLatencyBufferUs(kMinLowLatencyPeriodUs));
+  EXPECT_EQ(20000, LowLatencyBufferUs(5000));
+  EXPECT_EQ(40000, LowLatencyBufferUs(kMaxLowLatencyPeriodUs));
+}
+
+}  // namespace webrtc
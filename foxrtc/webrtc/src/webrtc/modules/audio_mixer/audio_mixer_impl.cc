@@ -133,20 +133,28 @@ int32_t MixFromList(AudioFrame* mixed_audio,
   return 0;
 }
 
+// A source decodes with NetEq and resamples to the mix rate, a few us for PCM.
+const size_t kMinAudioSourcesPerFetchThread = 4;
+
 }  // namespace
 
 std::unique_ptr<AudioMixer> AudioMixer::Create(int id) {
   return AudioMixerImpl::Create(id);
 }
 
-AudioMixerImpl::AudioMixerImpl(int id, std::unique_ptr<AudioProcessing> limiter)
+AudioMixerImpl::AudioMixerImpl(int id,
+                               std::unique_ptr<AudioProcessing> limiter,
+                               int num_fetch_threads)
     : id_(id),
       audio_source_list_(),
       additional_audio_source_list_(),
       num_mixed_audio_sources_(0),
       use_limiter_(true),
       time_stamp_(0),
-      limiter_(std::move(limiter)) {
+      limiter_(std::move(limiter)),
+      fetch_threads_(num_fetch_threads,
+                     "AudioMixerFetch",
+                     rtc::kRealtimePriority) {
   SetOutputFrequency(kDefaultFrequency);
   thread_checker_.DetachFromThread();
 }
@@ -154,6 +162,11 @@ AudioMixerImpl::AudioMixerImpl(int id, std::unique_ptr<AudioProcessing> limiter)
 AudioMixerImpl::~AudioMixerImpl() {}
 
 std::unique_ptr<AudioMixer> AudioMixerImpl::Create(int id) {
+  return Create(id, 1);
+}
+
+std::unique_ptr<AudioMixer> AudioMixerImpl::Create(int id,
+                                                   int num_fetch_threads) {
   Config config;
   config.Set<ExperimentalAgc>(new ExperimentalAgc(false));
   std::unique_ptr<AudioProcessing> limiter(AudioProcessing::Create(config));
@@ -180,7 +193,7 @@ std::unique_ptr<AudioMixer> AudioMixerImpl::Create(int id) {
     return nullptr;
 
   return std::unique_ptr<AudioMixer>(
-      new AudioMixerImpl(id, std::move(limiter)));
+      new AudioMixerImpl(id, std::move(limiter), num_fetch_threads));
 }
 
 void AudioMixerImpl::Mix(int sample_rate,
@@ -353,9 +366,11 @@ AudioFrameList AudioMixerImpl::GetNonAnonymousAudio() const {
   std::vector<SourceFrame> ramp_list;
 
   // Get audio source audio and put it in the struct vector.
-  for (auto* const audio_source : audio_source_list_) {
-    auto audio_frame_with_info = audio_source->GetAudioFrameWithMuted(
-        id_, static_cast<int>(OutputFrequency()));
+  const std::vector<MixerAudioSource::AudioFrameWithMuted> audio_frames =
+      GetAudioFromSources(audio_source_list_);
+  for (size_t i = 0; i < audio_source_list_.size(); ++i) {
+    MixerAudioSource* const audio_source = audio_source_list_[i];
+    const auto& audio_frame_with_info = audio_frames[i];
 
     const auto audio_frame_info = audio_frame_with_info.audio_frame_info;
     AudioFrame* audio_source_audio_frame = audio_frame_with_info.audio_frame;
@@ -416,9 +431,11 @@ AudioFrameList AudioMixerImpl::GetAnonymousAudio() const {
                                        additional_audio_source_list_.begin(),
                                        additional_audio_source_list_.end());
 
-  for (const auto& audio_source : additional_audio_sources_list) {
-    const auto audio_frame_with_info =
-        audio_source->GetAudioFrameWithMuted(id_, OutputFrequency());
+  const std::vector<MixerAudioSource::AudioFrameWithMuted> audio_frames =
+      GetAudioFromSources(additional_audio_sources_list);
+  for (size_t i = 0; i < additional_audio_sources_list.size(); ++i) {
+    MixerAudioSource* const audio_source = additional_audio_sources_list[i];
+    const auto& audio_frame_with_info = audio_frames[i];
     const auto ret = audio_frame_with_info.audio_frame_info;
     AudioFrame* audio_frame = audio_frame_with_info.audio_frame;
     if (ret == MixerAudioSource::AudioFrameInfo::kError) {
@@ -437,6 +454,23 @@ AudioFrameList AudioMixerImpl::GetAnonymousAudio() const {
   return result;
 }
 
+std::vector<MixerAudioSource::AudioFrameWithMuted>
+AudioMixerImpl::GetAudioFromSources(
+    const MixerAudioSourceList& audio_sources) const {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  const int sample_rate = static_cast<int>(OutputFrequency());
+  const size_t count = audio_sources.size();
+  std::vector<MixerAudioSource::AudioFrameWithMuted> audio_frames(count);
+  fetch_threads_.RunRanges(
+      count, kMinAudioSourcesPerFetchThread, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          audio_frames[i] =
+              audio_sources[i]->GetAudioFrameWithMuted(id_, sample_rate);
+        }
+      });
+  return audio_frames;
+}
+
 bool AudioMixerImpl::IsAudioSourceInList(
     const MixerAudioSource& audio_source,
     const MixerAudioSourceList& audio_source_list) const {
@@ -15,6 +15,7 @@
 #include <memory>
 #include <vector>
 
+#include "webrtc/base/fork_join_threads.h"
 #include "webrtc/base/thread_annotations.h"
 #include "webrtc/base/thread_checker.h"
 #include "webrtc/engine_configurations.h"
@@ -37,6 +38,13 @@ class AudioMixerImpl : public AudioMixer {
 
   static std::unique_ptr<AudioMixer> Create(int id);
 
+  // Asks the audio sources for audio on up to |num_fetch_threads| threads,
+  // the mixing thread being one of them, so that the decoding behind
+  // GetAudioFrameWithMuted() is spread over several cores. With more than one
+  // thread, audio sources must be safe to call from any thread and must not
+  // call back into the mixer from GetAudioFrameWithMuted().
+  static std::unique_ptr<AudioMixer> Create(int id, int num_fetch_threads);
+
   ~AudioMixerImpl() override;
 
   // AudioMixer functions
@@ -52,7 +60,14 @@ class AudioMixerImpl : public AudioMixer {
       const MixerAudioSource& audio_source) const override;
 
  private:
-  AudioMixerImpl(int id, std::unique_ptr<AudioProcessing> limiter);
+  AudioMixerImpl(int id,
+                 std::unique_ptr<AudioProcessing> limiter,
+                 int num_fetch_threads);
+
+  // Calls GetAudioFrameWithMuted() on all |audio_sources|, on the fetch
+  // threads if there are enough sources to share.
+  std::vector<MixerAudioSource::AudioFrameWithMuted> GetAudioFromSources(
+      const MixerAudioSourceList& audio_sources) const;
 
   // Set/get mix frequency
   int32_t SetOutputFrequency(const Frequency& frequency);
@@ -116,6 +131,10 @@ class AudioMixerImpl : public AudioMixer {
   // Measures audio level for the combined signal.
   voe::AudioLevel audio_level_ ACCESS_ON(&thread_checker_);
 
+  // Share the GetAudioFrameWithMuted() calls of a mix with the mixing thread.
+  // Mutable since fetching audio doesn't change the mixer.
+  mutable rtc::ForkJoinThreads fetch_threads_ ACCESS_ON(&thread_checker_);
+
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioMixerImpl);
 };
 }  // namespace webrtc
@@ -17,6 +17,7 @@
 #include "webrtc/base/thread.h"
 #include "webrtc/modules/audio_mixer/audio_mixer.h"
 #include "webrtc/modules/audio_mixer/audio_mixer_defines.h"
+#include "webrtc/modules/audio_mixer/audio_mixer_impl.h"
 #include "webrtc/test/gmock.h"
 
 using testing::_;
@@ -505,4 +506,51 @@ TEST(AudioMixer, UnmutedShouldMixBeforeLoud) {
 
   MixAndCompare(frames, frame_info, expected_status);
 }
+
+// Fetching audio on several threads should not change what is mixed.
+TEST(AudioMixer, FetchThreadsGiveTheSameMix) {
+  constexpr int kAudioSources = 13;
+  constexpr int kAnonymous = 5;
+
+  const std::unique_ptr<AudioMixer> single_mixer(AudioMixerImpl::Create(kId));
+  const std::unique_ptr<AudioMixer> threaded_mixer(
+      AudioMixerImpl::Create(kId, 3));
+  MockMixerAudioSource single[kAudioSources];
+  MockMixerAudioSource threaded[kAudioSources];
+
+  for (int i = 0; i < kAudioSources; i++) {
+    for (MockMixerAudioSource* participant : {&single[i], &threaded[i]}) {
+      ResetFrame(participant->fake_frame());
+      for (size_t j = 0; j < kDefaultSampleRateHz / 100; j++)
+        participant->fake_frame()->data_[j] = (i * 37 + j) % 1000;
+      if (i % 4 == 0)
+        participant->set_fake_info(MixerAudioSource::AudioFrameInfo::kMuted);
+      EXPECT_CALL(*participant, GetAudioFrameWithMuted(_, kDefaultSampleRateHz))
+          .Times(Exactly(2));
+    }
+    EXPECT_EQ(0, single_mixer->SetMixabilityStatus(&single[i], true));
+    EXPECT_EQ(0, threaded_mixer->SetMixabilityStatus(&threaded[i], true));
+    if (i < kAnonymous) {
+      EXPECT_EQ(0,
+                single_mixer->SetAnonymousMixabilityStatus(&single[i], true));
+      EXPECT_EQ(0, threaded_mixer->SetAnonymousMixabilityStatus(&threaded[i],
+                                                                 true));
+    }
+  }
+
+  AudioFrame single_frame;
+  AudioFrame threaded_frame;
+  for (int i = 0; i < 2; i++) {
+    single_mixer->Mix(kDefaultSampleRateHz, 1, &single_frame);
+    threaded_mixer->Mix(kDefaultSampleRateHz, 1, &threaded_frame);
+    ASSERT_EQ(single_frame.samples_per_channel_,
+              threaded_frame.samples_per_channel_);
+    EXPECT_EQ(0, memcmp(single_frame.data_, threaded_frame.data_,
+                        sizeof(int16_t) * single_frame.samples_per_channel_));
+    for (int j = 0; j < kAudioSources; j++) {
+      EXPECT_EQ(single[j].IsMixed(), threaded[j].IsMixed())
+          << "Mixed status of AudioSource #" << j << " differs.";
+    }
+  }
+}
 }  // namespace webrtc
@@ -451,8 +451,7 @@ void AudioBuffer::InterleaveTo(AudioFrame* frame, bool data_changed) {
 
 void AudioBuffer::CopyLowPassToReference() {
   reference_copied_ = true;
-  if (!low_pass_reference_channels_.get() ||
-      low_pass_reference_channels_->num_channels() != num_channels_) {
+  if (!low_pass_reference_channels_.get()) {
     low_pass_reference_channels_.reset(
         new ChannelBuffer<int16_t>(num_split_frames_,
                                    num_proc_channels_));
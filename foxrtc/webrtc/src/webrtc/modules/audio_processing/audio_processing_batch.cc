@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_processing/audio_processing_batch.h"
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/trace_event.h"
+#include "webrtc/modules/audio_processing/include/audio_processing.h"
+
+namespace webrtc {
+namespace {
+
+// A stream takes in the order of 100 us per tick with the default desktop
+// settings, so two are plenty to make a thread worth waking.
+const size_t kMinStreamsPerThread = 2;
+
+}  // namespace
+
+AudioProcessingBatch::AudioProcessingBatch(int num_threads)
+    : batch_(num_threads, "AudioProcessingBatchWorker", kMinStreamsPerThread) {}
+
+AudioProcessingBatch::~AudioProcessingBatch() {}
+
+void AudioProcessingBatch::ProcessStreams(AudioFrame* const* capture_frames,
+                                          AudioFrame* const* render_frames) {
+  TRACE_EVENT1("webrtc", "AudioProcessingBatch::ProcessStreams", "streams",
+               batch_.size());
+  RTC_DCHECK(capture_frames || batch_.size() == 0);
+  batch_.Run([this, capture_frames, render_frames](size_t i) {
+    AudioProcessing* apm = batch_.member(i);
+    int result = AudioProcessing::kNoError;
+    if (render_frames && render_frames[i])
+      result = apm->ProcessReverseStream(render_frames[i]);
+    const int capture_result = apm->ProcessStream(capture_frames[i]);
+    if (result == AudioProcessing::kNoError)
+      result = capture_result;
+    batch_.state(i).result = result;
+    return result == AudioProcessing::kNoError;
+  });
+}
+
+}  // namespace webrtc
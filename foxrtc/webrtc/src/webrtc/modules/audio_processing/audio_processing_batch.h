@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_PROCESSING_AUDIO_PROCESSING_BATCH_H_
+#define WEBRTC_MODULES_AUDIO_PROCESSING_AUDIO_PROCESSING_BATCH_H_
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/fork_join_batch.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+class AudioFrame;
+class AudioProcessing;
+
+// Processes 10 ms of many independent streams, each with its own
+// AudioProcessing instance, in one call. This is meant for servers that clean
+// up the audio of many calls at once, e.g. the legs of a PSTN bridge.
+//
+// The instances are not owned, and are used from other threads only during
+// ProcessStreams(), so they may be configured between calls, e.g. to set the
+// stream delay. The class is not thread-safe; all methods must be called on
+// one thread.
+class AudioProcessingBatch {
+ public:
+  explicit AudioProcessingBatch(int num_threads);
+  ~AudioProcessingBatch();
+
+  // See rtc::ForkJoinBatch for how indices change.
+  size_t AddStream(AudioProcessing* apm) { return batch_.Add(apm); }
+  bool RemoveStream(AudioProcessing* apm) { return batch_.Remove(apm); }
+  size_t num_streams() const { return batch_.size(); }
+
+  // For every stream i, passes |render_frames[i]| to ProcessReverseStream(),
+  // unless |render_frames| or the entry is null, and then |capture_frames[i]|
+  // to ProcessStream(). Both arrays are indexed like the streams.
+  void ProcessStreams(AudioFrame* const* capture_frames,
+                      AudioFrame* const* render_frames);
+
+  AudioProcessing* stream(size_t index) const { return batch_.member(index); }
+  // The first error of the last tick, or kNoError.
+  int result(size_t index) const { return batch_.state(index).result; }
+  // Times both calls of a tick; errors are ticks that did not return
+  // kNoError.
+  const rtc::ForkJoinBatchStats& stats(size_t index) const {
+    return batch_.stats(index);
+  }
+  int64_t last_batch_us() const { return batch_.last_batch_us(); }
+
+ private:
+  struct Output {
+    int result = 0;
+  };
+
+  rtc::ForkJoinBatch<AudioProcessing, Output> batch_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(AudioProcessingBatch);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_PROCESSING_AUDIO_PROCESSING_BATCH_H_
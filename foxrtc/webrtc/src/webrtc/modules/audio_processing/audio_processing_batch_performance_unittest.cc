@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_processing/audio_processing_batch.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/random.h"
+#include "webrtc/modules/audio_processing/include/audio_processing.h"
+#include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+const size_t kNumFramesToProcess = 300;
+const int kNumStreams = 32;
+
+// Measures how many streams one core can keep up with in real time, when
+// |num_threads| threads share |kNumStreams| streams with the settings of a
+// PSTN bridge leg: echo cancellation, noise suppression, AGC and high-pass.
+void RunBatch(int sample_rate_hz, int num_threads) {
+  const size_t samples_per_channel = sample_rate_hz / 100;
+  std::vector<std::unique_ptr<AudioProcessing>> apms;
+  AudioProcessingBatch batch(num_threads);
+  for (int i = 0; i < kNumStreams; ++i) {
+    apms.emplace_back(AudioProcessing::Create());
+    AudioProcessing* apm = apms.back().get();
+    ASSERT_EQ(AudioProcessing::kNoError,
+              apm->echo_cancellation()->Enable(true));
+    ASSERT_EQ(AudioProcessing::kNoError, apm->gain_control()->Enable(true));
+    ASSERT_EQ(AudioProcessing::kNoError,
+              apm->high_pass_filter()->Enable(true));
+    ASSERT_EQ(AudioProcessing::kNoError,
+              apm->noise_suppression()->Enable(true));
+    batch.AddStream(apm);
+  }
+
+  Random random(42);
+  std::vector<AudioFrame> capture(kNumStreams);
+  std::vector<AudioFrame> render(kNumStreams);
+  std::vector<AudioFrame*> capture_ptrs;
+  std::vector<AudioFrame*> render_ptrs;
+  for (int i = 0; i < kNumStreams; ++i) {
+    for (AudioFrame* frame : {&capture[i], &render[i]}) {
+      frame->sample_rate_hz_ = sample_rate_hz;
+      frame->samples_per_channel_ = samples_per_channel;
+      frame->num_channels_ = 1;
+    }
+    capture_ptrs.push_back(&capture[i]);
+    render_ptrs.push_back(&render[i]);
+  }
+
+  int64_t total_us = 0;
+  for (size_t frame_no = 0; frame_no < kNumFramesToProcess; ++frame_no) {
+    for (int i = 0; i < kNumStreams; ++i) {
+      for (size_t j = 0; j < samples_per_channel; ++j) {
+        capture[i].data_[j] = static_cast<int16_t>(random.Rand(-8000, 8000));
+        render[i].data_[j] = static_cast<int16_t>(random.Rand(-8000, 8000));
+      }
+      ASSERT_EQ(AudioProcessing::kNoError, apms[i]->set_stream_delay_ms(0));
+    }
+    batch.ProcessStreams(capture_ptrs.data(), render_ptrs.data());
+    total_us += batch.last_batch_us();
+  }
+  for (int i = 0; i < kNumStreams; ++i)
+    EXPECT_EQ(AudioProcessing::kNoError, batch.result(i));
+
+  // Each tick covers 10 ms of audio.
+  const int64_t average_us =
+      total_us / static_cast<int64_t>(kNumFramesToProcess);
+  const size_t streams_per_core =
+      average_us > 0 ? kNumStreams * 10000 / (average_us * num_threads) : 0;
+  const std::string modifier = "_" + std::to_string(sample_rate_hz) + "Hz_" +
+                               std::to_string(num_threads) + "_threads";
+  webrtc::test::PrintResult("apm_batch_tick_duration", modifier,
+                            "AudioProcessingBatch",
+                            static_cast<size_t>(average_us), "us", false);
+  webrtc::test::PrintResult("apm_batch_streams_per_core", modifier,
+                            "AudioProcessingBatch", streams_per_core,
+                            "streams", true);
+}
+
+}  // namespace
+
+TEST(AudioProcessingBatchPerformanceTest, StreamsPerCore) {
+  for (int sample_rate_hz : {8000, 16000}) {
+    for (int num_threads : {1, 2, 4}) {
+      SCOPED_TRACE(num_threads);
+      RunBatch(sample_rate_hz, num_threads);
+    }
+  }
+}
+
+}  // namespace webrtc
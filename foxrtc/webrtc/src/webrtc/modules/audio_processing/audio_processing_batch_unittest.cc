@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_processing/audio_processing_batch.h"
+
+#include <string.h>
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/random.h"
+#include "webrtc/modules/audio_processing/include/audio_processing.h"
+#include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+const int kSampleRateHz = 16000;
+const size_t kSamplesPerChannel = kSampleRateHz / 100;
+
+std::unique_ptr<AudioProcessing> CreateApm() {
+  std::unique_ptr<AudioProcessing> apm(AudioProcessing::Create());
+  EXPECT_EQ(AudioProcessing::kNoError,
+            apm->echo_cancellation()->Enable(true));
+  EXPECT_EQ(AudioProcessing::kNoError, apm->gain_control()->Enable(true));
+  EXPECT_EQ(AudioProcessing::kNoError, apm->high_pass_filter()->Enable(true));
+  EXPECT_EQ(AudioProcessing::kNoError,
+            apm->noise_suppression()->Enable(true));
+  return apm;
+}
+
+void FillFrame(Random* random, AudioFrame* frame) {
+  frame->sample_rate_hz_ = kSampleRateHz;
+  frame->samples_per_channel_ = kSamplesPerChannel;
+  frame->num_channels_ = 1;
+  for (size_t i = 0; i < kSamplesPerChannel; ++i)
+    frame->data_[i] = static_cast<int16_t>(random->Rand(-10000, 10000));
+}
+
+}  // namespace
+
+// The batch, with or without threads, should give the same audio as
+// processing every stream in turn.
+TEST(AudioProcessingBatchTest, MatchesSerialProcessing) {
+  const int kStreams = 9;
+  const int kFrames = 20;
+
+  for (int num_threads : {1, 3}) {
+    std::vector<std::unique_ptr<AudioProcessing>> reference;
+    std::vector<std::unique_ptr<AudioProcessing>> batched;
+    AudioProcessingBatch batch(num_threads);
+    for (int i = 0; i < kStreams; ++i) {
+      reference.push_back(CreateApm());
+      batched.push_back(CreateApm());
+      batch.AddStream(batched.back().get());
+    }
+
+    Random random(42);
+    std::vector<AudioFrame> capture(kStreams);
+    std::vector<AudioFrame> render(kStreams);
+    std::vector<AudioFrame*> capture_ptrs;
+    std::vector<AudioFrame*> render_ptrs;
+    for (int i = 0; i < kStreams; ++i) {
+      capture_ptrs.push_back(&capture[i]);
+      // Leave out the render side of every third stream.
+      render_ptrs.push_back(i % 3 == 0 ? nullptr : &render[i]);
+    }
+
+    for (int frame = 0; frame < kFrames; ++frame) {
+      std::vector<AudioFrame> expected(kStreams);
+      for (int i = 0; i < kStreams; ++i) {
+        FillFrame(&random, &capture[i]);
+        FillFrame(&random, &render[i]);
+        expected[i].CopyFrom(capture[i]);
+        if (render_ptrs[i]) {
+          AudioFrame render_copy;
+          render_copy.CopyFrom(render[i]);
+          ASSERT_EQ(AudioProcessing::kNoError,
+                    reference[i]->ProcessReverseStream(&render_copy));
+        }
+        ASSERT_EQ(AudioProcessing::kNoError,
+                  reference[i]->set_stream_delay_ms(0));
+        ASSERT_EQ(AudioProcessing::kNoError,
+                  reference[i]->ProcessStream(&expected[i]));
+        ASSERT_EQ(AudioProcessing::kNoError,
+                  batched[i]->set_stream_delay_ms(0));
+      }
+
+      batch.ProcessStreams(capture_ptrs.data(), render_ptrs.data());
+      for (int i = 0; i < kStreams; ++i) {
+        EXPECT_EQ(AudioProcessing::kNoError, batch.result(i));
+        EXPECT_EQ(0, memcmp(expected[i].data_, capture[i].data_,
+                            sizeof(int16_t) * kSamplesPerChannel))
+            << "stream " << i << ", frame " << frame;
+      }
+    }
+  }
+}
+
+TEST(AudioProcessingBatchTest, ReportsErrors) {
+  std::unique_ptr<AudioProcessing> apm(AudioProcessing::Create());
+  AudioProcessingBatch batch(1);
+  batch.AddStream(apm.get());
+
+  AudioFrame frame;
+  frame.sample_rate_hz_ = 12345;  // Not supported.
+  frame.samples_per_channel_ = 123;
+  frame.num_channels_ = 1;
+  AudioFrame* frames[] = {&frame};
+  batch.ProcessStreams(frames, nullptr);
+
+  EXPECT_NE(AudioProcessing::kNoError, batch.result(0));
+  EXPECT_EQ(1u, batch.stats(0).errors);
+}
+
+}  // namespace webrtc
@@ -60,21 +60,11 @@ DelayBasedBwe::Result DelayBasedBwe::IncomingPacketFeedbackVector(
                               BweNames::kBweNamesMax);
     uma_recorded_ = true;
   }
-  Result aggregated_result;
-  for (const auto& packet_info : packet_feedback_vector) {
-    Result result = IncomingPacketInfo(packet_info);
-    if (result.updated)
-      aggregated_result = result;
-  }
-  return aggregated_result;
-}
-
-DelayBasedBwe::Result DelayBasedBwe::IncomingPacketInfo(
-    const PacketInfo& info) {
+  if (packet_feedback_vector.empty())
+    return Result();
+  // The whole vector comes from a single feedback message, so the clock and
+  // the stream timeout only need to be looked at once rather than per packet.
   int64_t now_ms = clock_->TimeInMilliseconds();
-
-  incoming_bitrate_.Update(info.payload_size, info.arrival_time_ms);
-  Result result;
   // Reset if the stream has timed out.
   if (last_seen_packet_ms_ == -1 ||
       now_ms - last_seen_packet_ms_ > kStreamTimeOutMs) {
@@ -85,6 +75,20 @@ DelayBasedBwe::Result DelayBasedBwe::IncomingPacketInfo(
   }
   last_seen_packet_ms_ = now_ms;
 
+  Result aggregated_result;
+  for (const auto& packet_info : packet_feedback_vector) {
+    Result result = IncomingPacketInfo(packet_info, now_ms);
+    if (result.updated)
+      aggregated_result = result;
+  }
+  return aggregated_result;
+}
+
+DelayBasedBwe::Result DelayBasedBwe::IncomingPacketInfo(const PacketInfo& info,
+                                                        int64_t now_ms) {
+  incoming_bitrate_.Update(info.payload_size, info.arrival_time_ms);
+  Result result;
+
   uint32_t send_time_24bits =
       static_cast<uint32_t>(
           ((static_cast<uint64_t>(info.send_time_ms) << kAbsSendTimeFraction) +
@@ -129,8 +133,6 @@ DelayBasedBwe::Result DelayBasedBwe::IncomingPacketInfo(
     result.updated = UpdateEstimate(info.arrival_time_ms, now_ms,
                                     &result.target_bitrate_bps);
   }
-  rtc::Optional<uint32_t> incoming_rate =
-      incoming_bitrate_.Rate(info.arrival_time_ms);
   if (!result.updated &&
       (last_update_ms_ == -1 ||
        now_ms - last_update_ms_ > remote_rate_.GetFeedbackInterval())) {
@@ -73,7 +73,7 @@ void TransportFeedbackAdapter::SetMinBitrate(int min_bitrate_bps) {
   delay_based_bwe_->SetMinBitrate(min_bitrate_bps);
 }
 
-std::vector<PacketInfo> TransportFeedbackAdapter::GetPacketFeedbackVector(
+void TransportFeedbackAdapter::UpdatePacketFeedbackVector(
     const rtcp::TransportFeedback& feedback) {
   int64_t timestamp_us = feedback.GetBaseTimeUs();
   // Add timestamp deltas to a local time base selected on first packet arrival.
@@ -96,31 +96,41 @@ std::vector<PacketInfo> TransportFeedbackAdapter::GetPacketFeedbackVector(
   last_timestamp_us_ = timestamp_us;
 
   uint16_t sequence_number = feedback.GetBaseSequence();
-  std::vector<int64_t> delta_vec = feedback.GetReceiveDeltasUs();
+  const std::vector<int16_t>& delta_vec = feedback.receive_deltas();
   auto delta_it = delta_vec.begin();
-  std::vector<PacketInfo> packet_feedback_vector;
+  std::vector<PacketInfo>& packet_feedback_vector =
+      last_packet_feedback_vector_;
+  packet_feedback_vector.clear();
   packet_feedback_vector.reserve(delta_vec.size());
+  feedback.GetStatusVector(&status_vector_);
 
   {
     rtc::CritScope cs(&lock_);
     size_t failed_lookups = 0;
     int64_t offset_us = 0;
-    for (auto symbol : feedback.GetStatusVector()) {
+    for (auto symbol : status_vector_) {
       if (symbol != rtcp::TransportFeedback::StatusSymbol::kNotReceived) {
         RTC_DCHECK(delta_it != delta_vec.end());
-        offset_us += *(delta_it++);
+        offset_us += static_cast<int64_t>(*(delta_it++)) *
+                     rtcp::TransportFeedback::kDeltaScaleFactor;
         int64_t timestamp_ms = current_offset_ms_ + (offset_us / 1000);
-        PacketInfo info(timestamp_ms, sequence_number);
-        if (send_time_history_.GetInfo(&info, true) && info.send_time_ms >= 0) {
-          packet_feedback_vector.push_back(info);
-        } else {
+        packet_feedback_vector.emplace_back(timestamp_ms, sequence_number);
+        if (!send_time_history_.GetInfo(&packet_feedback_vector.back(),
+                                        true) ||
+            packet_feedback_vector.back().send_time_ms < 0) {
+          packet_feedback_vector.pop_back();
           ++failed_lookups;
         }
       }
       ++sequence_number;
     }
-    std::sort(packet_feedback_vector.begin(), packet_feedback_vector.end(),
-              PacketInfoComparator());
+    // Feedback is in sequence number order, which matches arrival order
+    // unless the network reordered packets; skip the sort in that case.
+    if (!std::is_sorted(packet_feedback_vector.begin(),
+                        packet_feedback_vector.end(), PacketInfoComparator())) {
+      std::sort(packet_feedback_vector.begin(), packet_feedback_vector.end(),
+                PacketInfoComparator());
+    }
     RTC_DCHECK(delta_it == delta_vec.end());
     if (failed_lookups > 0) {
       LOG(LS_WARNING) << "Failed to lookup send time for " << failed_lookups
@@ -128,12 +138,11 @@ std::vector<PacketInfo> TransportFeedbackAdapter::GetPacketFeedbackVector(
                       << ". Send time history too small?";
     }
   }
-  return packet_feedback_vector;
 }
 
 void TransportFeedbackAdapter::OnTransportFeedback(
     const rtcp::TransportFeedback& feedback) {
-  last_packet_feedback_vector_ = GetPacketFeedbackVector(feedback);
+  UpdatePacketFeedbackVector(feedback);
   DelayBasedBwe::Result result;
   {
     rtc::CritScope cs(&bwe_lock_);
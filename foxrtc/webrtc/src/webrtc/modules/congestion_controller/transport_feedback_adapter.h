@@ -20,6 +20,7 @@
 #include "webrtc/modules/congestion_controller/delay_based_bwe.h"
 #include "webrtc/modules/include/module_common_types.h"
 #include "webrtc/modules/remote_bitrate_estimator/include/send_time_history.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 
 namespace webrtc {
 
@@ -51,8 +52,10 @@ class TransportFeedbackAdapter : public TransportFeedbackObserver,
   void SetMinBitrate(int min_bitrate_bps);
 
  private:
-  std::vector<PacketInfo> GetPacketFeedbackVector(
-      const rtcp::TransportFeedback& feedback);
+  // Fills |last_packet_feedback_vector_| in place; its capacity, like that
+  // of |status_vector_|, is kept across calls so that steady state feedback
+  // processing doesn't allocate.
+  void UpdatePacketFeedbackVector(const rtcp::TransportFeedback& feedback);
 
   rtc::CriticalSection lock_;
   rtc::CriticalSection bwe_lock_;
@@ -63,6 +66,7 @@ class TransportFeedbackAdapter : public TransportFeedbackObserver,
   int64_t last_timestamp_us_;
   BitrateController* const bitrate_controller_;
   std::vector<PacketInfo> last_packet_feedback_vector_;
+  std::vector<rtcp::TransportFeedback::StatusSymbol> status_vector_;
 };
 
 }  // namespace webrtc
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/buffer.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/bitrate_controller/include/mock/mock_bitrate_controller.h"
+#include "webrtc/modules/congestion_controller/transport_feedback_adapter.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gmock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+// Roughly a 50 Mbps screen share with 1200 byte packets and feedback every
+// 100 ms, i.e. ~520 packets per feedback message.
+constexpr int kPacketsPerFeedback = 520;
+constexpr int kNumFeedbacks = 2000;
+constexpr size_t kPacketSize = 1200;
+constexpr int64_t kFeedbackIntervalMs = 100;
+
+class FakeBitrateController : public test::MockBitrateController {
+ public:
+  void OnDelayBasedBweResult(const DelayBasedBwe::Result& result) override {}
+};
+
+// Sends |kPacketsPerFeedback| packets, builds and parses the matching
+// feedback, and times only TransportFeedbackAdapter::OnTransportFeedback.
+// Every |loss_period|th packet is reported as lost and, when |reorder| is
+// set, adjacent pairs arrive swapped so that the adapter has to sort.
+void RunFeedbackBenchmark(int loss_period, bool reorder,
+                          const std::string& trace) {
+  SimulatedClock clock(0);
+  ::testing::NiceMock<FakeBitrateController> bitrate_controller;
+  TransportFeedbackAdapter adapter(&clock, &bitrate_controller);
+  adapter.InitBwe();
+
+  uint16_t sequence_number = 0;
+  int64_t arrival_time_us = 1000000;
+  int64_t total_time_ns = 0;
+  for (int i = 0; i < kNumFeedbacks; ++i) {
+    const uint16_t base_sequence_number = sequence_number;
+    for (int j = 0; j < kPacketsPerFeedback; ++j) {
+      adapter.AddPacket(sequence_number, kPacketSize, PacketInfo::kNotAProbe);
+      adapter.OnSentPacket(sequence_number, clock.TimeInMilliseconds());
+      ++sequence_number;
+    }
+
+    rtcp::TransportFeedback feedback;
+    feedback.SetBase(base_sequence_number, arrival_time_us);
+    const int64_t step_us =
+        kFeedbackIntervalMs * 1000 / kPacketsPerFeedback;
+    for (int j = 0; j < kPacketsPerFeedback; ++j) {
+      int64_t packet_arrival_us = arrival_time_us + j * step_us;
+      if (reorder)
+        packet_arrival_us += (j % 2 == 0) ? step_us : -step_us;
+      if (loss_period > 0 && j % loss_period == 0)
+        continue;
+      feedback.AddReceivedPacket(
+          static_cast<uint16_t>(base_sequence_number + j),
+          packet_arrival_us);
+    }
+    rtc::Buffer raw_packet = feedback.Build();
+    std::unique_ptr<rtcp::TransportFeedback> parsed =
+        rtcp::TransportFeedback::ParseFrom(raw_packet.data(),
+                                           raw_packet.size());
+    ASSERT_TRUE(parsed);
+
+    int64_t start_ns = rtc::TimeNanos();
+    adapter.OnTransportFeedback(*parsed);
+    total_time_ns += rtc::TimeNanos() - start_ns;
+
+    clock.AdvanceTimeMilliseconds(kFeedbackIntervalMs);
+    arrival_time_us += kFeedbackIntervalMs * 1000;
+  }
+
+  webrtc::test::PrintResult(
+      "transport_feedback_adapter", "", trace,
+      static_cast<size_t>(total_time_ns / kNumFeedbacks), "ns/feedback",
+      true);
+}
+
+}  // namespace
+
+TEST(TransportFeedbackAdapterPerformanceTest, InOrder) {
+  RunFeedbackBenchmark(0, false, "520_packets_in_order");
+}
+
+TEST(TransportFeedbackAdapterPerformanceTest, LossAndReordering) {
+  RunFeedbackBenchmark(20, true, "520_packets_5_pl_reordered");
+}
+
+}  // namespace webrtc
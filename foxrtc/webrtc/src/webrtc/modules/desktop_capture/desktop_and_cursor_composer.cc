@@ -62,8 +62,12 @@ class DesktopFrameWithCursor : public DesktopFrame {
                          const DesktopVector& position);
   virtual ~DesktopFrameWithCursor();
 
+  // Part of the frame covered by the cursor, empty if it is off the frame.
+  const DesktopRect& cursor_rect() const { return cursor_rect_; }
+
  private:
   std::unique_ptr<DesktopFrame> original_frame_;
+  DesktopRect cursor_rect_;
 
   DesktopVector restore_position_;
   std::unique_ptr<DesktopFrame> restore_frame_;
@@ -92,6 +96,7 @@ DesktopFrameWithCursor::DesktopFrameWithCursor(
 
   if (target_rect.is_empty())
     return;
+  cursor_rect_ = target_rect;
 
   // Copy original screen content under cursor to |restore_frame_|.
   restore_position_ = target_rect.top_left();
@@ -128,7 +133,8 @@ DesktopAndCursorComposer::DesktopAndCursorComposer(
     DesktopCapturer* desktop_capturer,
     MouseCursorMonitor* mouse_monitor)
     : desktop_capturer_(desktop_capturer),
-      mouse_monitor_(mouse_monitor) {
+      mouse_monitor_(mouse_monitor),
+      cursor_changed_(false) {
 }
 
 DesktopAndCursorComposer::~DesktopAndCursorComposer() {}
@@ -158,9 +164,27 @@ void DesktopAndCursorComposer::SetExcludedWindow(WindowId window) {
 void DesktopAndCursorComposer::OnCaptureResult(
     DesktopCapturer::Result result,
     std::unique_ptr<DesktopFrame> frame) {
-  if (frame && cursor_ && cursor_state_ == MouseCursorMonitor::INSIDE) {
-    frame = std::unique_ptr<DesktopFrameWithCursor>(new DesktopFrameWithCursor(
-        std::move(frame), *cursor_, cursor_position_));
+  if (frame) {
+    DesktopRect cursor_rect;
+    if (cursor_ && cursor_state_ == MouseCursorMonitor::INSIDE) {
+      std::unique_ptr<DesktopFrameWithCursor> frame_with_cursor(
+          new DesktopFrameWithCursor(std::move(frame), *cursor_,
+                                     cursor_position_));
+      cursor_rect = frame_with_cursor->cursor_rect();
+      frame = std::move(frame_with_cursor);
+    }
+
+    // The capturer only reports changes of the screen content, so a moving or
+    // changing cursor is added to the updated region here, both where it was
+    // and where it is now.
+    if (cursor_changed_ || !cursor_rect.equals(previous_cursor_rect_)) {
+      DesktopRect previous_cursor_rect = previous_cursor_rect_;
+      previous_cursor_rect.IntersectWith(DesktopRect::MakeSize(frame->size()));
+      frame->mutable_updated_region()->AddRect(previous_cursor_rect);
+      frame->mutable_updated_region()->AddRect(cursor_rect);
+      previous_cursor_rect_ = cursor_rect;
+      cursor_changed_ = false;
+    }
   }
 
   callback_->OnCaptureResult(result, std::move(frame));
@@ -168,6 +192,7 @@ void DesktopAndCursorComposer::OnCaptureResult(
 
 void DesktopAndCursorComposer::OnMouseCursor(MouseCursor* cursor) {
   cursor_.reset(cursor);
+  cursor_changed_ = true;
 }
 
 void DesktopAndCursorComposer::OnMouseCursorPosition(
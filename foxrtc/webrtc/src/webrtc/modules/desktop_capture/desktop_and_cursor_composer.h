@@ -15,6 +15,7 @@
 
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/modules/desktop_capture/desktop_capturer.h"
+#include "webrtc/modules/desktop_capture/desktop_geometry.h"
 #include "webrtc/modules/desktop_capture/mouse_cursor_monitor.h"
 
 namespace webrtc {
@@ -58,6 +59,10 @@ class DesktopAndCursorComposer : public DesktopCapturer,
   std::unique_ptr<MouseCursor> cursor_;
   MouseCursorMonitor::CursorState cursor_state_;
   DesktopVector cursor_position_;
+  // Set when the cursor shape changes until the next frame is delivered.
+  bool cursor_changed_;
+  // Where the cursor was drawn into the last frame.
+  DesktopRect previous_cursor_rect_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(DesktopAndCursorComposer);
 };
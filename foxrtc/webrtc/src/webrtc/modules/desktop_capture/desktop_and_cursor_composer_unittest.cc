@@ -126,6 +126,7 @@ class FakeMouseMonitor : public MouseCursorMonitor {
       }
 
       callback_->OnMouseCursor(new MouseCursor(image.release(), hotspot_));
+      changed_ = false;
     }
 
     callback_->OnMouseCursorPosition(state_, position_);
@@ -248,6 +249,54 @@ TEST_F(DesktopAndCursorComposerTest, Blend) {
   }
 }
 
+// A moving cursor has to show up in the updated region even though the screen
+// underneath did not change.
+TEST_F(DesktopAndCursorComposerTest, CursorMoveUpdatesRegion) {
+  blender_.Start(this);
+  fake_cursor_->SetHotspot(DesktopVector());
+
+  struct {
+    int x, y;
+    bool inside;
+    // Expected to be repainted: the new position and, unless negative, the
+    // old one.
+    bool new_updated;
+    int old_x, old_y;
+  } tests[] = {
+    // The cursor is drawn for the first time.
+    {10, 10, true, true, -1, -1},
+    // Moved, both the old and the new position need to be repainted.
+    {30, 10, true, true, 10, 10},
+    // Not moved, nothing to repaint.
+    {30, 10, true, false, -1, -1},
+    // Left the screen, only the old position needs to be repainted.
+    {0, 0, false, false, 30, 10},
+  };
+
+  for (size_t i = 0; i < (sizeof(tests) / sizeof(tests[0])); ++i) {
+    SCOPED_TRACE(i);
+    fake_cursor_->SetState(tests[i].inside ? MouseCursorMonitor::INSIDE
+                                           : MouseCursorMonitor::OUTSIDE,
+                           DesktopVector(tests[i].x, tests[i].y));
+    fake_screen_->SetNextFrame(
+        std::unique_ptr<DesktopFrame>(CreateTestFrame()));
+
+    blender_.Capture(DesktopRegion());
+
+    ASSERT_TRUE(frame_);
+    DesktopRegion expected;
+    if (tests[i].new_updated) {
+      expected.AddRect(DesktopRect::MakeXYWH(tests[i].x, tests[i].y,
+                                             kCursorWidth, kCursorHeight));
+    }
+    if (tests[i].old_x >= 0) {
+      expected.AddRect(DesktopRect::MakeXYWH(tests[i].old_x, tests[i].old_y,
+                                             kCursorWidth, kCursorHeight));
+    }
+    EXPECT_TRUE(expected.Equals(frame_->updated_region()));
+  }
+}
+
 }  // namespace
 
 }  // namespace webrtc
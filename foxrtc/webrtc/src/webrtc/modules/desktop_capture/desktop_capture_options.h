@@ -82,6 +82,13 @@ class DesktopCaptureOptions {
     detect_updated_region_ = detect_updated_region;
   }
 
+  // Number of threads used to detect the updated region of large frames, see
+  // detect_updated_region().
+  int differ_threads() const { return differ_threads_; }
+  void set_differ_threads(int differ_threads) {
+    differ_threads_ = differ_threads;
+  }
+
 #if defined(WEBRTC_WIN)
   bool allow_use_magnification_api() const {
     return allow_use_magnification_api_;
@@ -121,6 +128,7 @@ class DesktopCaptureOptions {
 #endif
   bool disable_effects_ = true;
   bool detect_updated_region_ = false;
+  int differ_threads_ = 1;
 };
 
 }  // namespace webrtc
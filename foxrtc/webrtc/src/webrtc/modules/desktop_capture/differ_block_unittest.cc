@@ -71,6 +71,21 @@ TEST(BlockDifferenceTestMid, BlockDifference) {
   }
 }
 
+TEST(BlockDifferenceTestEveryByte, BlockDifference) {
+  uint8_t* block1;
+  uint8_t* block2;
+  PrepareBuffers(block1, block2);
+
+  // A difference in any byte of a row has to be found, whichever lane of the
+  // vector code it lands in.
+  for (int i = 0; i < kBlockSize * kBytesPerPixel; ++i) {
+    block2[i] += 1;
+    EXPECT_TRUE(VectorDifference(block1, block2)) << "at " << i;
+    block2[i] -= 1;
+  }
+  EXPECT_FALSE(VectorDifference(block1, block2));
+}
+
 TEST(BlockDifferenceTestFirst, BlockDifference) {
   uint8_t* block1;
   uint8_t* block2;
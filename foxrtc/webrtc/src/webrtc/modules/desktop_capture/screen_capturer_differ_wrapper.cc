@@ -141,11 +141,37 @@ void CompareFrames(const DesktopFrame& old_frame,
              old_frame.stride(), output);
 }
 
+// Below this many pixels, waking the other threads costs more than comparing
+// on the capturer thread alone. Roughly a 720p frame.
+const int kMinPixelsPerThread = 1280 * 720 / 2;
+
+// Splits |rect| into at most |count| horizontal bands. All but the last band
+// are a multiple of kBlockSize high, so that the blocks compared are the same
+// as without splitting.
+std::vector<DesktopRect> SplitIntoBands(const DesktopRect& rect, int count) {
+  const int y_block_count = (rect.height() + kBlockSize - 1) / kBlockSize;
+  const int band_height =
+      (y_block_count + count - 1) / count * kBlockSize;
+  std::vector<DesktopRect> bands;
+  for (int top = rect.top(); top < rect.bottom(); top += band_height) {
+    bands.push_back(DesktopRect::MakeLTRB(
+        rect.left(), top, rect.right(),
+        std::min(top + band_height, rect.bottom())));
+  }
+  return bands;
+}
+
 }  // namespace
 
 ScreenCapturerDifferWrapper::ScreenCapturerDifferWrapper(
     std::unique_ptr<ScreenCapturer> base_capturer)
-    : base_capturer_(std::move(base_capturer)) {
+    : ScreenCapturerDifferWrapper(std::move(base_capturer), 1) {}
+
+ScreenCapturerDifferWrapper::ScreenCapturerDifferWrapper(
+    std::unique_ptr<ScreenCapturer> base_capturer,
+    int num_threads)
+    : base_capturer_(std::move(base_capturer)),
+      differ_threads_(num_threads, "DifferThread", rtc::kHighPriority) {
   RTC_DCHECK(base_capturer_);
 }
 
@@ -195,10 +221,14 @@ void ScreenCapturerDifferWrapper::OnCaptureResult(
   if (last_frame_) {
     DesktopRegion hints;
     hints.Swap(frame->GetUnderlyingFrame()->mutable_updated_region());
+    std::vector<DesktopRect> rects;
     for (DesktopRegion::Iterator it(hints); !it.IsAtEnd(); it.Advance()) {
-      CompareFrames(*last_frame_, *frame, it.rect(),
-                    frame->mutable_updated_region());
+      DesktopRect rect = it.rect();
+      rect.IntersectWith(DesktopRect::MakeSize(frame->size()));
+      if (!rect.is_empty())
+        rects.push_back(rect);
     }
+    CompareRects(*frame, rects, frame->mutable_updated_region());
   } else {
     frame->mutable_updated_region()->SetRect(
         DesktopRect::MakeSize(frame->size()));
@@ -211,4 +241,39 @@ void ScreenCapturerDifferWrapper::OnCaptureResult(
   callback_->OnCaptureResult(result, std::move(frame));
 }
 
+void ScreenCapturerDifferWrapper::CompareRects(
+    const DesktopFrame& frame,
+    const std::vector<DesktopRect>& rects,
+    DesktopRegion* output) {
+  int64_t pixels = 0;
+  for (const DesktopRect& rect : rects)
+    pixels += static_cast<int64_t>(rect.width()) * rect.height();
+  const int num_threads = static_cast<int>(std::min<int64_t>(
+      differ_threads_.num_threads(), pixels / kMinPixelsPerThread));
+  if (num_threads <= 1) {
+    for (const DesktopRect& rect : rects)
+      CompareFrames(*last_frame_, frame, rect, output);
+    return;
+  }
+
+  // Every thread gets a band of every rect, so that one large rect is shared
+  // as evenly as many small ones.
+  std::vector<std::vector<DesktopRect>> shares(num_threads);
+  for (const DesktopRect& rect : rects) {
+    std::vector<DesktopRect> bands = SplitIntoBands(rect, num_threads);
+    for (size_t i = 0; i < bands.size(); ++i)
+      shares[i].push_back(bands[i]);
+  }
+  // The calling thread adds to |output| directly, the others to a region of
+  // their own.
+  std::vector<DesktopRegion> regions(num_threads - 1);
+  differ_threads_.Run(num_threads, [&](size_t i) {
+    DesktopRegion* region = i == 0 ? output : &regions[i - 1];
+    for (const DesktopRect& rect : shares[i])
+      CompareFrames(*last_frame_, frame, rect, region);
+  });
+  for (const DesktopRegion& region : regions)
+    output->AddRegion(region);
+}
+
 }  // namespace webrtc
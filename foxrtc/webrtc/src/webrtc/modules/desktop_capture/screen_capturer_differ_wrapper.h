@@ -12,7 +12,9 @@
 #define WEBRTC_MODULES_DESKTOP_CAPTURE_SCREEN_CAPTURER_DIFFER_WRAPPER_H_
 
 #include <memory>
+#include <vector>
 
+#include "webrtc/base/fork_join_threads.h"
 #include "webrtc/modules/desktop_capture/screen_capturer.h"
 #include "webrtc/modules/desktop_capture/shared_desktop_frame.h"
 
@@ -26,6 +28,9 @@ namespace webrtc {
 //
 // This class marks entire frame as updated if the frame size or frame stride
 // has been changed.
+//
+// Large updated areas are split into horizontal bands which are compared on
+// |num_threads| threads, the capturer thread being one of them.
 class ScreenCapturerDifferWrapper : public ScreenCapturer,
                                     public DesktopCapturer::Callback {
  public:
@@ -33,6 +38,8 @@ class ScreenCapturerDifferWrapper : public ScreenCapturer,
   // and takes its ownership.
   explicit ScreenCapturerDifferWrapper(
       std::unique_ptr<ScreenCapturer> base_capturer);
+  ScreenCapturerDifferWrapper(std::unique_ptr<ScreenCapturer> base_capturer,
+                              int num_threads);
   ~ScreenCapturerDifferWrapper() override;
 
   // ScreenCapturer interface.
@@ -48,7 +55,14 @@ class ScreenCapturerDifferWrapper : public ScreenCapturer,
   void OnCaptureResult(Result result,
                        std::unique_ptr<DesktopFrame> frame) override;
 
+  // Compares |rects| of |last_frame_| and |frame|, and adds the differences
+  // to |output|.
+  void CompareRects(const DesktopFrame& frame,
+                    const std::vector<DesktopRect>& rects,
+                    DesktopRegion* output);
+
   const std::unique_ptr<ScreenCapturer> base_capturer_;
+  rtc::ForkJoinThreads differ_threads_;
   DesktopCapturer::Callback* callback_;
   std::unique_ptr<SharedDesktopFrame> last_frame_;
 };
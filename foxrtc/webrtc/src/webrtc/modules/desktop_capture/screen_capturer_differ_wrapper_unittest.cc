@@ -153,7 +153,8 @@ void ExecuteCapturer(ScreenCapturerDifferWrapper* capturer,
 void ExecuteDifferWrapperTest(bool with_hints,
                               bool enlarge_updated_region,
                               bool random_updated_region,
-                              bool check_result) {
+                              bool check_result,
+                              int num_threads = 1) {
   const bool updated_region_should_exactly_match =
       with_hints && !enlarge_updated_region && !random_updated_region;
   BlackWhiteDesktopFramePainter frame_painter;
@@ -161,7 +162,7 @@ void ExecuteDifferWrapperTest(bool with_hints,
   frame_generator.set_desktop_frame_painter(&frame_painter);
   std::unique_ptr<FakeScreenCapturer> fake(new FakeScreenCapturer());
   fake->set_frame_generator(&frame_generator);
-  ScreenCapturerDifferWrapper capturer(std::move(fake));
+  ScreenCapturerDifferWrapper capturer(std::move(fake), num_threads);
   MockScreenCapturerCallback callback;
   frame_generator.set_provide_updated_region_hints(with_hints);
   frame_generator.set_enlarge_updated_region(enlarge_updated_region);
@@ -244,6 +245,15 @@ TEST(ScreenCapturerDifferWrapperTest, CaptureWithEnlargedAndRandomHints) {
   ExecuteDifferWrapperTest(true, true, true, true);
 }
 
+TEST(ScreenCapturerDifferWrapperTest, CaptureWithoutHintsMultiThreaded) {
+  ExecuteDifferWrapperTest(false, false, false, true, 4);
+}
+
+TEST(ScreenCapturerDifferWrapperTest,
+     CaptureWithEnlargedAndRandomHintsMultiThreaded) {
+  ExecuteDifferWrapperTest(true, true, true, true, 4);
+}
+
 // When hints are provided, ScreenCapturerDifferWrapper has a slightly better
 // performance in current configuration, but not so significant. Following is
 // one run result.
@@ -288,4 +298,11 @@ TEST(ScreenCapturerDifferWrapperTest,
   ASSERT_LE(rtc::TimeMillis() - started, 15000);
 }
 
+TEST(ScreenCapturerDifferWrapperTest,
+     DISABLED_CaptureWithoutHintsMultiThreadedPerf) {
+  int64_t started = rtc::TimeMillis();
+  ExecuteDifferWrapperTest(false, false, false, false, 4);
+  ASSERT_LE(rtc::TimeMillis() - started, 15000);
+}
+
 }  // namespace webrtc
@@ -418,7 +418,8 @@ ScreenCapturer* ScreenCapturer::Create(const DesktopCaptureOptions& options) {
   }
 
   if (options.detect_updated_region()) {
-    capturer.reset(new ScreenCapturerDifferWrapper(std::move(capturer)));
+    capturer.reset(new ScreenCapturerDifferWrapper(std::move(capturer),
+                                                   options.differ_threads()));
   }
 
   return capturer.release();
@@ -11,16 +11,21 @@
 #ifndef WEBRTC_MODULES_REMOTE_BITRATE_ESTIMATOR_INCLUDE_SEND_TIME_HISTORY_H_
 #define WEBRTC_MODULES_REMOTE_BITRATE_ESTIMATOR_INCLUDE_SEND_TIME_HISTORY_H_
 
-#include <map>
+#include <limits>
+#include <vector>
 
 #include "webrtc/base/basictypes.h"
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 
 namespace webrtc {
 class Clock;
-struct PacketInfo;
 
+// History of sent packets keyed by transport-wide sequence number. Entries
+// live in a ring indexed by the unwrapped sequence number, so lookups are
+// O(1) and nothing is allocated per packet; the ring only grows (by
+// doubling) when more packets than fit are in flight within the age limit.
 class SendTimeHistory {
  public:
   SendTimeHistory(Clock* clock, int64_t packet_age_limit_ms);
@@ -43,10 +48,30 @@ class SendTimeHistory {
   bool GetInfo(PacketInfo* packet_info, bool remove);
 
  private:
+  struct Entry {
+    Entry() : unwrapped_seq_num(kEmpty), info(-1, 0) {}
+    // Outside any range an unwrapper produces, so the ring doesn't depend on
+    // unwrapped sequence numbers staying non-negative.
+    static constexpr int64_t kEmpty = std::numeric_limits<int64_t>::min();
+    int64_t unwrapped_seq_num;
+    PacketInfo info;
+  };
+
+  Entry* Find(int64_t unwrapped_seq_num);
+  void Erase(Entry* entry);
+  // Drops entries from the oldest end until |unwrapped_seq_num| fits.
+  bool MakeRoomFor(int64_t unwrapped_seq_num);
+  void Grow();
+
   Clock* const clock_;
   const int64_t packet_age_limit_ms_;
   SequenceNumberUnwrapper seq_num_unwrapper_;
-  std::map<int64_t, PacketInfo> history_;
+  // Size is a power of two; an entry is stored at
+  // |unwrapped_seq_num & (history_.size() - 1)|.
+  std::vector<Entry> history_;
+  // Unwrapped range [oldest_seq_num_, end_seq_num_) that may hold entries.
+  int64_t oldest_seq_num_;
+  int64_t end_seq_num_;
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(SendTimeHistory);
 };
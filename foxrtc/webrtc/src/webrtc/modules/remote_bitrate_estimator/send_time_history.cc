@@ -10,51 +10,72 @@
 
 #include "webrtc/modules/remote_bitrate_estimator/include/send_time_history.h"
 
+#include <algorithm>
+
 #include "webrtc/base/checks.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "webrtc/system_wrappers/include/clock.h"
 
 namespace webrtc {
 
+namespace {
+// Must be powers of two. The maximum is half the 16 bit sequence number
+// space; anything older than that can't be unwrapped unambiguously anyway.
+constexpr size_t kInitialHistorySize = 1 << 10;
+constexpr size_t kMaxHistorySize = 1 << 15;
+}  // namespace
+
 SendTimeHistory::SendTimeHistory(Clock* clock, int64_t packet_age_limit_ms)
-    : clock_(clock), packet_age_limit_ms_(packet_age_limit_ms) {}
+    : clock_(clock),
+      packet_age_limit_ms_(packet_age_limit_ms),
+      history_(kInitialHistorySize),
+      oldest_seq_num_(0),
+      end_seq_num_(0) {}
 
 SendTimeHistory::~SendTimeHistory() {}
 
 void SendTimeHistory::Clear() {
-  history_.clear();
+  for (Entry& entry : history_)
+    entry.unwrapped_seq_num = Entry::kEmpty;
+  oldest_seq_num_ = end_seq_num_ = 0;
 }
 
 void SendTimeHistory::AddAndRemoveOld(uint16_t sequence_number,
                                       size_t payload_size,
                                       int probe_cluster_id) {
   int64_t now_ms = clock_->TimeInMilliseconds();
-  // Remove old.
-  while (!history_.empty() &&
-         now_ms - history_.begin()->second.creation_time_ms >
-             packet_age_limit_ms_) {
-    // TODO(sprang): Warn if erasing (too many) old items?
-    history_.erase(history_.begin());
+  // Remove old. Holes left by GetInfo(..., true) are skipped over as well.
+  while (oldest_seq_num_ < end_seq_num_) {
+    Entry& oldest = history_[oldest_seq_num_ & (history_.size() - 1)];
+    if (oldest.unwrapped_seq_num == oldest_seq_num_) {
+      if (now_ms - oldest.info.creation_time_ms <= packet_age_limit_ms_)
+        break;
+      // TODO(sprang): Warn if erasing (too many) old items?
+      oldest.unwrapped_seq_num = Entry::kEmpty;
+    }
+    ++oldest_seq_num_;
   }
 
   // Add new.
   int64_t unwrapped_seq_num = seq_num_unwrapper_.Unwrap(sequence_number);
+  if (!MakeRoomFor(unwrapped_seq_num))
+    return;
   int64_t creation_time_ms = now_ms;
   constexpr int64_t kNoArrivalTimeMs = -1;  // Arrival time is ignored.
   constexpr int64_t kNoSendTimeMs = -1;     // Send time is set by OnSentPacket.
-  history_.insert(std::make_pair(
-      unwrapped_seq_num,
-      PacketInfo(creation_time_ms, kNoArrivalTimeMs, kNoSendTimeMs,
-                 sequence_number, payload_size, probe_cluster_id)));
+  Entry& entry = history_[unwrapped_seq_num & (history_.size() - 1)];
+  entry.unwrapped_seq_num = unwrapped_seq_num;
+  entry.info = PacketInfo(creation_time_ms, kNoArrivalTimeMs, kNoSendTimeMs,
+                          sequence_number, payload_size, probe_cluster_id);
 }
 
 bool SendTimeHistory::OnSentPacket(uint16_t sequence_number,
                                    int64_t send_time_ms) {
   int64_t unwrapped_seq_num = seq_num_unwrapper_.Unwrap(sequence_number);
-  auto it = history_.find(unwrapped_seq_num);
-  if (it == history_.end())
+  Entry* entry = Find(unwrapped_seq_num);
+  if (!entry)
     return false;
-  it->second.send_time_ms = send_time_ms;
+  entry->info.send_time_ms = send_time_ms;
   return true;
 }
 
@@ -62,18 +83,82 @@ bool SendTimeHistory::GetInfo(PacketInfo* packet_info, bool remove) {
   RTC_DCHECK(packet_info);
   int64_t unwrapped_seq_num =
       seq_num_unwrapper_.Unwrap(packet_info->sequence_number);
-  auto it = history_.find(unwrapped_seq_num);
-  if (it == history_.end())
+  Entry* entry = Find(unwrapped_seq_num);
+  if (!entry)
     return false;
 
   // Save arrival_time not to overwrite it.
   int64_t arrival_time_ms = packet_info->arrival_time_ms;
-  *packet_info = it->second;
+  *packet_info = entry->info;
   packet_info->arrival_time_ms = arrival_time_ms;
 
   if (remove)
-    history_.erase(it);
+    Erase(entry);
+  return true;
+}
+
+SendTimeHistory::Entry* SendTimeHistory::Find(int64_t unwrapped_seq_num) {
+  if (unwrapped_seq_num < oldest_seq_num_ || unwrapped_seq_num >= end_seq_num_)
+    return nullptr;
+  Entry& entry = history_[unwrapped_seq_num & (history_.size() - 1)];
+  return entry.unwrapped_seq_num == unwrapped_seq_num ? &entry : nullptr;
+}
+
+void SendTimeHistory::Erase(Entry* entry) {
+  int64_t unwrapped_seq_num = entry->unwrapped_seq_num;
+  entry->unwrapped_seq_num = Entry::kEmpty;
+  // Keep the range tight so the age check above starts at a live entry.
+  if (unwrapped_seq_num == oldest_seq_num_) {
+    while (oldest_seq_num_ < end_seq_num_ &&
+           history_[oldest_seq_num_ & (history_.size() - 1)]
+                   .unwrapped_seq_num != oldest_seq_num_) {
+      ++oldest_seq_num_;
+    }
+  }
+  if (oldest_seq_num_ == end_seq_num_)
+    oldest_seq_num_ = end_seq_num_ = 0;
+}
+
+bool SendTimeHistory::MakeRoomFor(int64_t unwrapped_seq_num) {
+  if (oldest_seq_num_ == end_seq_num_) {
+    oldest_seq_num_ = unwrapped_seq_num;
+    end_seq_num_ = unwrapped_seq_num + 1;
+    return true;
+  }
+  int64_t oldest = std::min(oldest_seq_num_, unwrapped_seq_num);
+  int64_t end = std::max(end_seq_num_, unwrapped_seq_num + 1);
+  while (end - oldest > static_cast<int64_t>(history_.size()) &&
+         history_.size() < kMaxHistorySize) {
+    Grow();
+  }
+  if (end - oldest > static_cast<int64_t>(history_.size())) {
+    if (unwrapped_seq_num < oldest_seq_num_) {
+      // Older than anything the history can still hold.
+      return false;
+    }
+    // Evict from the old end to make room for the new packet.
+    int64_t new_oldest = end - static_cast<int64_t>(history_.size());
+    for (; oldest_seq_num_ < new_oldest && oldest_seq_num_ < end_seq_num_;
+         ++oldest_seq_num_) {
+      Entry& entry = history_[oldest_seq_num_ & (history_.size() - 1)];
+      if (entry.unwrapped_seq_num == oldest_seq_num_)
+        entry.unwrapped_seq_num = Entry::kEmpty;
+    }
+    oldest = new_oldest;
+  }
+  oldest_seq_num_ = oldest;
+  end_seq_num_ = end;
   return true;
 }
 
+void SendTimeHistory::Grow() {
+  std::vector<Entry> history(history_.size() * 2);
+  const size_t mask = history.size() - 1;
+  for (const Entry& entry : history_) {
+    if (entry.unwrapped_seq_num != Entry::kEmpty)
+      history[entry.unwrapped_seq_num & mask] = entry;
+  }
+  history_.swap(history);
+}
+
 }  // namespace webrtc
@@ -235,5 +235,35 @@ TEST_F(SendTimeHistoryTest, InterlievedGetAndRemove) {
   EXPECT_EQ(packets[2], info3);
 }
 
+TEST_F(SendTimeHistoryTest, HoldsManyPacketsInFlight) {
+  // More packets than the initial ring size, all within the age limit.
+  const int kNumPackets = 20000;
+  for (int i = 0; i < kNumPackets; ++i) {
+    AddPacketWithSendTime(static_cast<uint16_t>(i), i, i,
+                          PacketInfo::kNotAProbe);
+  }
+  for (int i = 0; i < kNumPackets; ++i) {
+    PacketInfo info(0, static_cast<uint16_t>(i));
+    ASSERT_TRUE(history_.GetInfo(&info, true));
+    EXPECT_EQ(i, info.send_time_ms);
+    EXPECT_EQ(static_cast<size_t>(i), info.payload_size);
+  }
+}
+
+TEST_F(SendTimeHistoryTest, DropsOldestWhenFull) {
+  // Sequence numbers can't be told apart beyond half the sequence number
+  // space, so that is all the history keeps even within the age limit.
+  const int kNumPackets = 1 << 16;
+  for (int i = 0; i < kNumPackets; ++i) {
+    AddPacketWithSendTime(static_cast<uint16_t>(i), 0, i,
+                          PacketInfo::kNotAProbe);
+  }
+  PacketInfo oldest(0, 0);
+  EXPECT_FALSE(history_.GetInfo(&oldest, false));
+  PacketInfo newest(0, static_cast<uint16_t>(kNumPackets - 1));
+  EXPECT_TRUE(history_.GetInfo(&newest, false));
+  EXPECT_EQ(kNumPackets - 1, newest.send_time_ms);
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -142,8 +142,6 @@ int ProducerFec::AddRtpPacketAndGenerateFec(const uint8_t* data_buffer,
   if (media_packets_.empty()) {
     params_ = new_params_;
   }
-  bool complete_frame = false;
-  const bool marker_bit = (data_buffer[1] & kRtpMarkerBitMask) ? true : false;
   if (media_packets_.size() < kUlpfecMaxMediaPackets) {
     // Generic FEC can only protect up to |kUlpfecMaxMediaPackets| packets.
     std::unique_ptr<ForwardErrorCorrection::Packet> packet(
@@ -152,6 +150,37 @@ int ProducerFec::AddRtpPacketAndGenerateFec(const uint8_t* data_buffer,
     memcpy(packet->data, data_buffer, packet->length);
     media_packets_.push_back(std::move(packet));
   }
+  return MaybeGenerateFec((data_buffer[1] & kRtpMarkerBitMask) != 0);
+}
+
+int ProducerFec::AddRedPacketAndGenerateFec(const uint8_t* data_buffer,
+                                            size_t red_payload_length,
+                                            size_t rtp_header_length) {
+  RTC_DCHECK(generated_fec_packets_.empty());
+  RTC_DCHECK_GE(red_payload_length, kRedForFecHeaderLength);
+  if (media_packets_.empty()) {
+    params_ = new_params_;
+  }
+  if (media_packets_.size() < kUlpfecMaxMediaPackets) {
+    // Restore the media payload type from the RED header and leave the RED
+    // header out of the payload.
+    const size_t payload_length = red_payload_length - kRedForFecHeaderLength;
+    std::unique_ptr<ForwardErrorCorrection::Packet> packet(
+        new ForwardErrorCorrection::Packet());
+    packet->length = payload_length + rtp_header_length;
+    memcpy(packet->data, data_buffer, rtp_header_length);
+    packet->data[1] = (data_buffer[1] & kRtpMarkerBitMask) |
+                      (data_buffer[rtp_header_length] & 0x7f);
+    memcpy(packet->data + rtp_header_length,
+           data_buffer + rtp_header_length + kRedForFecHeaderLength,
+           payload_length);
+    media_packets_.push_back(std::move(packet));
+  }
+  return MaybeGenerateFec((data_buffer[1] & kRtpMarkerBitMask) != 0);
+}
+
+int ProducerFec::MaybeGenerateFec(bool marker_bit) {
+  bool complete_frame = false;
   if (marker_bit) {
     ++num_protected_frames_;
     complete_frame = true;
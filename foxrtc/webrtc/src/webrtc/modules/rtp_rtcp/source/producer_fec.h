@@ -58,6 +58,14 @@ class ProducerFec {
                                  size_t payload_length,
                                  size_t rtp_header_length);
 
+  // Same as above, for a media packet that already is wrapped in RED, with
+  // |red_payload_length| including the RED header. The FEC is computed over
+  // the media packet as it was before the wrapping, so the sender does not
+  // have to keep a separate copy of it.
+  int AddRedPacketAndGenerateFec(const uint8_t* data_buffer,
+                                 size_t red_payload_length,
+                                 size_t rtp_header_length);
+
   // Returns true if there are generated FEC packets available.
   bool FecAvailable() const;
 
@@ -93,6 +101,10 @@ class ProducerFec {
   // (e.g. (2k,2m) vs (k,m)) are generally more effective at recovering losses.
   bool MinimumMediaPacketsReached() const;
 
+  // Generates FEC packets if the media packets added so far are enough, and
+  // returns the result of the encoding. Called after each added packet.
+  int MaybeGenerateFec(bool marker_bit);
+
   void ResetState();
 
   std::unique_ptr<ForwardErrorCorrection> fec_;
@@ -166,6 +166,43 @@ TEST_F(ProducerFecTest, TwoFrameFec) {
                red_packets.front().get(), false);
 }
 
+TEST_F(ProducerFecTest, FecFromRedPacketsMatchesFecFromMediaPackets) {
+  constexpr size_t kNumPackets = 4;
+  FecProtectionParams params = {15, 3, kFecMaskRandom};
+  ProducerFec red_producer;
+  producer_.SetFecParameters(&params);
+  red_producer.SetFecParameters(&params);
+  packet_generator_.NewFrame(kNumPackets);
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    std::unique_ptr<AugmentedPacket> packet =
+        packet_generator_.NextPacket(i, 10 + i);
+    const size_t payload_length = packet->length - kRtpHeaderSize;
+    std::unique_ptr<RedPacket> red_packet = ProducerFec::BuildRedPacket(
+        packet->data, payload_length, kRtpHeaderSize, kRedPayloadType);
+    EXPECT_EQ(0, producer_.AddRtpPacketAndGenerateFec(
+                     packet->data, payload_length, kRtpHeaderSize));
+    EXPECT_EQ(0, red_producer.AddRedPacketAndGenerateFec(
+                     red_packet->data(), red_packet->length() - kRtpHeaderSize,
+                     kRtpHeaderSize));
+  }
+  ASSERT_TRUE(producer_.FecAvailable());
+  ASSERT_TRUE(red_producer.FecAvailable());
+
+  uint16_t seq_num = packet_generator_.NextPacketSeqNum();
+  std::vector<std::unique_ptr<RedPacket>> fec_packets =
+      producer_.GetUlpfecPacketsAsRed(kRedPayloadType, kFecPayloadType, seq_num,
+                                      kRtpHeaderSize);
+  std::vector<std::unique_ptr<RedPacket>> red_fec_packets =
+      red_producer.GetUlpfecPacketsAsRed(kRedPayloadType, kFecPayloadType,
+                                         seq_num, kRtpHeaderSize);
+  ASSERT_EQ(fec_packets.size(), red_fec_packets.size());
+  for (size_t i = 0; i < fec_packets.size(); ++i) {
+    ASSERT_EQ(fec_packets[i]->length(), red_fec_packets[i]->length());
+    EXPECT_EQ(0, memcmp(fec_packets[i]->data(), red_fec_packets[i]->data(),
+                        fec_packets[i]->length()));
+  }
+}
+
 TEST_F(ProducerFecTest, BuildRedPacket) {
   packet_generator_.NewFrame(1);
   std::unique_ptr<AugmentedPacket> packet = packet_generator_.NextPacket(0, 10);
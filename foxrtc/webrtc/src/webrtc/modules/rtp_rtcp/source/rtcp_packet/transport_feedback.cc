@@ -536,13 +536,19 @@ int64_t TransportFeedback::GetBaseTimeUs() const {
 std::vector<TransportFeedback::StatusSymbol>
 TransportFeedback::GetStatusVector() const {
   std::vector<TransportFeedback::StatusSymbol> symbols;
+  GetStatusVector(&symbols);
+  return symbols;
+}
+
+void TransportFeedback::GetStatusVector(
+    std::vector<StatusSymbol>* symbols) const {
+  symbols->clear();
   for (PacketStatusChunk* chunk : status_chunks_)
-    chunk->AppendSymbolsTo(&symbols);
+    chunk->AppendSymbolsTo(symbols);
   int64_t status_count = last_seq_ - base_seq_ + 1;
   // If packet ends with a vector chunk, it may contain extraneous "packet not
   // received"-symbols at the end. Crop any such symbols.
-  symbols.erase(symbols.begin() + status_count, symbols.end());
-  return symbols;
+  symbols->erase(symbols->begin() + status_count, symbols->end());
 }
 
 std::vector<int16_t> TransportFeedback::GetReceiveDeltas() const {
@@ -48,7 +48,12 @@ class TransportFeedback : public Rtpfb {
 
   uint16_t GetBaseSequence() const;
   std::vector<TransportFeedback::StatusSymbol> GetStatusVector() const;
+  // Same as above, but writes into |symbols| so that a caller handling many
+  // feedback packets can reuse its capacity.
+  void GetStatusVector(std::vector<StatusSymbol>* symbols) const;
   std::vector<int16_t> GetReceiveDeltas() const;
+  // Receive deltas in multiples of kDeltaScaleFactor, without a copy.
+  const std::vector<int16_t>& receive_deltas() const { return receive_deltas_; }
 
   // Get the reference time in microseconds, including any precision loss.
   int64_t GetBaseTimeUs() const;
@@ -31,6 +31,10 @@ class RtpHeaderParserImpl : public RtpHeaderParser {
  private:
   rtc::CriticalSection critical_section_;
   RtpHeaderExtensionMap rtp_header_extension_map_ GUARDED_BY(critical_section_);
+  // Mirrors |rtp_header_extension_map_|. Copied out of the lock for every
+  // parsed packet, which is much cheaper than copying the map.
+  RtpUtility::RtpExtensionTypeTable extension_types_
+      GUARDED_BY(critical_section_);
 };
 
 RtpHeaderParser* RtpHeaderParser::Create() {
@@ -50,13 +54,13 @@ bool RtpHeaderParserImpl::Parse(const uint8_t* packet,
   RtpUtility::RtpHeaderParser rtp_parser(packet, length);
   memset(header, 0, sizeof(*header));
 
-  RtpHeaderExtensionMap map;
+  RtpUtility::RtpExtensionTypeTable extension_types;
   {
     rtc::CritScope cs(&critical_section_);
-    rtp_header_extension_map_.GetCopy(&map);
+    extension_types = extension_types_;
   }
 
-  const bool valid_rtpheader = rtp_parser.Parse(header, &map);
+  const bool valid_rtpheader = rtp_parser.Parse(header, extension_types);
   if (!valid_rtpheader) {
     return false;
   }
@@ -66,11 +70,19 @@ bool RtpHeaderParserImpl::Parse(const uint8_t* packet,
 bool RtpHeaderParserImpl::RegisterRtpHeaderExtension(RTPExtensionType type,
                                                      uint8_t id) {
   rtc::CritScope cs(&critical_section_);
-  return rtp_header_extension_map_.Register(type, id) == 0;
+  if (rtp_header_extension_map_.Register(type, id) != 0)
+    return false;
+  extension_types_ =
+      RtpUtility::RtpExtensionTypeTable(rtp_header_extension_map_);
+  return true;
 }
 
 bool RtpHeaderParserImpl::DeregisterRtpHeaderExtension(RTPExtensionType type) {
   rtc::CritScope cs(&critical_section_);
-  return rtp_header_extension_map_.Deregister(type) == 0;
+  if (rtp_header_extension_map_.Deregister(type) != 0)
+    return false;
+  extension_types_ =
+      RtpUtility::RtpExtensionTypeTable(rtp_header_extension_map_);
+  return true;
 }
 }  // namespace webrtc
@@ -0,0 +1,122 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/rtp_rtcp/include/rtp_header_parser.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_header_extension.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_utility.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kNumPackets = 1000;
+constexpr int kNumIterations = 200;
+constexpr uint8_t kAudioLevelId = 1;
+constexpr uint8_t kAbsSendTimeId = 2;
+constexpr uint8_t kTransportSequenceNumberId = 3;
+
+// Audio packets with the audio level, absolute send time and transport
+// sequence number extensions, as received by an audio-heavy server.
+std::vector<std::vector<uint8_t>> MakePackets() {
+  std::vector<std::vector<uint8_t>> packets;
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    const uint16_t seq_num = static_cast<uint16_t>(i);
+    std::vector<uint8_t> packet = {
+        0x90, 111, static_cast<uint8_t>(seq_num >> 8),
+        static_cast<uint8_t>(seq_num), 0x00, 0x00, 0x03, 0xc0,
+        0x12, 0x34, 0x56, 0x78, 0xbe, 0xde, 0x00, 0x03,
+        (kAudioLevelId << 4), 0x85,
+        (kAbsSendTimeId << 4) | 2, 0x01, 0x02, 0x03,
+        (kTransportSequenceNumberId << 4) | 1,
+        static_cast<uint8_t>(seq_num >> 8), static_cast<uint8_t>(seq_num),
+        0x00, 0x00, 0x00};
+    packet.resize(packet.size() + 160);
+    packets.push_back(packet);
+  }
+  return packets;
+}
+
+void PrintPacketCost(const std::string& trace, int64_t elapsed_us) {
+  webrtc::test::PrintResult(
+      "rtp_header_parse_cost", "", trace,
+      static_cast<double>(elapsed_us) * 1000 / (kNumPackets * kNumIterations),
+      "ns", true);
+}
+
+}  // namespace
+
+TEST(RtpHeaderParserPerformanceTest, ParseAudioPackets) {
+  const std::vector<std::vector<uint8_t>> packets = MakePackets();
+  std::vector<const uint8_t*> data;
+  std::vector<size_t> lengths;
+  for (const auto& packet : packets) {
+    data.push_back(packet.data());
+    lengths.push_back(packet.size());
+  }
+  RtpHeaderExtensionMap map;
+  map.Register(kRtpExtensionAudioLevel, kAudioLevelId);
+  map.Register(kRtpExtensionAbsoluteSendTime, kAbsSendTimeId);
+  map.Register(kRtpExtensionTransportSequenceNumber,
+               kTransportSequenceNumberId);
+  std::unique_ptr<RtpHeaderParser> parser(RtpHeaderParser::Create());
+  parser->RegisterRtpHeaderExtension(kRtpExtensionAudioLevel, kAudioLevelId);
+  parser->RegisterRtpHeaderExtension(kRtpExtensionAbsoluteSendTime,
+                                     kAbsSendTimeId);
+  parser->RegisterRtpHeaderExtension(kRtpExtensionTransportSequenceNumber,
+                                     kTransportSequenceNumberId);
+  std::vector<RTPHeader> headers(kNumPackets);
+  std::unique_ptr<bool[]> valid(new bool[kNumPackets]);
+
+  // What RtpHeaderParser used to do: copy the map for every packet.
+  int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumIterations; ++i) {
+    for (size_t j = 0; j < kNumPackets; ++j) {
+      RtpHeaderExtensionMap map_copy;
+      map.GetCopy(&map_copy);
+      ASSERT_TRUE(RtpUtility::RtpHeaderParser(data[j], lengths[j])
+                      .Parse(&headers[j], &map_copy));
+    }
+  }
+  PrintPacketCost("map_copy", rtc::TimeMicros() - start_us);
+
+  start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumIterations; ++i) {
+    for (size_t j = 0; j < kNumPackets; ++j) {
+      ASSERT_TRUE(RtpUtility::RtpHeaderParser(data[j], lengths[j])
+                      .Parse(&headers[j], &map));
+    }
+  }
+  PrintPacketCost("map", rtc::TimeMicros() - start_us);
+
+  start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumIterations; ++i) {
+    for (size_t j = 0; j < kNumPackets; ++j)
+      ASSERT_TRUE(parser->Parse(data[j], lengths[j], &headers[j]));
+  }
+  PrintPacketCost("RtpHeaderParser", rtc::TimeMicros() - start_us);
+
+  const RtpUtility::RtpExtensionTypeTable table(map);
+  start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumIterations; ++i) {
+    ASSERT_EQ(kNumPackets,
+              RtpUtility::ParseRtpHeaders(data.data(), lengths.data(),
+                                          kNumPackets, table, headers.data(),
+                                          valid.get()));
+  }
+  PrintPacketCost("batch", rtc::TimeMicros() - start_us);
+  EXPECT_EQ(kNumPackets - 1, headers.back().extension.transportSequenceNumber);
+}
+
+}  // namespace webrtc
@@ -43,7 +43,8 @@ class RtpPacketHistory {
   // |min_elapsed_time_ms| is the minimum time that must have elapsed since
   // the last time the packet was resent (parameter is ignored if set to zero).
   // If the packet is found but the minimum time has not elapsed, returns
-  // nullptr.
+  // nullptr. The returned packet shares its buffer with the stored one until
+  // either of them is modified.
   std::unique_ptr<RtpPacketToSend> GetPacketAndSetSendTime(
       uint16_t sequence_number,
       int64_t min_elapsed_time_ms,
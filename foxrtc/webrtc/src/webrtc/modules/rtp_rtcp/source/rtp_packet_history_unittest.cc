@@ -80,6 +80,8 @@ TEST_F(RtpPacketHistoryTest, GetRtpPacket) {
       hist_.GetPacketAndSetSendTime(kSeqNum, 0, false);
   EXPECT_TRUE(packet_out);
   EXPECT_EQ(buffer, packet_out->Buffer());
+  // The stored packet is shared, not copied.
+  EXPECT_EQ(buffer.cdata(), packet_out->Buffer().cdata());
   EXPECT_EQ(capture_time_ms, packet_out->capture_time_ms());
 }
 
@@ -34,15 +34,6 @@ namespace webrtc {
 namespace {
 constexpr size_t kRedForFecHeaderLength = 1;
 
-void BuildRedPayload(const RtpPacketToSend& media_packet,
-                     RtpPacketToSend* red_packet) {
-  uint8_t* red_payload = red_packet->AllocatePayload(
-      kRedForFecHeaderLength + media_packet.payload_size());
-  RTC_DCHECK(red_payload);
-  red_payload[0] = media_packet.PayloadType();
-  memcpy(&red_payload[kRedForFecHeaderLength], media_packet.payload(),
-         media_packet.payload_size());
-}
 }  // namespace
 
 RTPSenderVideo::RTPSenderVideo(Clock* clock, RTPSender* rtp_sender)
@@ -104,15 +95,12 @@ void RTPSenderVideo::SendVideoPacket(std::unique_ptr<RtpPacketToSend> packet,
 }
 
 void RTPSenderVideo::SendVideoPacketAsRed(
-    std::unique_ptr<RtpPacketToSend> media_packet,
+    std::unique_ptr<RtpPacketToSend> red_packet,
     StorageType media_packet_storage,
     bool protect) {
-  uint32_t rtp_timestamp = media_packet->Timestamp();
-  uint16_t media_seq_num = media_packet->SequenceNumber();
-
-  std::unique_ptr<RtpPacketToSend> red_packet(
-      new RtpPacketToSend(*media_packet));
-  BuildRedPayload(*media_packet, red_packet.get());
+  uint32_t rtp_timestamp = red_packet->Timestamp();
+  uint16_t media_seq_num = red_packet->SequenceNumber();
+  int64_t capture_time_ms = red_packet->capture_time_ms();
 
   std::vector<std::unique_ptr<RedPacket>> fec_packets;
   StorageType fec_storage = kDontRetransmit;
@@ -121,9 +109,9 @@ void RTPSenderVideo::SendVideoPacketAsRed(
     rtc::CritScope cs(&crit_);
     red_packet->SetPayloadType(red_payload_type_);
     if (protect) {
-      producer_fec_.AddRtpPacketAndGenerateFec(media_packet->data(),
-                                               media_packet->payload_size(),
-                                               media_packet->headers_size());
+      producer_fec_.AddRedPacketAndGenerateFec(red_packet->data(),
+                                               red_packet->payload_size(),
+                                               red_packet->headers_size());
     }
     uint16_t num_fec_packets = producer_fec_.NumAvailableFecPackets();
     if (num_fec_packets > 0) {
@@ -131,13 +119,12 @@ void RTPSenderVideo::SendVideoPacketAsRed(
           rtp_sender_->AllocateSequenceNumber(num_fec_packets);
       fec_packets = producer_fec_.GetUlpfecPacketsAsRed(
           red_payload_type_, fec_payload_type_, first_fec_sequence_number,
-          media_packet->headers_size());
+          red_packet->headers_size());
       RTC_DCHECK_EQ(num_fec_packets, fec_packets.size());
       if (retransmission_settings_ & kRetransmitFECPackets)
         fec_storage = kAllowRetransmission;
     }
   }
-  // Send |red_packet| instead of |packet| for allocated sequence number.
   size_t red_packet_size = red_packet->size();
   if (rtp_sender_->SendToNetwork(std::move(red_packet), media_packet_storage,
                                  RtpPacketSender::kLowPriority)) {
@@ -152,10 +139,10 @@ void RTPSenderVideo::SendVideoPacketAsRed(
   for (const auto& fec_packet : fec_packets) {
     // TODO(danilchap): Make producer_fec_ generate RtpPacketToSend to avoid
     // reparsing them.
-    std::unique_ptr<RtpPacketToSend> rtp_packet(
-        new RtpPacketToSend(*media_packet));
+    std::unique_ptr<RtpPacketToSend> rtp_packet =
+        rtp_sender_->AllocatePacket();
     RTC_CHECK(rtp_packet->Parse(fec_packet->data(), fec_packet->length()));
-    rtp_packet->set_capture_time_ms(media_packet->capture_time_ms());
+    rtp_packet->set_capture_time_ms(capture_time_ms);
     uint16_t fec_sequence_number = rtp_packet->SequenceNumber();
     if (rtp_sender_->SendToNetwork(std::move(rtp_packet), fec_storage,
                                    RtpPacketSender::kLowPriority)) {
@@ -286,18 +273,31 @@ bool RTPSenderVideo::SendVideo(RtpVideoCodecTypes video_type,
 
   packetizer->SetPayloadData(payload_data, payload_size, frag);
 
+  // With RED, the packetizer writes each payload straight into the RED
+  // packet, behind a RED header reserved up front, instead of into a media
+  // packet that is then copied. FecPacketOverhead() accounts for the header.
+  const size_t red_header_length =
+      red_payload_type != 0 ? kRedForFecHeaderLength : 0;
+
   bool first = true;
   bool last = false;
   while (!last) {
     std::unique_ptr<RtpPacketToSend> packet(new RtpPacketToSend(*rtp_header));
-    uint8_t* payload = packet->AllocatePayload(max_data_payload_length);
+    uint8_t* payload =
+        packet->AllocatePayload(red_header_length + max_data_payload_length);
     RTC_DCHECK(payload);
+    if (red_header_length > 0) {
+      // F-bit always 0.
+      payload[0] = static_cast<uint8_t>(payload_type);
+    }
 
     size_t payload_bytes_in_packet = 0;
-    if (!packetizer->NextPacket(payload, &payload_bytes_in_packet, &last))
+    if (!packetizer->NextPacket(payload + red_header_length,
+                                &payload_bytes_in_packet, &last)) {
       return false;
+    }
 
-    packet->SetPayloadSize(payload_bytes_in_packet);
+    packet->SetPayloadSize(red_header_length + payload_bytes_in_packet);
     packet->SetMarker(last);
     if (!rtp_sender_->AssignSequenceNumber(packet.get()))
       return false;
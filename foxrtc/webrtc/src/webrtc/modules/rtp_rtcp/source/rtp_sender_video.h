@@ -80,7 +80,9 @@ class RTPSenderVideo {
   void SendVideoPacket(std::unique_ptr<RtpPacketToSend> packet,
                        StorageType storage);
 
-  void SendVideoPacketAsRed(std::unique_ptr<RtpPacketToSend> media_packet,
+  // |red_packet| already carries the media payload behind a RED header, as
+  // written by SendVideo(), and the media payload type.
+  void SendVideoPacketAsRed(std::unique_ptr<RtpPacketToSend> red_packet,
                             StorageType media_packet_storage,
                             bool protect);
 
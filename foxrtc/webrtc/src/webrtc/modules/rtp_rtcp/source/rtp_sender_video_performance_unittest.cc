@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_sender.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+#include "webrtc/transport.h"
+
+namespace webrtc {
+namespace {
+
+// A 4K keyframe.
+constexpr size_t kFrameSize = 2 * 1024 * 1024;
+constexpr int kNumFrames = 20;
+constexpr int8_t kPayloadType = 100;
+constexpr uint8_t kRedPayloadType = 96;
+constexpr uint8_t kUlpfecPayloadType = 97;
+constexpr uint16_t kPacketsToStore = 2000;
+
+class CountingTransport : public Transport {
+ public:
+  bool SendRtp(const uint8_t* packet,
+               size_t length,
+               const PacketOptions& options) override {
+    ++num_packets_;
+    return true;
+  }
+  bool SendRtcp(const uint8_t* packet, size_t length) override {
+    return true;
+  }
+
+  int num_packets_ = 0;
+};
+
+// Times RTPSender::SendOutgoingData() for |kNumFrames| VP8 keyframes of
+// |kFrameSize| bytes, i.e. packetization, RED and ULPFEC protection and
+// storage in the packet history, until the last packet has been handed to
+// the transport.
+void RunPacketizationBenchmark(bool red, bool ulpfec,
+                               const std::string& trace) {
+  SimulatedClock clock(123456);
+  CountingTransport transport;
+  RTPSender rtp_sender(false, &clock, &transport, nullptr, nullptr, nullptr,
+                       nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+  char payload_name[RTP_PAYLOAD_NAME_SIZE] = "VP8";
+  ASSERT_EQ(0, rtp_sender.RegisterPayload(payload_name, kPayloadType, 90000,
+                                          0, 0));
+  rtp_sender.SetStorePacketsStatus(true, kPacketsToStore);
+  if (red) {
+    rtp_sender.SetGenericFECStatus(true, kRedPayloadType, kUlpfecPayloadType);
+    FecProtectionParams params = {ulpfec ? 50 : 0, 1, kFecMaskRandom};
+    rtp_sender.SetFecParameters(&params, &params);
+  }
+
+  std::vector<uint8_t> frame(kFrameSize);
+  for (size_t i = 0; i < frame.size(); ++i)
+    frame[i] = static_cast<uint8_t>(i * 31);
+  RTPVideoHeader video_header = {};
+  video_header.codec = kRtpVideoVp8;
+  video_header.codecHeader.VP8.InitRTPVideoHeaderVP8();
+
+  int64_t total_time_us = 0;
+  for (int i = 0; i < kNumFrames; ++i) {
+    video_header.codecHeader.VP8.pictureId = i;
+    int64_t start_us = rtc::TimeMicros();
+    ASSERT_TRUE(rtp_sender.SendOutgoingData(
+        kVideoFrameKey, kPayloadType, i * 3000, clock.TimeInMilliseconds(),
+        frame.data(), frame.size(), nullptr, &video_header, nullptr));
+    total_time_us += rtc::TimeMicros() - start_us;
+    clock.AdvanceTimeMilliseconds(33);
+  }
+  EXPECT_GT(transport.num_packets_, kNumFrames);
+
+  webrtc::test::PrintResult("rtp_sender_video_keyframe_time", "", trace,
+                            static_cast<double>(total_time_us) / kNumFrames,
+                            "us", true);
+}
+
+}  // namespace
+
+TEST(RtpSenderVideoPerformanceTest, KeyframePacketization) {
+  RunPacketizationBenchmark(false, false, "vp8_2mb");
+  RunPacketizationBenchmark(true, false, "vp8_2mb_red");
+  RunPacketizationBenchmark(true, true, "vp8_2mb_red_ulpfec");
+}
+
+}  // namespace webrtc
@@ -12,6 +12,7 @@
 
 #include <string.h>
 
+#include "webrtc/base/arraysize.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_cvo.h"
 #include "webrtc/modules/rtp_rtcp/source/byte_io.h"
@@ -67,6 +68,16 @@ size_t Word32Align(size_t size) {
   return size;
 }
 
+RtpExtensionTypeTable::RtpExtensionTypeTable() {
+  for (RTPExtensionType& type : types)
+    type = kRtpExtensionNone;
+}
+
+RtpExtensionTypeTable::RtpExtensionTypeTable(const RtpHeaderExtensionMap& map) {
+  for (size_t id = 0; id < arraysize(types); ++id)
+    types[id] = map.GetType(static_cast<uint8_t>(id));
+}
+
 RtpHeaderParser::RtpHeaderParser(const uint8_t* rtpData,
                                  const size_t rtpDataLength)
     : _ptrRTPDataBegin(rtpData),
@@ -178,6 +189,19 @@ bool RtpHeaderParser::ParseRtcp(RTPHeader* header) const {
 
 bool RtpHeaderParser::Parse(RTPHeader* header,
                             RtpHeaderExtensionMap* ptrExtensionMap) const {
+  return ParseInternal(header, ptrExtensionMap, nullptr);
+}
+
+bool RtpHeaderParser::Parse(
+    RTPHeader* header,
+    const RtpExtensionTypeTable& extension_types) const {
+  return ParseInternal(header, nullptr, &extension_types);
+}
+
+bool RtpHeaderParser::ParseInternal(
+    RTPHeader* header,
+    const RtpHeaderExtensionMap* ptrExtensionMap,
+    const RtpExtensionTypeTable* extension_types) const {
   const ptrdiff_t length = _ptrRTPDataEnd - _ptrRTPDataBegin;
   if (length < kRtpMinParseLength) {
     return false;
@@ -285,6 +309,7 @@ bool RtpHeaderParser::Parse(RTPHeader* header,
       const uint8_t* ptrRTPDataExtensionEnd = ptr + XLen;
       ParseOneByteExtensionHeader(header,
                                   ptrExtensionMap,
+                                  extension_types,
                                   ptrRTPDataExtensionEnd,
                                   ptr);
     }
@@ -299,9 +324,10 @@ bool RtpHeaderParser::Parse(RTPHeader* header,
 void RtpHeaderParser::ParseOneByteExtensionHeader(
     RTPHeader* header,
     const RtpHeaderExtensionMap* ptrExtensionMap,
+    const RtpExtensionTypeTable* extension_types,
     const uint8_t* ptrRTPDataExtensionEnd,
     const uint8_t* ptr) const {
-  if (!ptrExtensionMap) {
+  if (!ptrExtensionMap && !extension_types) {
     return;
   }
 
@@ -331,8 +357,9 @@ void RtpHeaderParser::ParseOneByteExtensionHeader(
       return;
     }
 
-    RTPExtensionType type;
-    if (ptrExtensionMap->GetType(id, &type) != 0) {
+    RTPExtensionType type = extension_types ? extension_types->types[id]
+                                            : ptrExtensionMap->GetType(id);
+    if (type == kRtpExtensionNone) {
       // If we encounter an unknown extension, just skip over it.
       LOG(LS_WARNING) << "Failed to find extension id: " << id;
     } else {
@@ -464,5 +491,26 @@ uint8_t RtpHeaderParser::ParsePaddingBytes(
   }
   return num_zero_bytes;
 }
+
+size_t ParseRtpHeaders(const uint8_t* const* packets,
+                       const size_t* lengths,
+                       size_t num_packets,
+                       const RtpExtensionTypeTable& extension_types,
+                       RTPHeader* headers,
+                       bool* valid) {
+  size_t num_valid = 0;
+  for (size_t i = 0; i < num_packets; ++i) {
+#if defined(__GNUC__)
+    if (i + 1 < num_packets)
+      __builtin_prefetch(packets[i + 1]);
+#endif
+    headers[i] = RTPHeader();
+    valid[i] = RtpHeaderParser(packets[i], lengths[i])
+                   .Parse(&headers[i], extension_types);
+    if (valid[i])
+      ++num_valid;
+  }
+  return num_valid;
+}
 }  // namespace RtpUtility
 }  // namespace webrtc
@@ -43,6 +43,17 @@ bool StringCompare(const char* str1, const char* str2, const uint32_t length);
 // Round up to the nearest size that is a multiple of 4.
 size_t Word32Align(size_t size);
 
+// Header extension types indexed by one-byte header extension id, with
+// kRtpExtensionNone for the ids that are not registered. Parsing with a table
+// saves the RtpHeaderExtensionMap lookup per extension, and the table is
+// cheap to copy, e.g. out of a lock.
+struct RtpExtensionTypeTable {
+  RtpExtensionTypeTable();
+  explicit RtpExtensionTypeTable(const RtpHeaderExtensionMap& map);
+
+  RTPExtensionType types[16];
+};
+
 class RtpHeaderParser {
  public:
   RtpHeaderParser(const uint8_t* rtpData, size_t rtpDataLength);
@@ -52,10 +63,19 @@ class RtpHeaderParser {
   bool ParseRtcp(RTPHeader* header) const;
   bool Parse(RTPHeader* parsedPacket,
              RtpHeaderExtensionMap* ptrExtensionMap = nullptr) const;
+  // Same as above, with the header extensions looked up in |extension_types|.
+  bool Parse(RTPHeader* parsedPacket,
+             const RtpExtensionTypeTable& extension_types) const;
 
  private:
+  // Exactly one of |ptrExtensionMap| and |extension_types| is used, the
+  // table when it is not null.
+  bool ParseInternal(RTPHeader* parsedPacket,
+                     const RtpHeaderExtensionMap* ptrExtensionMap,
+                     const RtpExtensionTypeTable* extension_types) const;
   void ParseOneByteExtensionHeader(RTPHeader* parsedPacket,
                                    const RtpHeaderExtensionMap* ptrExtensionMap,
+                                   const RtpExtensionTypeTable* extension_types,
                                    const uint8_t* ptrRTPDataExtensionEnd,
                                    const uint8_t* ptr) const;
 
@@ -65,6 +85,18 @@ class RtpHeaderParser {
   const uint8_t* const _ptrRTPDataBegin;
   const uint8_t* const _ptrRTPDataEnd;
 };
+
+// Parses the RTP headers of |num_packets| packets, e.g. all packets read from
+// a socket at once, into |headers|, which are reset first. Sets |valid[i]| to
+// whether packet |i| has a valid RTP header and returns the number of valid
+// headers. The header of the next packet is prefetched while the current one
+// is parsed.
+size_t ParseRtpHeaders(const uint8_t* const* packets,
+                       const size_t* lengths,
+                       size_t num_packets,
+                       const RtpExtensionTypeTable& extension_types,
+                       RTPHeader* headers,
+                       bool* valid);
 }  // namespace RtpUtility
 }  // namespace webrtc
 
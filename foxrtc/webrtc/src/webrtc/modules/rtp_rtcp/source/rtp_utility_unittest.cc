@@ -0,0 +1,134 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/arraysize.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_header_extension.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_utility.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint8_t kTransmissionOffsetId = 1;
+constexpr uint8_t kAudioLevelId = 3;
+constexpr uint8_t kTransportSequenceNumberId = 5;
+constexpr uint8_t kUnregisteredId = 7;
+
+// Version 2 with a one-byte header extension block of 4 words holding the
+// transmission offset, audio level, an unregistered extension and the
+// transport sequence number.
+constexpr uint8_t kPacketWithExtensions[] = {
+    0x90, 0xe4, 0x12, 0x34, 0x00, 0x01, 0xe2, 0x40,
+    0x12, 0x34, 0x56, 0x78, 0xbe, 0xde, 0x00, 0x04,
+    0x12, 0x00, 0x10, 0x00, 0x30, 0x85, 0x70, 0xaa,
+    0x51, 0x43, 0x21, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x02, 0x03};
+
+void ExpectEqualHeaders(const RTPHeader& expected, const RTPHeader& actual) {
+  EXPECT_EQ(expected.markerBit, actual.markerBit);
+  EXPECT_EQ(expected.payloadType, actual.payloadType);
+  EXPECT_EQ(expected.sequenceNumber, actual.sequenceNumber);
+  EXPECT_EQ(expected.timestamp, actual.timestamp);
+  EXPECT_EQ(expected.ssrc, actual.ssrc);
+  EXPECT_EQ(expected.headerLength, actual.headerLength);
+  EXPECT_EQ(expected.paddingLength, actual.paddingLength);
+  const RTPHeaderExtension& e = expected.extension;
+  const RTPHeaderExtension& a = actual.extension;
+  EXPECT_EQ(e.hasTransmissionTimeOffset, a.hasTransmissionTimeOffset);
+  EXPECT_EQ(e.transmissionTimeOffset, a.transmissionTimeOffset);
+  EXPECT_EQ(e.hasAudioLevel, a.hasAudioLevel);
+  EXPECT_EQ(e.voiceActivity, a.voiceActivity);
+  EXPECT_EQ(e.audioLevel, a.audioLevel);
+  EXPECT_EQ(e.hasAbsoluteSendTime, a.hasAbsoluteSendTime);
+  EXPECT_EQ(e.hasTransportSequenceNumber, a.hasTransportSequenceNumber);
+  EXPECT_EQ(e.transportSequenceNumber, a.transportSequenceNumber);
+}
+
+class RtpUtilityTest : public ::testing::Test {
+ protected:
+  RtpUtilityTest() {
+    extension_map_.Register(kRtpExtensionTransmissionTimeOffset,
+                            kTransmissionOffsetId);
+    extension_map_.Register(kRtpExtensionAudioLevel, kAudioLevelId);
+    extension_map_.Register(kRtpExtensionTransportSequenceNumber,
+                            kTransportSequenceNumberId);
+  }
+
+  RtpHeaderExtensionMap extension_map_;
+};
+
+}  // namespace
+
+TEST_F(RtpUtilityTest, ExtensionTypeTableMatchesMap) {
+  RtpUtility::RtpExtensionTypeTable table(extension_map_);
+  EXPECT_EQ(kRtpExtensionTransmissionTimeOffset,
+            table.types[kTransmissionOffsetId]);
+  EXPECT_EQ(kRtpExtensionAudioLevel, table.types[kAudioLevelId]);
+  EXPECT_EQ(kRtpExtensionTransportSequenceNumber,
+            table.types[kTransportSequenceNumberId]);
+  EXPECT_EQ(kRtpExtensionNone, table.types[kUnregisteredId]);
+  EXPECT_EQ(kRtpExtensionNone, RtpUtility::RtpExtensionTypeTable().types[1]);
+}
+
+TEST_F(RtpUtilityTest, ParseWithTableMatchesParseWithMap) {
+  RtpUtility::RtpHeaderParser parser(kPacketWithExtensions,
+                                     sizeof(kPacketWithExtensions));
+  RTPHeader expected;
+  ASSERT_TRUE(parser.Parse(&expected, &extension_map_));
+  EXPECT_TRUE(expected.markerBit);
+  EXPECT_EQ(100, expected.payloadType);
+  EXPECT_EQ(0x1234, expected.sequenceNumber);
+  EXPECT_EQ(32u, expected.headerLength);
+  EXPECT_TRUE(expected.extension.hasTransmissionTimeOffset);
+  EXPECT_EQ(0x1000, expected.extension.transmissionTimeOffset);
+  EXPECT_TRUE(expected.extension.hasAudioLevel);
+  EXPECT_TRUE(expected.extension.voiceActivity);
+  EXPECT_EQ(5, expected.extension.audioLevel);
+  EXPECT_TRUE(expected.extension.hasTransportSequenceNumber);
+  EXPECT_EQ(0x4321, expected.extension.transportSequenceNumber);
+
+  RTPHeader header;
+  ASSERT_TRUE(parser.Parse(&header,
+                           RtpUtility::RtpExtensionTypeTable(extension_map_)));
+  ExpectEqualHeaders(expected, header);
+}
+
+TEST_F(RtpUtilityTest, ParseRtpHeaders) {
+  const uint8_t kTooShort[] = {0x80, 0x60, 0x00};
+  uint8_t without_extensions[20];
+  memcpy(without_extensions, kPacketWithExtensions, 12);
+  without_extensions[0] = 0x80;
+  const uint8_t* packets[] = {kPacketWithExtensions, kTooShort,
+                              without_extensions};
+  const size_t lengths[] = {sizeof(kPacketWithExtensions), sizeof(kTooShort),
+                            sizeof(without_extensions)};
+  RTPHeader headers[arraysize(packets)];
+  bool valid[arraysize(packets)];
+
+  EXPECT_EQ(2u, RtpUtility::ParseRtpHeaders(
+                    packets, lengths, arraysize(packets),
+                    RtpUtility::RtpExtensionTypeTable(extension_map_), headers,
+                    valid));
+  EXPECT_TRUE(valid[0]);
+  EXPECT_FALSE(valid[1]);
+  EXPECT_TRUE(valid[2]);
+  for (size_t i = 0; i < arraysize(packets); ++i) {
+    if (!valid[i])
+      continue;
+    RTPHeader expected;
+    ASSERT_TRUE(RtpUtility::RtpHeaderParser(packets[i], lengths[i])
+                    .Parse(&expected, &extension_map_));
+    ExpectEqualHeaders(expected, headers[i]);
+  }
+  EXPECT_FALSE(headers[2].extension.hasTransportSequenceNumber);
+  EXPECT_EQ(12u, headers[2].headerLength);
+}
+
+}  // namespace webrtc
@@ -56,6 +56,8 @@ VideoCodecVP9 VideoEncoder::GetDefaultVp9Settings() {
   vp9_settings.automaticResizeOn = true;
   vp9_settings.numberOfSpatialLayers = 1;
   vp9_settings.flexibleMode = false;
+  vp9_settings.numberOfThreads = 0;
+  vp9_settings.frameParallelDecoding = false;
   return vp9_settings;
 }
 
@@ -11,6 +11,7 @@
 #include "webrtc/modules/video_coding/codecs/vp8/simulcast_encoder_adapter.h"
 
 #include <algorithm>
+#include <utility>
 
 // NOTE(ajm): Path provided by gyp.
 #include "libyuv/scale.h"  // NOLINT
@@ -118,14 +119,25 @@ class AdapterEncodedImageCallback : public webrtc::EncodedImageCallback {
   const size_t stream_idx_;
 };
 
+int Pixels(int width, int height) {
+  return width * height;
+}
+
 }  // namespace
 
 namespace webrtc {
 
 SimulcastEncoderAdapter::SimulcastEncoderAdapter(VideoEncoderFactory* factory)
+    : SimulcastEncoderAdapter(factory, 1) {}
+
+SimulcastEncoderAdapter::SimulcastEncoderAdapter(VideoEncoderFactory* factory,
+                                                 int num_encode_threads)
     : factory_(factory),
       encoded_complete_callback_(nullptr),
-      implementation_name_("SimulcastEncoderAdapter") {
+      implementation_name_("SimulcastEncoderAdapter"),
+      encode_threads_(num_encode_threads,
+                      "SimulcastEncoder",
+                      rtc::kHighPriority) {
   memset(&codec_, 0, sizeof(webrtc::VideoCodec));
   rate_allocator_.reset(new SimulcastRateAllocator(codec_));
 }
@@ -147,6 +159,7 @@ int SimulcastEncoderAdapter::Release() {
     delete callback;
     streaminfos_.pop_back();
   }
+  stream_encodes_.reset();
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -223,6 +236,7 @@ int SimulcastEncoderAdapter::InitEncode(const VideoCodec* inst,
       implementation_name += ", ";
     implementation_name += streaminfos_[i].encoder->ImplementationName();
   }
+  stream_encodes_.reset(new StreamEncode[streaminfos_.size()]);
   if (doing_simulcast) {
     implementation_name_ =
         "SimulcastEncoderAdapter (" + implementation_name + ")";
@@ -262,21 +276,103 @@ int SimulcastEncoderAdapter::Encode(
     }
   }
 
-  int src_width = input_image.width();
-  int src_height = input_image.height();
+  // Streams to encode, by decreasing resolution.
+  std::vector<size_t> streams;
   for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
     // Don't encode frames in resolutions that we don't intend to send.
     if (!streaminfos_[stream_idx].send_stream)
       continue;
+    streams.push_back(stream_idx);
 
-    std::vector<FrameType> stream_frame_types;
+    std::vector<FrameType>& stream_frame_types =
+        stream_encodes_[stream_idx].frame_types;
+    stream_frame_types.clear();
     if (send_key_frame) {
       stream_frame_types.push_back(kVideoFrameKey);
       streaminfos_[stream_idx].key_frame_request = false;
     } else {
       stream_frame_types.push_back(kVideoFrameDelta);
     }
+  }
+  std::stable_sort(streams.begin(), streams.end(),
+                   [this](size_t a, size_t b) {
+                     return Pixels(streaminfos_[a].width,
+                                   streaminfos_[a].height) >
+                            Pixels(streaminfos_[b].width,
+                                   streaminfos_[b].height);
+                   });
+  ScaleStreams(input_image, streams);
+
+  const size_t num_threads =
+      std::min(encode_threads_.num_threads(), streams.size());
+  if (num_threads <= 1) {
+    for (size_t stream_idx = 0; stream_idx < streaminfos_.size();
+         ++stream_idx) {
+      if (!streaminfos_[stream_idx].send_stream)
+        continue;
+      StreamEncode& stream_encode = stream_encodes_[stream_idx];
+      int ret = streaminfos_[stream_idx].encoder->Encode(
+          *stream_encode.frame, codec_specific_info,
+          &stream_encode.frame_types);
+      if (ret != WEBRTC_VIDEO_CODEC_OK) {
+        ReleaseScaledFrames();
+        return ret;
+      }
+    }
+    ReleaseScaledFrames();
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  // Hand out the streams, largest first, to the thread with the fewest
+  // pixels to encode so far. Thread 0 is the calling thread.
+  std::vector<std::vector<size_t>> thread_streams(num_threads);
+  std::vector<int> thread_pixels(num_threads, 0);
+  for (size_t stream_idx : streams) {
+    size_t thread = std::min_element(thread_pixels.begin(),
+                                     thread_pixels.end()) -
+                    thread_pixels.begin();
+    thread_streams[thread].push_back(stream_idx);
+    thread_pixels[thread] += Pixels(streaminfos_[stream_idx].width,
+                                    streaminfos_[stream_idx].height);
+    stream_encodes_[stream_idx].collecting = true;
+  }
+  encode_threads_.Run(num_threads, [&](size_t i) {
+    EncodeStreams(thread_streams[i], codec_specific_info);
+  });
+  ReleaseScaledFrames();
+
+  // Deliver every stream that encoded, in stream order, and return the first
+  // error. A stream that failed asks for a key frame on the next Encode().
+  int ret = WEBRTC_VIDEO_CODEC_OK;
+  for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
+    StreamEncode& stream_encode = stream_encodes_[stream_idx];
+    if (!stream_encode.collecting)
+      continue;
+    stream_encode.collecting = false;
+    if (stream_encode.result == WEBRTC_VIDEO_CODEC_OK) {
+      for (const PendingImage& pending : stream_encode.pending_images) {
+        encoded_complete_callback_->OnEncodedImage(
+            pending.encoded_image, &pending.codec_specific_info,
+            pending.fragmentation.get());
+      }
+    } else {
+      streaminfos_[stream_idx].key_frame_request = true;
+      if (ret == WEBRTC_VIDEO_CODEC_OK)
+        ret = stream_encode.result;
+    }
+    stream_encode.pending_images.clear();
+  }
+  return ret;
+}
 
+void SimulcastEncoderAdapter::ScaleStreams(const VideoFrame& input_image,
+                                           const std::vector<size_t>& streams) {
+  int src_width = input_image.width();
+  int src_height = input_image.height();
+  // The smallest frame made so far, to scale the next stream from.
+  const VideoFrame* source = &input_image;
+  for (size_t stream_idx : streams) {
+    StreamEncode& stream_encode = stream_encodes_[stream_idx];
     int dst_width = streaminfos_[stream_idx].width;
     int dst_height = streaminfos_[stream_idx].height;
     // If scaling isn't required, because the input resolution
@@ -292,40 +388,57 @@ int SimulcastEncoderAdapter::Encode(
     if ((dst_width == src_width && dst_height == src_height) ||
         input_image.IsZeroSize() ||
         input_image.video_frame_buffer()->native_handle()) {
-      int ret = streaminfos_[stream_idx].encoder->Encode(
-          input_image, codec_specific_info, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
-    } else {
-      // Aligning stride values based on width.
-      rtc::scoped_refptr<I420Buffer> dst_buffer =
-          I420Buffer::Create(dst_width, dst_height, dst_width,
-                             (dst_width + 1) / 2, (dst_width + 1) / 2);
-      libyuv::I420Scale(input_image.video_frame_buffer()->DataY(),
-                        input_image.video_frame_buffer()->StrideY(),
-                        input_image.video_frame_buffer()->DataU(),
-                        input_image.video_frame_buffer()->StrideU(),
-                        input_image.video_frame_buffer()->DataV(),
-                        input_image.video_frame_buffer()->StrideV(),
-                        src_width, src_height,
-                        dst_buffer->MutableDataY(), dst_buffer->StrideY(),
-                        dst_buffer->MutableDataU(), dst_buffer->StrideU(),
-                        dst_buffer->MutableDataV(), dst_buffer->StrideV(),
-                        dst_width, dst_height,
-                        libyuv::kFilterBilinear);
-
-      int ret = streaminfos_[stream_idx].encoder->Encode(
-          VideoFrame(dst_buffer, input_image.timestamp(),
-                     input_image.render_time_ms(), webrtc::kVideoRotation_0),
-          codec_specific_info, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
+      stream_encode.frame = &input_image;
+      continue;
+    }
+    // Another stream has the same resolution.
+    if (dst_width == source->width() && dst_height == source->height()) {
+      stream_encode.frame = source;
+      continue;
     }
+
+    // Aligning stride values based on width.
+    rtc::scoped_refptr<I420Buffer> dst_buffer =
+        I420Buffer::Create(dst_width, dst_height, dst_width,
+                           (dst_width + 1) / 2, (dst_width + 1) / 2);
+    libyuv::I420Scale(source->video_frame_buffer()->DataY(),
+                      source->video_frame_buffer()->StrideY(),
+                      source->video_frame_buffer()->DataU(),
+                      source->video_frame_buffer()->StrideU(),
+                      source->video_frame_buffer()->DataV(),
+                      source->video_frame_buffer()->StrideV(),
+                      source->width(), source->height(),
+                      dst_buffer->MutableDataY(), dst_buffer->StrideY(),
+                      dst_buffer->MutableDataU(), dst_buffer->StrideU(),
+                      dst_buffer->MutableDataV(), dst_buffer->StrideV(),
+                      dst_width, dst_height,
+                      libyuv::kFilterBilinear);
+    stream_encode.scaled_frame =
+        VideoFrame(dst_buffer, input_image.timestamp(),
+                   input_image.render_time_ms(), webrtc::kVideoRotation_0);
+    stream_encode.frame = &stream_encode.scaled_frame;
+    // Only scale down from here; an upscaled frame has no more detail than
+    // the input.
+    if (Pixels(dst_width, dst_height) < Pixels(src_width, src_height))
+      source = stream_encode.frame;
   }
+}
 
-  return WEBRTC_VIDEO_CODEC_OK;
+void SimulcastEncoderAdapter::EncodeStreams(
+    const std::vector<size_t>& streams,
+    const CodecSpecificInfo* codec_specific_info) {
+  for (size_t stream_idx : streams) {
+    StreamEncode& stream_encode = stream_encodes_[stream_idx];
+    stream_encode.result = streaminfos_[stream_idx].encoder->Encode(
+        *stream_encode.frame, codec_specific_info, &stream_encode.frame_types);
+  }
+}
+
+void SimulcastEncoderAdapter::ReleaseScaledFrames() {
+  for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
+    stream_encodes_[stream_idx].frame = nullptr;
+    stream_encodes_[stream_idx].scaled_frame = VideoFrame();
+  }
 }
 
 int SimulcastEncoderAdapter::RegisterEncodeCompleteCallback(
@@ -412,6 +525,19 @@ EncodedImageCallback::Result SimulcastEncoderAdapter::OnEncodedImage(
   CodecSpecificInfoVP8* vp8Info = &(stream_codec_specific.codecSpecific.VP8);
   vp8Info->simulcastIdx = stream_idx;
 
+  StreamEncode& stream_encode = stream_encodes_[stream_idx];
+  if (stream_encode.collecting) {
+    PendingImage pending;
+    pending.encoded_image = encodedImage;
+    pending.codec_specific_info = stream_codec_specific;
+    if (fragmentation) {
+      pending.fragmentation.reset(new RTPFragmentationHeader());
+      pending.fragmentation->CopyFrom(*fragmentation);
+    }
+    stream_encode.pending_images.push_back(std::move(pending));
+    return EncodedImageCallback::Result(EncodedImageCallback::Result::OK);
+  }
+
   return encoded_complete_callback_->OnEncodedImage(
       encodedImage, &stream_codec_specific, fragmentation);
 }
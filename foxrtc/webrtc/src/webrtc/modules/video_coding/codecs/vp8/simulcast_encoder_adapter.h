@@ -16,6 +16,8 @@
 #include <string>
 #include <vector>
 
+#include "webrtc/base/fork_join_threads.h"
+#include "webrtc/modules/include/module_common_types.h"
 #include "webrtc/modules/video_coding/codecs/vp8/include/vp8.h"
 
 namespace webrtc {
@@ -33,9 +35,20 @@ class VideoEncoderFactory {
 // webrtc::VideoEncoder instances with the given VideoEncoderFactory.
 // All the public interfaces are expected to be called from the same thread,
 // e.g the encoder thread.
+//
+// Each frame is scaled once per distinct stream resolution, every scale from
+// the smallest larger one already made, so the streams share a downscale
+// pyramid. With more than one encode thread, the streams of a frame are
+// encoded concurrently, and their encoded images are held back and delivered
+// in stream order, on the calling thread, before Encode() returns.
 class SimulcastEncoderAdapter : public VP8Encoder {
  public:
   explicit SimulcastEncoderAdapter(VideoEncoderFactory* factory);
+  // Encodes on up to |num_encode_threads| threads, the calling thread
+  // included. Only images an encoder delivers from within its Encode() are
+  // held back; any delivered later are passed on as they come.
+  SimulcastEncoderAdapter(VideoEncoderFactory* factory,
+                          int num_encode_threads);
   virtual ~SimulcastEncoderAdapter();
 
   // Implements VideoEncoder
@@ -93,6 +106,31 @@ class SimulcastEncoderAdapter : public VP8Encoder {
     bool send_stream;
   };
 
+  // An encoded image of a stream, held back until all streams of the frame
+  // are encoded. The encoded data itself is not copied; it is owned by the
+  // stream's encoder and stays valid until the encoder's next Encode().
+  struct PendingImage {
+    EncodedImage encoded_image;
+    CodecSpecificInfo codec_specific_info;
+    std::unique_ptr<RTPFragmentationHeader> fragmentation;
+  };
+
+  // The encoding of one stream of the current frame.
+  struct StreamEncode {
+    StreamEncode()
+        : frame(nullptr), result(WEBRTC_VIDEO_CODEC_OK), collecting(false) {}
+
+    // The frame to encode: the input frame, |scaled_frame|, or the
+    // |scaled_frame| of another stream with the same resolution.
+    const VideoFrame* frame;
+    VideoFrame scaled_frame;
+    std::vector<FrameType> frame_types;
+    int result;
+    // True while the images of the stream are held back.
+    bool collecting;
+    std::vector<PendingImage> pending_images;
+  };
+
   // Populate the codec settings for each stream.
   void PopulateStreamCodec(const webrtc::VideoCodec* inst,
                            int stream_index,
@@ -102,6 +140,17 @@ class SimulcastEncoderAdapter : public VP8Encoder {
 
   bool Initialized() const;
 
+  // Scales |input_image| to the resolution of every stream in |streams|,
+  // ordered by decreasing resolution, into |stream_encodes_|.
+  void ScaleStreams(const VideoFrame& input_image,
+                    const std::vector<size_t>& streams);
+  // Encodes the streams in |streams| with the frames and frame types in
+  // |stream_encodes_|.
+  void EncodeStreams(const std::vector<size_t>& streams,
+                     const CodecSpecificInfo* codec_specific_info);
+  // Drops the references to the frames of the last Encode().
+  void ReleaseScaledFrames();
+
   std::unique_ptr<VideoEncoderFactory> factory_;
   std::unique_ptr<TemporalLayersFactory> screensharing_tl_factory_;
   VideoCodec codec_;
@@ -109,6 +158,10 @@ class SimulcastEncoderAdapter : public VP8Encoder {
   EncodedImageCallback* encoded_complete_callback_;
   std::string implementation_name_;
   std::unique_ptr<SimulcastRateAllocator> rate_allocator_;
+
+  // One per stream. Not a std::vector, as StreamEncode is not copyable.
+  std::unique_ptr<StreamEncode[]> stream_encodes_;
+  rtc::ForkJoinThreads encode_threads_;
 };
 
 }  // namespace webrtc
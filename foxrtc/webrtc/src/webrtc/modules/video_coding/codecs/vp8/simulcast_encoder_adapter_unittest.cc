@@ -14,6 +14,7 @@
 #include "webrtc/modules/video_coding/codecs/vp8/simulcast_encoder_adapter.h"
 #include "webrtc/modules/video_coding/codecs/vp8/simulcast_unittest.h"
 #include "webrtc/modules/video_coding/include/video_codec_interface.h"
+#include "webrtc/system_wrappers/include/sleep.h"
 #include "webrtc/test/gmock.h"
 
 namespace webrtc {
@@ -209,13 +210,14 @@ class MockVideoEncoderFactory : public VideoEncoderFactory {
 
 class TestSimulcastEncoderAdapterFakeHelper {
  public:
-  TestSimulcastEncoderAdapterFakeHelper()
-      : factory_(new MockVideoEncoderFactory()) {}
+  explicit TestSimulcastEncoderAdapterFakeHelper(int num_encode_threads = 1)
+      : factory_(new MockVideoEncoderFactory()),
+        num_encode_threads_(num_encode_threads) {}
 
   // Can only be called once as the SimulcastEncoderAdapter will take the
   // ownership of |factory_|.
   VP8Encoder* CreateMockEncoderAdapter() {
-    return new SimulcastEncoderAdapter(factory_);
+    return new SimulcastEncoderAdapter(factory_, num_encode_threads_);
   }
 
   void ExpectCallSetChannelParameters(uint32_t packetLoss, int64_t rtt) {
@@ -231,6 +233,7 @@ class TestSimulcastEncoderAdapterFakeHelper {
 
  private:
   MockVideoEncoderFactory* factory_;
+  const int num_encode_threads_;
 };
 
 static const int kTestTemporalLayerProfile[3] = {3, 2, 1};
@@ -545,5 +548,151 @@ TEST_F(TestSimulcastEncoderAdapterFake, TestFailureReturnCodesFromEncodeCalls) {
             adapter_->Encode(input_frame, nullptr, &frame_types));
 }
 
+class TestSimulcastEncoderAdapterFakeParallel
+    : public TestSimulcastEncoderAdapterFake {
+ public:
+  TestSimulcastEncoderAdapterFakeParallel() {
+    helper_.reset(new TestSimulcastEncoderAdapterFakeHelper(3));
+    adapter_.reset(helper_->CreateMockEncoderAdapter());
+  }
+
+  Result OnEncodedImage(const EncodedImage& encoded_image,
+                        const CodecSpecificInfo* codec_specific_info,
+                        const RTPFragmentationHeader* fragmentation) override {
+    delivered_simulcast_indices_.push_back(
+        codec_specific_info->codecSpecific.VP8.simulcastIdx);
+    return TestSimulcastEncoderAdapterFake::OnEncodedImage(
+        encoded_image, codec_specific_info, fragmentation);
+  }
+
+ protected:
+  std::vector<int> delivered_simulcast_indices_;
+};
+
+TEST_F(TestSimulcastEncoderAdapterFakeParallel, DeliversInStreamOrder) {
+  TestVp8Simulcast::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile));
+  // High start bitrate, so all streams are enabled.
+  codec_.startBitrate = 3000;
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, 1, 1200));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+
+  // Each encoder sends an image of the size it was given. The lowest stream
+  // takes the longest, so that it would be delivered last if the images were
+  // not held back.
+  for (int i = 0; i < 3; ++i) {
+    MockVideoEncoder* encoder = helper_->factory()->encoders()[i];
+    EXPECT_CALL(*encoder, Encode(_, _, _))
+        .Times(2)
+        .WillRepeatedly(::testing::Invoke(
+            [encoder, i](const VideoFrame& frame,
+                         const CodecSpecificInfo* codec_specific_info,
+                         const std::vector<FrameType>* frame_types) {
+              if (i == 0)
+                SleepMs(20);
+              encoder->SendEncodedImage(frame.width(), frame.height());
+              return 0;
+            }));
+  }
+
+  int half_width = (kDefaultWidth + 1) / 2;
+  rtc::scoped_refptr<I420Buffer> input_buffer = I420Buffer::Create(
+      kDefaultWidth, kDefaultHeight, kDefaultWidth, half_width, half_width);
+  input_buffer->InitializeData();
+  VideoFrame input_frame(input_buffer, 0, 0, webrtc::kVideoRotation_0);
+  std::vector<FrameType> frame_types(3, kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, nullptr, &frame_types));
+  EXPECT_EQ(0, adapter_->Encode(input_frame, nullptr, &frame_types));
+
+  EXPECT_EQ(std::vector<int>({0, 1, 2, 0, 1, 2}),
+            delivered_simulcast_indices_);
+  // The last image is of the highest stream, at its own resolution.
+  int width;
+  int height;
+  int simulcast_index;
+  EXPECT_TRUE(GetLastEncodedImageInfo(&width, &height, &simulcast_index));
+  EXPECT_EQ(codec_.simulcastStream[2].width, width);
+  EXPECT_EQ(codec_.simulcastStream[2].height, height);
+}
+
+TEST_F(TestSimulcastEncoderAdapterFakeParallel,
+       ScalesEveryStreamToItsResolution) {
+  TestVp8Simulcast::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile));
+  codec_.startBitrate = 3000;
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, 1, 1200));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_CALL(*helper_->factory()->encoders()[i],
+                Encode(AllOf(::testing::Property(
+                                 &VideoFrame::width,
+                                 codec_.simulcastStream[i].width),
+                             ::testing::Property(
+                                 &VideoFrame::height,
+                                 codec_.simulcastStream[i].height)),
+                       _, _))
+        .Times(1);
+  }
+
+  int half_width = (kDefaultWidth + 1) / 2;
+  rtc::scoped_refptr<I420Buffer> input_buffer = I420Buffer::Create(
+      kDefaultWidth, kDefaultHeight, kDefaultWidth, half_width, half_width);
+  input_buffer->InitializeData();
+  VideoFrame input_frame(input_buffer, 0, 0, webrtc::kVideoRotation_0);
+  std::vector<FrameType> frame_types(3, kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, nullptr, &frame_types));
+}
+
+TEST_F(TestSimulcastEncoderAdapterFakeParallel,
+       DeliversOtherStreamsWhenOneFails) {
+  TestVp8Simulcast::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile));
+  codec_.startBitrate = 3000;
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, 1, 1200));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+
+  // The middle stream fails on the first frame only.
+  std::vector<std::vector<FrameType>> stream_frame_types(3);
+  for (int i = 0; i < 3; ++i) {
+    MockVideoEncoder* encoder = helper_->factory()->encoders()[i];
+    std::vector<FrameType>* frame_types = &stream_frame_types[i];
+    EXPECT_CALL(*encoder, Encode(_, _, _))
+        .Times(2)
+        .WillRepeatedly(::testing::Invoke(
+            [encoder, i, frame_types](
+                const VideoFrame& frame,
+                const CodecSpecificInfo* codec_specific_info,
+                const std::vector<FrameType>* types) {
+              frame_types->push_back(types->at(0));
+              if (i == 1 && frame_types->size() == 1)
+                return WEBRTC_VIDEO_CODEC_ERROR;
+              encoder->SendEncodedImage(frame.width(), frame.height());
+              return WEBRTC_VIDEO_CODEC_OK;
+            }));
+  }
+
+  int half_width = (kDefaultWidth + 1) / 2;
+  rtc::scoped_refptr<I420Buffer> input_buffer = I420Buffer::Create(
+      kDefaultWidth, kDefaultHeight, kDefaultWidth, half_width, half_width);
+  input_buffer->InitializeData();
+  VideoFrame input_frame(input_buffer, 0, 0, webrtc::kVideoRotation_0);
+  std::vector<FrameType> frame_types(3, kVideoFrameDelta);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_ERROR,
+            adapter_->Encode(input_frame, nullptr, &frame_types));
+  EXPECT_EQ(std::vector<int>({0, 2}), delivered_simulcast_indices_);
+
+  // The failed stream asks for a key frame, which all streams then send.
+  EXPECT_EQ(0, adapter_->Encode(input_frame, nullptr, &frame_types));
+  EXPECT_EQ(std::vector<int>({0, 2, 0, 1, 2}), delivered_simulcast_indices_);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(
+        std::vector<FrameType>({kVideoFrameDelta, kVideoFrameKey}),
+        stream_frame_types[i]);
+  }
+}
+
 }  // namespace testing
 }  // namespace webrtc
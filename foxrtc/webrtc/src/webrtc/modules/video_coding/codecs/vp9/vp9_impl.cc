@@ -14,6 +14,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <algorithm>
 #include <vector>
 
 #include "vpx/vpx_encoder.h"
@@ -32,6 +33,15 @@
 
 namespace webrtc {
 
+namespace {
+// libvpx tile columns are at least 256 pixels wide.
+const int kMinTileWidth = 256;
+// Real-time encoding gains little from more than 8 tile columns.
+const int kMaxEncoderThreads = 8;
+// Tile and frame threads beyond this mostly add memory and latency.
+const int kMaxDecoderThreads = 8;
+}  // namespace
+
 // Only positive speeds, range for real-time coding currently is: 5 - 8.
 // Lower means slower/better quality, higher means fastest/lower quality.
 int GetCpuSpeed(int width, int height) {
@@ -399,16 +409,20 @@ int VP9EncoderImpl::InitEncode(const VideoCodec* inst,
 int VP9EncoderImpl::NumberOfThreads(int width,
                                     int height,
                                     int number_of_cores) {
-  // Keep the number of encoder threads equal to the possible number of column
-  // tiles, which is (1, 2, 4, 8). See comments below for VP9E_SET_TILE_COLUMNS.
-  if (width * height >= 1280 * 720 && number_of_cores > 4) {
-    return 4;
-  } else if (width * height >= 640 * 480 && number_of_cores > 2) {
-    return 2;
-  } else {
-    // 1 thread less than VGA.
-    return 1;
-  }
+  // Each encoder thread works on its own tile column, so the thread count is
+  // the largest power of two (1, 2, 4, 8) that fits both the available cores
+  // and the frame width (a tile column is at least 256 pixels wide, see
+  // VP9E_SET_TILE_COLUMNS below). An explicit |numberOfThreads| replaces the
+  // core count.
+  int max_threads = codec_.codecSpecific.VP9.numberOfThreads > 0
+                        ? codec_.codecSpecific.VP9.numberOfThreads
+                        : number_of_cores;
+  if (max_threads > kMaxEncoderThreads)
+    max_threads = kMaxEncoderThreads;
+  int threads = 1;
+  while (threads * 2 <= max_threads && threads * 2 * kMinTileWidth <= width)
+    threads *= 2;
+  return threads;
 }
 
 int VP9EncoderImpl::InitAndSetControlSettings(const VideoCodec* inst) {
@@ -480,7 +494,10 @@ int VP9EncoderImpl::InitAndSetControlSettings(const VideoCodec* inst) {
   // The number tile columns will be capped by the encoder based on image size
   // (minimum width of tile column is 256 pixels, maximum is 4096).
   LOG(LS_INFO) << "config_->g_threads = " << config_->g_threads;
-  vpx_codec_control(encoder_, VP9E_SET_TILE_COLUMNS, (config_->g_threads >> 1));
+  int log2_tile_columns = 0;
+  while ((2 << log2_tile_columns) <= static_cast<int>(config_->g_threads))
+    ++log2_tile_columns;
+  vpx_codec_control(encoder_, VP9E_SET_TILE_COLUMNS, log2_tile_columns);
 #if !defined(WEBRTC_ARCH_ARM) && !defined(WEBRTC_ARCH_ARM64) && \
   !defined(ANDROID)
   // Note denoiser is still off by default until further testing/optimization,
@@ -903,8 +920,10 @@ VP9DecoderImpl::VP9DecoderImpl()
     : decode_complete_callback_(NULL),
       inited_(false),
       decoder_(NULL),
-      key_frame_required_(true) {
+      key_frame_required_(true),
+      next_pending_frame_(0) {
   memset(&codec_, 0, sizeof(codec_));
+  memset(pending_frames_, 0, sizeof(pending_frames_));
 }
 
 VP9DecoderImpl::~VP9DecoderImpl() {
@@ -932,10 +951,21 @@ int VP9DecoderImpl::InitDecode(const VideoCodec* inst, int number_of_cores) {
     decoder_ = new vpx_codec_ctx_t;
   }
   vpx_codec_dec_cfg_t cfg;
-  // Setting number of threads to a constant value (1)
-  cfg.threads = 1;
+  // Threads decode tile columns of a frame in parallel or, in frame-parallel
+  // mode, consecutive frames. Every receive stream has a decoder of its own,
+  // so one thread each unless configured otherwise, rather than one per core.
+  int threads = std::max(1, std::min(inst->codecSpecific.VP9.numberOfThreads,
+                                     kMaxDecoderThreads));
+  cfg.threads = threads;
   cfg.h = cfg.w = 0;  // set after decode
   vpx_codec_flags_t flags = 0;
+  if (inst->codecSpecific.VP9.frameParallelDecoding && threads > 1 &&
+      (vpx_codec_get_caps(vpx_codec_vp9_dx()) &
+       VPX_CODEC_CAP_FRAME_THREADING)) {
+    flags |= VPX_CODEC_USE_FRAME_THREADING;
+  }
+  LOG(LS_INFO) << "VP9 decoder threads = " << threads << ", frame parallel = "
+               << ((flags & VPX_CODEC_USE_FRAME_THREADING) != 0);
   if (vpx_codec_dec_init(decoder_, vpx_codec_vp9_dx(), &cfg, flags)) {
     return WEBRTC_VIDEO_CODEC_MEMORY;
   }
@@ -982,22 +1012,34 @@ int VP9DecoderImpl::Decode(const EncodedImage& input_image,
   if (input_image._length == 0) {
     buffer = NULL;  // Triggers full frame concealment.
   }
+  // Frame-parallel decoding returns frames a few calls later, so the
+  // timestamps travel through libvpx as |user_priv|.
+  PendingFrame* pending_frame = &pending_frames_[next_pending_frame_];
+  next_pending_frame_ = (next_pending_frame_ + 1) % kMaxPendingFrames;
+  pending_frame->timestamp = input_image._timeStamp;
+  pending_frame->ntp_time_ms = input_image.ntp_time_ms_;
   // During decode libvpx may get and release buffers from |frame_buffer_pool_|.
-  // In practice libvpx keeps a few (~3-4) buffers alive at a time.
+  // In practice libvpx keeps a few (~3-4) buffers alive at a time, plus one
+  // per frame thread.
   if (vpx_codec_decode(decoder_, buffer,
-                       static_cast<unsigned int>(input_image._length), 0,
-                       VPX_DL_REALTIME)) {
+                       static_cast<unsigned int>(input_image._length),
+                       pending_frame, VPX_DL_REALTIME)) {
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
   // |img->fb_priv| contains the image data, a reference counted Vp9FrameBuffer.
   // It may be released by libvpx during future vpx_codec_decode or
   // vpx_codec_destroy calls.
-  img = vpx_codec_get_frame(decoder_, &iter);
-  int ret = ReturnFrame(img, input_image._timeStamp, input_image.ntp_time_ms_);
-  if (ret != 0) {
-    return ret;
+  int ret = WEBRTC_VIDEO_CODEC_NO_OUTPUT;
+  while ((img = vpx_codec_get_frame(decoder_, &iter)) != NULL) {
+    const PendingFrame* frame = static_cast<const PendingFrame*>(img->user_priv);
+    if (frame == NULL)
+      frame = pending_frame;
+    ret = ReturnFrame(img, frame->timestamp, frame->ntp_time_ms);
+    if (ret != 0) {
+      return ret;
+    }
   }
-  return WEBRTC_VIDEO_CODEC_OK;
+  return ret;
 }
 
 int VP9DecoderImpl::ReturnFrame(const vpx_image_t* img,
@@ -166,6 +166,16 @@ class VP9DecoderImpl : public VP9Decoder {
   vpx_codec_ctx_t* decoder_;
   VideoCodec codec_;
   bool key_frame_required_;
+
+  // Timestamps of the frames handed to libvpx, passed as |user_priv| and
+  // read back from the decoded image. Must outlast the frame-thread pipeline.
+  struct PendingFrame {
+    uint32_t timestamp;
+    int64_t ntp_time_ms;
+  };
+  static const size_t kMaxPendingFrames = 16;
+  PendingFrame pending_frames_[kMaxPendingFrames];
+  size_t next_pending_frame_;
 };
 }  // namespace webrtc
 
@@ -31,6 +31,7 @@ RtpFrameObject::RtpFrameObject(PacketBuffer* packet_buffer,
     : packet_buffer_(packet_buffer),
       first_seq_num_(first_seq_num),
       last_seq_num_(last_seq_num),
+      timestamp_(0),
       received_time_(received_time),
       times_nacked_(times_nacked) {
   size = frame_size;
@@ -52,6 +53,7 @@ RtpFrameObject::RtpFrameObject(PacketBuffer* packet_buffer,
     // RtpFrameObject members
     frame_type_ = packet->frameType;
     codec_type_ = packet->codec;
+    timestamp_ = packet->timestamp;
 
     // FrameObject members
     timestamp = packet->timestamp;
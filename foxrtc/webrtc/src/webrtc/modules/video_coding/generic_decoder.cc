@@ -79,6 +79,7 @@ int32_t VCMDecodedFrameCallback::Decoded(VideoFrame& decodedImage,
   // TODO(sakal): Investigate why callback is NULL sometimes and replace if
   // statement with a DCHECK.
   if (callback) {
+    callback->OnFrameDecodeTime(static_cast<int>(decode_time_ms));
     callback->FrameToRender(decodedImage);
   } else {
     LOG(LS_WARNING) << "No callback, dropping frame.";
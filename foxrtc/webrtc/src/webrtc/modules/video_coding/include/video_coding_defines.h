@@ -68,6 +68,8 @@ class VCMReceiveCallback {
   // Called when the current receive codec changes.
   virtual void OnIncomingPayloadType(int payload_type) {}
   virtual void OnDecoderImplementationName(const char* implementation_name) {}
+  // Called with the time it took to decode each frame, before FrameToRender.
+  virtual void OnFrameDecodeTime(int decode_time_ms) {}
 
  protected:
   virtual ~VCMReceiveCallback() {}
@@ -0,0 +1,210 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/random.h"
+#include "webrtc/base/refcount.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/video_coding/frame_object.h"
+#include "webrtc/modules/video_coding/nack_module.h"
+#include "webrtc/modules/video_coding/packet_buffer.h"
+#include "webrtc/modules/video_coding/rtp_frame_reference_finder.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+using video_coding::FrameObject;
+using video_coding::OnCompleteFrameCallback;
+using video_coding::PacketBuffer;
+using video_coding::RtpFrameObject;
+using video_coding::RtpFrameReferenceFinder;
+
+constexpr int kNumPackets = 200000;
+constexpr int kPacketsPerMs = 2;
+constexpr int kProcessIntervalMs = 20;
+// How far behind a reordered packet may arrive.
+constexpr int kMaxReorderDistance = 30;
+
+class NullNackSender : public NackSender, public KeyFrameRequestSender {
+ public:
+  void SendNack(const std::vector<uint16_t>& sequence_numbers) override {
+    num_nacked_ += sequence_numbers.size();
+  }
+  void RequestKeyFrame() override { ++num_keyframe_requests_; }
+
+  size_t num_nacked_ = 0;
+  int num_keyframe_requests_ = 0;
+};
+
+// Builds the arrival order of a packet stream where every packet is lost
+// with |loss_percent| probability, and the rest arrive up to
+// |kMaxReorderDistance| packets late with |reorder_percent| probability.
+// Returns the sequence numbers in arrival order.
+std::vector<uint16_t> MakeLossyStream(int loss_percent,
+                                      int reorder_percent,
+                                      Random* random) {
+  std::vector<std::pair<int, uint16_t>> arrivals;
+  for (int i = 0; i < kNumPackets; ++i) {
+    if (static_cast<int>(random->Rand(0, 99)) < loss_percent)
+      continue;
+    int delay = 0;
+    if (static_cast<int>(random->Rand(0, 99)) < reorder_percent)
+      delay = random->Rand(1, kMaxReorderDistance);
+    arrivals.push_back(std::make_pair(i + delay, static_cast<uint16_t>(i)));
+  }
+  std::stable_sort(arrivals.begin(), arrivals.end(),
+                   [](const std::pair<int, uint16_t>& a,
+                      const std::pair<int, uint16_t>& b) {
+                     return a.first < b.first;
+                   });
+  std::vector<uint16_t> seq_nums;
+  for (const auto& arrival : arrivals)
+    seq_nums.push_back(arrival.second);
+  return seq_nums;
+}
+
+void RunNackModule(int loss_percent, int reorder_percent) {
+  Random random(0x5eed);
+  std::vector<uint16_t> seq_nums =
+      MakeLossyStream(loss_percent, reorder_percent, &random);
+  SimulatedClock clock(0);
+  NullNackSender sender;
+  NackModule nack_module(&clock, &sender, &sender);
+  nack_module.UpdateRtt(50);
+
+  VCMPacket packet;
+  int64_t start_us = rtc::TimeMicros();
+  for (size_t i = 0; i < seq_nums.size(); ++i) {
+    packet.seqNum = seq_nums[i];
+    packet.isFirstPacket = seq_nums[i] % 3000 == 0;
+    packet.frameType =
+        packet.isFirstPacket ? kVideoFrameKey : kVideoFrameDelta;
+    nack_module.OnReceivedPacket(packet);
+    if (i % kPacketsPerMs == 0) {
+      clock.AdvanceTimeMilliseconds(1);
+      if (clock.TimeInMilliseconds() % kProcessIntervalMs == 0)
+        nack_module.Process();
+    }
+  }
+  int64_t elapsed_us = rtc::TimeMicros() - start_us;
+
+  const std::string modifier = "_" + std::to_string(loss_percent) +
+                               "_loss_" + std::to_string(reorder_percent) +
+                               "_reorder";
+  webrtc::test::PrintResult(
+      "nack_module_packet_cost", modifier, "NackModule",
+      static_cast<double>(elapsed_us) * 1000 / seq_nums.size(), "ns", true);
+}
+
+// Keeps the one packet per frame that RtpFrameObject reads its codec header
+// from, without allocating.
+class RingPacketBuffer : public PacketBuffer {
+ public:
+  RingPacketBuffer() : PacketBuffer(nullptr, 0, 0, nullptr) {}
+
+  VCMPacket* GetPacket(uint16_t seq_num) override {
+    return &packets_[seq_num % kSize];
+  }
+  bool InsertPacket(const VCMPacket& packet) override {
+    packets_[packet.seqNum % kSize] = packet;
+    return true;
+  }
+  bool GetBitstream(const RtpFrameObject& frame,
+                    uint8_t* destination) override {
+    return true;
+  }
+  void ReturnFrame(RtpFrameObject* frame) override {}
+
+ private:
+  static const size_t kSize = 1024;
+  VCMPacket packets_[kSize];
+};
+
+class CountingFrameCallback : public OnCompleteFrameCallback {
+ public:
+  void OnCompleteFrame(std::unique_ptr<FrameObject> frame) override {
+    ++num_completed_;
+  }
+  int num_completed_ = 0;
+};
+
+// Feeds VP8 frames with three temporal layers, one packet each, through the
+// reference finder. Frames are lost and reordered like the packets above,
+// which makes the finder stash frames and track not yet received ones.
+void RunReferenceFinder(int loss_percent, int reorder_percent) {
+  Random random(0xf00d);
+  std::vector<uint16_t> frame_order =
+      MakeLossyStream(loss_percent, reorder_percent, &random);
+  rtc::scoped_refptr<RingPacketBuffer> packet_buffer(
+      new rtc::RefCountedObject<RingPacketBuffer>());
+  CountingFrameCallback callback;
+  RtpFrameReferenceFinder reference_finder(&callback);
+  const uint8_t kTemporalPattern[] = {0, 2, 1, 2};
+
+  int64_t start_us = rtc::TimeMicros();
+  for (uint16_t frame_num : frame_order) {
+    VCMPacket packet;
+    packet.codec = kVideoCodecVP8;
+    packet.seqNum = frame_num;
+    packet.frameType = frame_num % 1000 == 0 ? kVideoFrameKey
+                                             : kVideoFrameDelta;
+    RTPVideoHeaderVP8& vp8 = packet.video_header.codecHeader.VP8;
+    vp8.InitRTPVideoHeaderVP8();
+    vp8.pictureId = frame_num % (1 << 15);
+    vp8.temporalIdx = kTemporalPattern[frame_num % 4];
+    vp8.tl0PicIdx = static_cast<uint8_t>(frame_num / 4);
+    vp8.layerSync = false;
+    packet_buffer->InsertPacket(packet);
+    std::unique_ptr<RtpFrameObject> frame(new RtpFrameObject(
+        packet_buffer, frame_num, frame_num, 0, 0, 0));
+    reference_finder.ManageFrame(std::move(frame));
+  }
+  int64_t elapsed_us = rtc::TimeMicros() - start_us;
+
+  const std::string modifier = "_" + std::to_string(loss_percent) +
+                               "_loss_" + std::to_string(reorder_percent) +
+                               "_reorder";
+  webrtc::test::PrintResult(
+      "reference_finder_frame_cost", modifier, "RtpFrameReferenceFinder",
+      static_cast<double>(elapsed_us) * 1000 / frame_order.size(), "ns",
+      true);
+  EXPECT_GT(callback.num_completed_, 0);
+}
+
+}  // namespace
+
+TEST(LossyStreamPerformanceTest, NackModule) {
+  for (int loss_percent : {0, 5, 20}) {
+    for (int reorder_percent : {0, 10, 30}) {
+      SCOPED_TRACE(loss_percent);
+      SCOPED_TRACE(reorder_percent);
+      RunNackModule(loss_percent, reorder_percent);
+    }
+  }
+}
+
+TEST(LossyStreamPerformanceTest, RtpFrameReferenceFinder) {
+  for (int loss_percent : {0, 5, 20}) {
+    for (int reorder_percent : {0, 10, 30}) {
+      SCOPED_TRACE(loss_percent);
+      SCOPED_TRACE(reorder_percent);
+      RunReferenceFinder(loss_percent, reorder_percent);
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -15,13 +15,12 @@
 
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
+#include "webrtc/base/optional.h"
 #include "webrtc/modules/utility/include/process_thread.h"
 
 namespace webrtc {
 
 namespace {
-const int kMaxPacketAge = 10000;
-const int kMaxNackPackets = 1000;
 const int kDefaultRttMs = 100;
 const int kMaxNackRetries = 10;
 const int kProcessFrequency = 50;
@@ -71,7 +70,7 @@ int NackModule::OnReceivedPacket(const VCMPacket& packet) {
   if (!initialized_) {
     newest_seq_num_ = seq_num;
     if (is_keyframe)
-      keyframe_list_.insert(seq_num);
+      keyframe_list_.Insert(seq_num);
     initialized_ = true;
     return 0;
   }
@@ -83,11 +82,12 @@ int NackModule::OnReceivedPacket(const VCMPacket& packet) {
 
   if (AheadOf(newest_seq_num_, seq_num)) {
     // An out of order packet has been received.
-    auto nack_list_it = nack_list_.find(seq_num);
+    NackInfo* nack_info = nack_list_.Find(seq_num);
     int nacks_sent_for_packet = 0;
-    if (nack_list_it != nack_list_.end()) {
-      nacks_sent_for_packet = nack_list_it->second.retries;
-      nack_list_.erase(nack_list_it);
+    if (nack_info) {
+      nacks_sent_for_packet = nack_info->retries;
+      nack_list_.Erase(seq_num);
+      not_yet_nacked_.Erase(seq_num);
     }
     if (!is_retransmitted)
       UpdateReorderingStatistics(seq_num);
@@ -96,14 +96,13 @@ int NackModule::OnReceivedPacket(const VCMPacket& packet) {
   AddPacketsToNack(newest_seq_num_ + 1, seq_num);
   newest_seq_num_ = seq_num;
 
-  // Keep track of new keyframes.
-  if (is_keyframe)
-    keyframe_list_.insert(seq_num);
+  // Remove old keyframes so we don't accumulate them, which also keeps
+  // |keyframe_list_| within its window.
+  keyframe_list_.EraseOlderThan(seq_num - kMaxPacketAge);
 
-  // And remove old ones so we don't accumulate keyframes.
-  auto it = keyframe_list_.lower_bound(seq_num - kMaxPacketAge);
-  if (it != keyframe_list_.begin())
-    keyframe_list_.erase(keyframe_list_.begin(), it);
+  // And keep track of new ones.
+  if (is_keyframe)
+    keyframe_list_.Insert(seq_num);
 
   // Are there any nacks that are waiting for this seq_num.
   std::vector<uint16_t> nack_batch = GetNackBatch(kSeqNumOnly);
@@ -115,9 +114,9 @@ int NackModule::OnReceivedPacket(const VCMPacket& packet) {
 
 void NackModule::ClearUpTo(uint16_t seq_num) {
   rtc::CritScope lock(&crit_);
-  nack_list_.erase(nack_list_.begin(), nack_list_.lower_bound(seq_num));
-  keyframe_list_.erase(keyframe_list_.begin(),
-                       keyframe_list_.lower_bound(seq_num));
+  nack_list_.EraseOlderThan(seq_num);
+  not_yet_nacked_.EraseOlderThan(seq_num);
+  keyframe_list_.EraseOlderThan(seq_num);
 }
 
 void NackModule::UpdateRtt(int64_t rtt_ms) {
@@ -127,8 +126,9 @@ void NackModule::UpdateRtt(int64_t rtt_ms) {
 
 void NackModule::Clear() {
   rtc::CritScope lock(&crit_);
-  nack_list_.clear();
-  keyframe_list_.clear();
+  nack_list_.Clear();
+  not_yet_nacked_.Clear();
+  keyframe_list_.Clear();
 }
 
 void NackModule::Stop() {
@@ -167,19 +167,21 @@ void NackModule::Process() {
 
 bool NackModule::RemovePacketsUntilKeyFrame() {
   while (!keyframe_list_.empty()) {
-    auto it = nack_list_.lower_bound(*keyframe_list_.begin());
+    uint16_t keyframe_seq_num = keyframe_list_.front();
 
-    if (it != nack_list_.begin()) {
+    if (!nack_list_.empty() &&
+        AheadOf(keyframe_seq_num, nack_list_.front())) {
       // We have found a keyframe that actually is newer than at least one
       // packet in the nack list.
-      RTC_DCHECK(it != nack_list_.end());
-      nack_list_.erase(nack_list_.begin(), it);
+      RTC_DCHECK(!AheadOf(keyframe_seq_num, nack_list_.back()));
+      nack_list_.EraseOlderThan(keyframe_seq_num);
+      not_yet_nacked_.EraseOlderThan(keyframe_seq_num);
       return true;
     }
 
     // If this keyframe is so old it does not remove any packets from the list,
     // remove it from the list of keyframes and try the next keyframe.
-    keyframe_list_.erase(keyframe_list_.begin());
+    keyframe_list_.Erase(keyframe_seq_num);
   }
   return false;
 }
@@ -187,8 +189,8 @@ bool NackModule::RemovePacketsUntilKeyFrame() {
 void NackModule::AddPacketsToNack(uint16_t seq_num_start,
                                   uint16_t seq_num_end) {
   // Remove old packets.
-  auto it = nack_list_.lower_bound(seq_num_end - kMaxPacketAge);
-  nack_list_.erase(nack_list_.begin(), it);
+  nack_list_.EraseOlderThan(seq_num_end - kMaxPacketAge);
+  not_yet_nacked_.EraseOlderThan(seq_num_end - kMaxPacketAge);
 
   // If the nack list is too large, remove packets from the nack list until
   // the latest first packet of a keyframe. If the list is still too large,
@@ -200,7 +202,8 @@ void NackModule::AddPacketsToNack(uint16_t seq_num_start,
     }
 
     if (nack_list_.size() + num_new_nacks > kMaxNackPackets) {
-      nack_list_.clear();
+      nack_list_.Clear();
+      not_yet_nacked_.Clear();
       LOG(LS_WARNING) << "NACK list full, clearing NACK"
                          " list and requesting keyframe.";
       keyframe_request_sender_->RequestKeyFrame();
@@ -210,8 +213,9 @@ void NackModule::AddPacketsToNack(uint16_t seq_num_start,
 
   for (uint16_t seq_num = seq_num_start; seq_num != seq_num_end; ++seq_num) {
     NackInfo nack_info(seq_num, seq_num + WaitNumberOfPackets(0.5));
-    RTC_DCHECK(nack_list_.find(seq_num) == nack_list_.end());
-    nack_list_[seq_num] = nack_info;
+    bool inserted = nack_list_.Insert(seq_num, nack_info);
+    RTC_DCHECK(inserted);
+    not_yet_nacked_.Insert(seq_num);
   }
 }
 
@@ -220,37 +224,33 @@ std::vector<uint16_t> NackModule::GetNackBatch(NackFilterOptions options) {
   bool consider_timestamp = options != kSeqNumOnly;
   int64_t now_ms = clock_->TimeInMilliseconds();
   std::vector<uint16_t> nack_batch;
-  auto it = nack_list_.begin();
-  while (it != nack_list_.end()) {
-    if (consider_seq_num && it->second.sent_at_time == -1 &&
-        AheadOrAt(newest_seq_num_, it->second.send_at_seq_num)) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now_ms;
-      if (it->second.retries >= kMaxNackRetries) {
-        LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
-                        << " removed from NACK list due to max retries.";
-        it = nack_list_.erase(it);
-      } else {
-        ++it;
-      }
-      continue;
-    }
-
-    if (consider_timestamp && it->second.sent_at_time + rtt_ms_ <= now_ms) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now_ms;
-      if (it->second.retries >= kMaxNackRetries) {
-        LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
+  // Packets that have been nacked are only resent because of time, so when
+  // the time is not considered only |not_yet_nacked_| has to be walked.
+  const SeqNumSet<uint16_t, kSeqNumWindow>& candidates =
+      consider_timestamp ? nack_list_.keys() : not_yet_nacked_;
+  rtc::Optional<uint16_t> seq_num;
+  if (!candidates.empty())
+    seq_num = rtc::Optional<uint16_t>(candidates.front());
+  while (seq_num) {
+    NackInfo* info = nack_list_.Find(*seq_num);
+    RTC_DCHECK(info);
+    bool send_nack =
+        (consider_seq_num && info->sent_at_time == -1 &&
+         AheadOrAt(newest_seq_num_, info->send_at_seq_num)) ||
+        (consider_timestamp && info->sent_at_time + rtt_ms_ <= now_ms);
+    rtc::Optional<uint16_t> next_seq_num = candidates.FirstAfter(*seq_num);
+    if (send_nack) {
+      nack_batch.emplace_back(info->seq_num);
+      ++info->retries;
+      info->sent_at_time = now_ms;
+      not_yet_nacked_.Erase(*seq_num);
+      if (info->retries >= kMaxNackRetries) {
+        LOG(LS_WARNING) << "Sequence number " << info->seq_num
                         << " removed from NACK list due to max retries.";
-        it = nack_list_.erase(it);
-      } else {
-        ++it;
+        nack_list_.Erase(*seq_num);
       }
-      continue;
     }
-    ++it;
+    seq_num = next_seq_num;
   }
   return nack_batch;
 }
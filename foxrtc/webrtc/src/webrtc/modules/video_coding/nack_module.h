@@ -11,9 +11,7 @@
 #ifndef WEBRTC_MODULES_VIDEO_CODING_NACK_MODULE_H_
 #define WEBRTC_MODULES_VIDEO_CODING_NACK_MODULE_H_
 
-#include <map>
 #include <vector>
-#include <set>
 
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/thread_annotations.h"
@@ -21,6 +19,7 @@
 #include "webrtc/modules/video_coding/include/video_coding_defines.h"
 #include "webrtc/modules/video_coding/packet.h"
 #include "webrtc/modules/video_coding/histogram.h"
+#include "webrtc/modules/video_coding/sequence_number_ring.h"
 #include "webrtc/modules/video_coding/sequence_number_util.h"
 #include "webrtc/system_wrappers/include/clock.h"
 
@@ -43,6 +42,13 @@ class NackModule : public Module {
   void Process() override;
 
  private:
+  // Packets more than |kMaxPacketAge| behind the newest one are not nacked,
+  // so the rings below only have to span |kSeqNumWindow| sequence numbers.
+  static const int kMaxPacketAge = 10000;
+  static const size_t kSeqNumWindow = 1 << 14;
+  static_assert(kSeqNumWindow > kMaxPacketAge, "Window too small.");
+  static const size_t kMaxNackPackets = 1000;
+
   // Which fields to consider when deciding which packet to nack in
   // GetNackBatch.
   enum NackFilterOptions { kSeqNumOnly, kTimeOnly, kSeqNumAndTime };
@@ -82,10 +88,13 @@ class NackModule : public Module {
   NackSender* const nack_sender_;
   KeyFrameRequestSender* const keyframe_request_sender_;
 
-  std::map<uint16_t, NackInfo, DescendingSeqNumComp<uint16_t>> nack_list_
-      GUARDED_BY(crit_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> keyframe_list_
+  SeqNumMap<uint16_t, NackInfo, kSeqNumWindow, kMaxNackPackets> nack_list_
       GUARDED_BY(crit_);
+  SeqNumSet<uint16_t, kSeqNumWindow> keyframe_list_ GUARDED_BY(crit_);
+  // The packets in |nack_list_| that have not been nacked yet. Only these
+  // can be due because of their sequence number, so GetNackBatch(kSeqNumOnly)
+  // which runs for every received packet does not walk the whole list.
+  SeqNumSet<uint16_t, kSeqNumWindow> not_yet_nacked_ GUARDED_BY(crit_);
   video_coding::Histogram reordering_histogram_ GUARDED_BY(crit_);
   bool running_ GUARDED_BY(crit_);
   bool initialized_ GUARDED_BY(crit_);
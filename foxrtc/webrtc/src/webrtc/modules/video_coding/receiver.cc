@@ -130,7 +130,8 @@ void VCMReceiver::TriggerDecoderShutdown() {
 }
 
 VCMEncodedFrame* VCMReceiver::FrameForDecoding(uint16_t max_wait_time_ms,
-                                               bool prefer_late_decoding) {
+                                               bool prefer_late_decoding,
+                                               int64_t* next_decode_time_ms) {
   const int64_t start_time_ms = clock_->TimeInMilliseconds();
   uint32_t frame_timestamp = 0;
   int min_playout_delay_ms = -1;
@@ -196,6 +197,9 @@ VCMEncodedFrame* VCMReceiver::FrameForDecoding(uint16_t max_wait_time_ms,
     uint32_t wait_time_ms =
         timing_->MaxWaitingTime(render_time_ms, clock_->TimeInMilliseconds());
     if (new_max_wait_time < wait_time_ms) {
+      if (next_decode_time_ms) {
+        *next_decode_time_ms = clock_->TimeInMilliseconds() + wait_time_ms;
+      }
       // We're not allowed to wait until the frame is supposed to be rendered,
       // waiting as long as we're allowed to avoid busy looping, and then return
       // NULL. Next call to this function might return the frame.
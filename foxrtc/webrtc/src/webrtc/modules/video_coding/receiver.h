@@ -64,8 +64,11 @@ class VCMReceiver {
   void Reset();
   void UpdateRtt(int64_t rtt);
   int32_t InsertPacket(const VCMPacket& packet);
+  // If a complete frame is buffered but not yet due for decoding, returns
+  // null and sets |*next_decode_time_ms| to when it will be.
   VCMEncodedFrame* FrameForDecoding(uint16_t max_wait_time_ms,
-                                    bool prefer_late_decoding);
+                                    bool prefer_late_decoding,
+                                    int64_t* next_decode_time_ms = nullptr);
   void ReleaseFrame(VCMEncodedFrame* frame);
   void ReceiveStatistics(uint32_t* bitrate, uint32_t* framerate);
   uint32_t DiscardedPackets() const;
@@ -15,6 +15,7 @@
 
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
+#include "webrtc/base/optional.h"
 #include "webrtc/modules/video_coding/frame_object.h"
 #include "webrtc/modules/video_coding/packet_buffer.h"
 
@@ -25,6 +26,8 @@ RtpFrameReferenceFinder::RtpFrameReferenceFinder(
     OnCompleteFrameCallback* frame_callback)
     : last_picture_id_(-1),
       last_unwrap_(-1),
+      stashed_frames_start_(0),
+      num_stashed_frames_(0),
       current_ss_idx_(0),
       cleared_to_seq_num_(-1),
       frame_callback_(frame_callback) {}
@@ -73,14 +76,19 @@ void RtpFrameReferenceFinder::ClearTo(uint16_t seq_num) {
   rtc::CritScope lock(&crit_);
   cleared_to_seq_num_ = seq_num;
 
-  auto it = stashed_frames_.begin();
-  while (it != stashed_frames_.end()) {
-    if (AheadOf<uint16_t>(cleared_to_seq_num_, (*it)->first_seq_num())) {
-      it = stashed_frames_.erase(it);
-    } else {
-      ++it;
+  // Keep the frames that are not cleared, in order.
+  size_t num_kept = 0;
+  for (size_t i = 0; i < num_stashed_frames_; ++i) {
+    std::unique_ptr<RtpFrameObject>& frame =
+        stashed_frames_[(stashed_frames_start_ + i) % kMaxStashedFrames];
+    std::unique_ptr<RtpFrameObject> kept_frame = std::move(frame);
+    if (!AheadOf<uint16_t>(cleared_to_seq_num_, kept_frame->first_seq_num())) {
+      stashed_frames_[(stashed_frames_start_ + num_kept) % kMaxStashedFrames] =
+          std::move(kept_frame);
+      ++num_kept;
     }
   }
+  num_stashed_frames_ = num_kept;
 }
 
 void RtpFrameReferenceFinder::UpdateLastPictureIdWithPadding(uint16_t seq_num) {
@@ -110,22 +118,34 @@ void RtpFrameReferenceFinder::UpdateLastPictureIdWithPadding(uint16_t seq_num) {
 }
 
 void RtpFrameReferenceFinder::RetryStashedFrames() {
-  size_t num_stashed_frames = stashed_frames_.size();
-
-  // Clean up stashed frames if there are too many.
-  while (stashed_frames_.size() > kMaxStashedFrames)
-    stashed_frames_.pop_front();
+  size_t num_stashed_frames = num_stashed_frames_;
 
   // Since frames are stashed if there is not enough data to determine their
-  // frame references we should at most check |stashed_frames_.size()| in
+  // frame references we should at most check |num_stashed_frames_| frames in
   // order to not pop and push frames in and endless loop.
   // NOTE! This function may be called recursively, hence the
-  //       "!stashed_frames_.empty()" condition.
-  for (size_t i = 0; i < num_stashed_frames && !stashed_frames_.empty(); ++i) {
-    std::unique_ptr<RtpFrameObject> frame = std::move(stashed_frames_.front());
-    stashed_frames_.pop_front();
-    ManageFrame(std::move(frame));
-  }
+  //       "num_stashed_frames_ > 0" condition.
+  for (size_t i = 0; i < num_stashed_frames && num_stashed_frames_ > 0; ++i)
+    ManageFrame(PopStashedFrame());
+}
+
+void RtpFrameReferenceFinder::StashFrame(
+    std::unique_ptr<RtpFrameObject> frame) {
+  // Clean up the oldest stashed frame if there are too many.
+  if (num_stashed_frames_ == kMaxStashedFrames)
+    PopStashedFrame();
+  stashed_frames_[(stashed_frames_start_ + num_stashed_frames_) %
+                  kMaxStashedFrames] = std::move(frame);
+  ++num_stashed_frames_;
+}
+
+std::unique_ptr<RtpFrameObject> RtpFrameReferenceFinder::PopStashedFrame() {
+  RTC_DCHECK_GT(num_stashed_frames_, 0u);
+  std::unique_ptr<RtpFrameObject> frame =
+      std::move(stashed_frames_[stashed_frames_start_]);
+  stashed_frames_start_ = (stashed_frames_start_ + 1) % kMaxStashedFrames;
+  --num_stashed_frames_;
+  return frame;
 }
 
 void RtpFrameReferenceFinder::ManageFrameGeneric(
@@ -152,7 +172,7 @@ void RtpFrameReferenceFinder::ManageFrameGeneric(
 
   // We have received a frame but not yet a keyframe, stash this frame.
   if (last_seq_num_gop_.empty()) {
-    stashed_frames_.push_back(std::move(frame));
+    StashFrame(std::move(frame));
     return;
   }
 
@@ -180,7 +200,7 @@ void RtpFrameReferenceFinder::ManageFrameGeneric(
   if (frame->frame_type() == kVideoFrameDelta) {
     uint16_t prev_seq_num = frame->first_seq_num() - 1;
     if (prev_seq_num != last_picture_id_with_padding_gop) {
-      stashed_frames_.push_back(std::move(frame));
+      StashFrame(std::move(frame));
       return;
     }
   }
@@ -231,7 +251,7 @@ void RtpFrameReferenceFinder::ManageFrameVp8(
   if (AheadOf<uint16_t, kPicIdLength>(frame->picture_id, last_picture_id_)) {
     last_picture_id_ = Add<kPicIdLength>(last_picture_id_, 1);
     while (last_picture_id_ != frame->picture_id) {
-      not_yet_received_frames_.insert(last_picture_id_);
+      not_yet_received_frames_.Insert(last_picture_id_);
       last_picture_id_ = Add<kPicIdLength>(last_picture_id_, 1);
     }
   }
@@ -244,9 +264,7 @@ void RtpFrameReferenceFinder::ManageFrameVp8(
   // Clean up info about not yet received frames that are too old.
   uint16_t old_picture_id =
       Subtract<kPicIdLength>(frame->picture_id, kMaxNotYetReceivedFrames);
-  auto clean_frames_to = not_yet_received_frames_.lower_bound(old_picture_id);
-  not_yet_received_frames_.erase(not_yet_received_frames_.begin(),
-                                 clean_frames_to);
+  not_yet_received_frames_.EraseOlderThan(old_picture_id);
 
   if (frame->frame_type() == kVideoFrameKey) {
     frame->num_references = 0;
@@ -261,7 +279,7 @@ void RtpFrameReferenceFinder::ManageFrameVp8(
 
   // If we don't have the base layer frame yet, stash this frame.
   if (layer_info_it == layer_info_.end()) {
-    stashed_frames_.push_back(std::move(frame));
+    StashFrame(std::move(frame));
     return;
   }
 
@@ -294,18 +312,18 @@ void RtpFrameReferenceFinder::ManageFrameVp8(
     // If we have not yet received a previous frame on this temporal layer,
     // stash this frame.
     if (layer_info_it->second[layer] == -1) {
-      stashed_frames_.push_back(std::move(frame));
+      StashFrame(std::move(frame));
       return;
     }
 
     // If we have not yet received a frame between this frame and the referenced
     // frame then we have to wait for that frame to be completed first.
-    auto not_received_frame_it =
-        not_yet_received_frames_.upper_bound(layer_info_it->second[layer]);
-    if (not_received_frame_it != not_yet_received_frames_.end() &&
+    rtc::Optional<uint16_t> not_received_frame =
+        not_yet_received_frames_.FirstAfter(layer_info_it->second[layer]);
+    if (not_received_frame &&
         AheadOf<uint16_t, kPicIdLength>(frame->picture_id,
-                                        *not_received_frame_it)) {
-      stashed_frames_.push_back(std::move(frame));
+                                        *not_received_frame)) {
+      StashFrame(std::move(frame));
       return;
     }
 
@@ -342,7 +360,7 @@ void RtpFrameReferenceFinder::CompletedFrameVp8(
     ++tl0_pic_idx;
     layer_info_it = layer_info_.find(tl0_pic_idx);
   }
-  not_yet_received_frames_.erase(frame->picture_id);
+  not_yet_received_frames_.Erase(frame->picture_id);
 
   for (size_t i = 0; i < frame->num_references; ++i)
     frame->references[i] = UnwrapPictureId(frame->references[i]);
@@ -427,7 +445,7 @@ void RtpFrameReferenceFinder::ManageFrameVp9(
 
   // Gof info for this frame is not available yet, stash this frame.
   if (gof_info_it == gof_info_.end()) {
-    stashed_frames_.push_back(std::move(frame));
+    StashFrame(std::move(frame));
     return;
   }
 
@@ -437,15 +455,12 @@ void RtpFrameReferenceFinder::ManageFrameVp9(
   // Make sure we don't miss any frame that could potentially have the
   // up switch flag set.
   if (MissingRequiredFrameVp9(frame->picture_id, *info)) {
-    stashed_frames_.push_back(std::move(frame));
+    StashFrame(std::move(frame));
     return;
   }
 
-  if (codec_header.temporal_up_switch) {
-    auto pid_tidx =
-        std::make_pair(frame->picture_id, codec_header.temporal_idx);
-    up_switch_.insert(pid_tidx);
-  }
+  if (codec_header.temporal_up_switch)
+    up_switch_.Insert(frame->picture_id, codec_header.temporal_idx);
 
   // If this is a base layer frame that contains a scalability structure
   // then gof info has already been inserted earlier, so we only want to
@@ -457,8 +472,7 @@ void RtpFrameReferenceFinder::ManageFrameVp9(
 
   // Clean out old info about up switch frames.
   uint16_t old_picture_id = Subtract<kPicIdLength>(frame->picture_id, 50);
-  auto up_switch_erase_to = up_switch_.lower_bound(old_picture_id);
-  up_switch_.erase(up_switch_.begin(), up_switch_erase_to);
+  up_switch_.EraseOlderThan(old_picture_id);
 
   size_t diff = ForwardDiff<uint16_t, kPicIdLength>(info->gof->pid_start,
                                                     frame->picture_id);
@@ -496,9 +510,10 @@ bool RtpFrameReferenceFinder::MissingRequiredFrameVp9(uint16_t picture_id,
     uint16_t ref_pid =
         Subtract<kPicIdLength>(picture_id, info.gof->pid_diff[gof_idx][i]);
     for (size_t l = 0; l < temporal_idx; ++l) {
-      auto missing_frame_it = missing_frames_for_layer_[l].lower_bound(ref_pid);
-      if (missing_frame_it != missing_frames_for_layer_[l].end() &&
-          AheadOf<uint16_t, kPicIdLength>(picture_id, *missing_frame_it)) {
+      rtc::Optional<uint16_t> missing_frame =
+          missing_frames_for_layer_[l].FirstAtOrAfter(ref_pid);
+      if (missing_frame &&
+          AheadOf<uint16_t, kPicIdLength>(picture_id, *missing_frame)) {
         return true;
       }
     }
@@ -523,7 +538,7 @@ void RtpFrameReferenceFinder::FrameReceivedVp9(uint16_t picture_id,
       ++gof_idx;
       RTC_DCHECK_NE(0ul, gof_idx % info->gof->num_frames_in_gof);
       size_t temporal_idx = info->gof->temporal_idx[gof_idx];
-      missing_frames_for_layer_[temporal_idx].insert(last_picture_id);
+      missing_frames_for_layer_[temporal_idx].Insert(last_picture_id);
       last_picture_id = Add<kPicIdLength>(last_picture_id, 1);
     }
     info->last_picture_id = last_picture_id;
@@ -532,18 +547,18 @@ void RtpFrameReferenceFinder::FrameReceivedVp9(uint16_t picture_id,
         ForwardDiff<uint16_t, kPicIdLength>(info->gof->pid_start, picture_id);
     size_t gof_idx = diff % info->gof->num_frames_in_gof;
     size_t temporal_idx = info->gof->temporal_idx[gof_idx];
-    missing_frames_for_layer_[temporal_idx].erase(picture_id);
+    missing_frames_for_layer_[temporal_idx].Erase(picture_id);
   }
 }
 
 bool RtpFrameReferenceFinder::UpSwitchInIntervalVp9(uint16_t picture_id,
                                                     uint8_t temporal_idx,
                                                     uint16_t pid_ref) {
-  for (auto up_switch_it = up_switch_.upper_bound(pid_ref);
-       up_switch_it != up_switch_.end() &&
-       AheadOf<uint16_t, kPicIdLength>(picture_id, up_switch_it->first);
-       ++up_switch_it) {
-    if (up_switch_it->second < temporal_idx)
+  for (rtc::Optional<uint16_t> up_switch_pid = up_switch_.FirstAfter(pid_ref);
+       up_switch_pid &&
+       AheadOf<uint16_t, kPicIdLength>(picture_id, *up_switch_pid);
+       up_switch_pid = up_switch_.FirstAfter(*up_switch_pid)) {
+    if (*up_switch_.Find(*up_switch_pid) < temporal_idx)
       return true;
   }
 
@@ -14,13 +14,13 @@
 #include <array>
 #include <map>
 #include <memory>
-#include <deque>
 #include <set>
 #include <utility>
 
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/thread_annotations.h"
 #include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/modules/video_coding/sequence_number_ring.h"
 #include "webrtc/modules/video_coding/sequence_number_util.h"
 
 namespace webrtc {
@@ -84,6 +84,15 @@ class RtpFrameReferenceFinder {
   // all information needed.
   void RetryStashedFrames() EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Add a frame to |stashed_frames_|, dropping the oldest stashed frame if
+  // there already are |kMaxStashedFrames|.
+  void StashFrame(std::unique_ptr<RtpFrameObject> frame)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Remove and return the oldest stashed frame.
+  std::unique_ptr<RtpFrameObject> PopStashedFrame()
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Find references for generic frames. If |picture_id| is unspecified
   // then packet sequence numbers will be used to determine the references
   // of the frames.
@@ -154,12 +163,16 @@ class RtpFrameReferenceFinder {
 
   // Frames earlier than the last received frame that have not yet been
   // fully received.
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t, kPicIdLength>>
-      not_yet_received_frames_ GUARDED_BY(crit_);
+  SeqNumSet<uint16_t, kPicIdLength, kPicIdLength> not_yet_received_frames_
+      GUARDED_BY(crit_);
 
   // Frames that have been fully received but didn't have all the information
-  // needed to determine their references.
-  std::deque<std::unique_ptr<RtpFrameObject>> stashed_frames_ GUARDED_BY(crit_);
+  // needed to determine their references, oldest first starting at
+  // |stashed_frames_start_|.
+  std::array<std::unique_ptr<RtpFrameObject>, kMaxStashedFrames>
+      stashed_frames_ GUARDED_BY(crit_);
+  size_t stashed_frames_start_ GUARDED_BY(crit_);
+  size_t num_stashed_frames_ GUARDED_BY(crit_);
 
   // Holds the information about the last completed frame for a given temporal
   // layer given a Tl0 picture index.
@@ -182,11 +195,11 @@ class RtpFrameReferenceFinder {
 
   // Keep track of which picture id and which temporal layer that had the
   // up switch flag set.
-  std::map<uint16_t, uint8_t, DescendingSeqNumComp<uint16_t, kPicIdLength>>
+  SeqNumMap<uint16_t, uint8_t, kPicIdLength, kPicIdLength, kPicIdLength>
       up_switch_ GUARDED_BY(crit_);
 
   // For every temporal layer, keep a set of which frames that are missing.
-  std::array<std::set<uint16_t, DescendingSeqNumComp<uint16_t, kPicIdLength>>,
+  std::array<SeqNumSet<uint16_t, kPicIdLength, kPicIdLength>,
              kMaxTemporalLayers>
       missing_frames_for_layer_ GUARDED_BY(crit_);
 
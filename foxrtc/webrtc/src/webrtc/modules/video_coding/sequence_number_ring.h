@@ -0,0 +1,305 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_VIDEO_CODING_SEQUENCE_NUMBER_RING_H_
+#define WEBRTC_MODULES_VIDEO_CODING_SEQUENCE_NUMBER_RING_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/optional.h"
+#include "webrtc/modules/video_coding/sequence_number_util.h"
+
+namespace webrtc {
+
+// A set of sequence numbers stored as a bitmap indexed by the sequence number
+// modulo |kWindow|. Use it in place of a std::set ordered by
+// DescendingSeqNumComp when all elements are known to lie within |kWindow|
+// sequence numbers of each other. Insert, erase and lookup are O(1), and
+// nothing is allocated after construction.
+//
+// Elements are ordered from the oldest, front(), to the newest, back().
+// |M| is the length of the sequence number space, where 0 means the full
+// range of |T|. |kWindow| must be a multiple of 64 that divides that length.
+//
+// WARNING! Inserting an element more than |kWindow| - 1 sequence numbers away
+//          from front() or back() is not allowed. Use EraseOlderThan() first.
+template <typename T, size_t kWindow, T M = 0>
+class SeqNumSet {
+ public:
+  SeqNumSet() : size_(0), oldest_(0), newest_(0) { Clear(); }
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  // The oldest and the newest element. The set must not be empty.
+  T front() const {
+    RTC_DCHECK(!empty());
+    return oldest_;
+  }
+  T back() const {
+    RTC_DCHECK(!empty());
+    return newest_;
+  }
+
+  bool Contains(T seq_num) const {
+    return !empty() &&
+           Diff(oldest_, seq_num) <= Diff(oldest_, newest_) &&
+           IsSet(Index(seq_num));
+  }
+
+  // Returns false if |seq_num| is already in the set.
+  bool Insert(T seq_num) {
+    if (empty()) {
+      oldest_ = newest_ = seq_num;
+    } else if (Contains(seq_num)) {
+      return false;
+    } else if (Diff(oldest_, seq_num) > Diff(oldest_, newest_)) {
+      // Outside of [front(), back()], so it becomes one of them.
+      if (AheadOf(seq_num, newest_)) {
+        RTC_DCHECK_LT(Diff(oldest_, seq_num), kWindow);
+        newest_ = seq_num;
+      } else {
+        RTC_DCHECK_LT(Diff(seq_num, newest_), kWindow);
+        oldest_ = seq_num;
+      }
+    }
+    bits_[Index(seq_num) / 64] |= Bit(Index(seq_num));
+    ++size_;
+    return true;
+  }
+
+  // Returns false if |seq_num| is not in the set.
+  bool Erase(T seq_num) {
+    if (!Contains(seq_num))
+      return false;
+    bits_[Index(seq_num) / 64] &= ~Bit(Index(seq_num));
+    if (--size_ == 0)
+      return true;
+    if (seq_num == oldest_)
+      oldest_ = FindForward(oldest_);
+    else if (seq_num == newest_)
+      newest_ = FindBackward(newest_);
+    return true;
+  }
+
+  // Erases every element older than |seq_num|.
+  void EraseOlderThan(T seq_num) {
+    if (!empty() && AheadOf(seq_num, newest_)) {
+      Clear();
+      return;
+    }
+    while (!empty() && AheadOf(seq_num, oldest_))
+      Erase(oldest_);
+  }
+
+  void Clear() {
+    memset(bits_, 0, sizeof(bits_));
+    size_ = 0;
+  }
+
+  // Returns the oldest element that is not older than |seq_num|, if any.
+  rtc::Optional<T> FirstAtOrAfter(T seq_num) const {
+    if (empty() || AheadOf(seq_num, newest_))
+      return rtc::Optional<T>();
+    if (!AheadOf(seq_num, oldest_))
+      return rtc::Optional<T>(oldest_);
+    if (IsSet(Index(seq_num)))
+      return rtc::Optional<T>(seq_num);
+    return rtc::Optional<T>(FindForward(seq_num));
+  }
+
+  // Returns the oldest element that is newer than |seq_num|, if any.
+  rtc::Optional<T> FirstAfter(T seq_num) const {
+    return FirstAtOrAfter(Add(seq_num, 1));
+  }
+
+  // Position of |seq_num| in the underlying table. SeqNumMap uses it to keep
+  // its values next to the bitmap.
+  static size_t Index(T seq_num) { return seq_num % kWindow; }
+
+ private:
+  static const size_t kModulus =
+      M == 0 ? static_cast<size_t>(std::numeric_limits<T>::max()) + 1 : M;
+  static_assert(std::is_unsigned<T>::value,
+                "Type must be an unsigned integer.");
+  static_assert(kWindow % 64 == 0, "The window must be a multiple of 64.");
+  static_assert(kModulus % kWindow == 0,
+                "The window must divide the sequence number space.");
+
+  static T Diff(T a, T b) {
+    return static_cast<T>((kModulus + b - a) % kModulus);
+  }
+  static T Add(T a, size_t b) { return static_cast<T>((a + b) % kModulus); }
+  static bool AheadOf(T a, T b) { return AscendingSeqNumComp<T, M>()(a, b); }
+  static uint64_t Bit(size_t index) { return uint64_t{1} << (index % 64); }
+  bool IsSet(size_t index) const {
+    return (bits_[index / 64] & Bit(index)) != 0;
+  }
+
+  // Number of trailing and leading zero bits of a non-zero word.
+  static int CountTrailingZeros(uint64_t bits) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(bits);
+#else
+    int n = 0;
+    for (; !(bits & 1); bits >>= 1)
+      ++n;
+    return n;
+#endif
+  }
+  static int CountLeadingZeros(uint64_t bits) {
+#if defined(__GNUC__)
+    return __builtin_clzll(bits);
+#else
+    int n = 0;
+    for (; !(bits >> 63); bits <<= 1)
+      ++n;
+    return n;
+#endif
+  }
+
+  // Returns the closest element after |seq_num|. There must be one.
+  T FindForward(T seq_num) const {
+    const size_t kWords = kWindow / 64;
+    size_t start = (Index(seq_num) + 1) % kWindow;
+    size_t word = start / 64;
+    uint64_t bits = bits_[word] & (~uint64_t{0} << (start % 64));
+    for (size_t i = 0; i <= kWords; ++i) {
+      if (bits) {
+        size_t index = word * 64 + CountTrailingZeros(bits);
+        return Add(seq_num, (index + kWindow - Index(seq_num)) % kWindow);
+      }
+      word = (word + 1) % kWords;
+      bits = bits_[word];
+    }
+    RTC_NOTREACHED();
+    return seq_num;
+  }
+
+  // Returns the closest element before |seq_num|. There must be one.
+  T FindBackward(T seq_num) const {
+    const size_t kWords = kWindow / 64;
+    size_t start = (Index(seq_num) + kWindow - 1) % kWindow;
+    size_t word = start / 64;
+    uint64_t bits = bits_[word] & (~uint64_t{0} >> (63 - start % 64));
+    for (size_t i = 0; i <= kWords; ++i) {
+      if (bits) {
+        size_t index = word * 64 + 63 - CountLeadingZeros(bits);
+        return Add(seq_num,
+                   kModulus - (Index(seq_num) + kWindow - index) % kWindow);
+      }
+      word = (word + kWords - 1) % kWords;
+      bits = bits_[word];
+    }
+    RTC_NOTREACHED();
+    return seq_num;
+  }
+
+  uint64_t bits_[kWindow / 64];
+  size_t size_;
+  T oldest_;
+  T newest_;
+};
+
+// A map from sequence numbers to values of type |V| built on SeqNumSet, for
+// the same use in place of std::map. At most |kCapacity| elements can be
+// stored at a time. Their values live in a pool allocated at construction,
+// so a window much larger than the number of elements stays cheap.
+template <typename T, typename V, size_t kWindow, size_t kCapacity, T M = 0>
+class SeqNumMap {
+ public:
+  SeqNumMap()
+      : slots_(new uint16_t[kWindow]),
+        values_(new V[kCapacity]),
+        free_slots_(new uint16_t[kCapacity]) {
+    Clear();
+  }
+
+  bool empty() const { return keys_.empty(); }
+  size_t size() const { return keys_.size(); }
+  bool full() const { return keys_.size() == kCapacity; }
+  T front() const { return keys_.front(); }
+  T back() const { return keys_.back(); }
+  const SeqNumSet<T, kWindow, M>& keys() const { return keys_; }
+
+  // Returns nullptr if |seq_num| is not in the map.
+  V* Find(T seq_num) {
+    if (!keys_.Contains(seq_num))
+      return nullptr;
+    return &values_[slots_[SeqNumSet<T, kWindow, M>::Index(seq_num)]];
+  }
+
+  // Returns false, and leaves the map unchanged, if |seq_num| is already in
+  // the map. The map must not be full.
+  bool Insert(T seq_num, const V& value) {
+    RTC_DCHECK(!full());
+    if (!keys_.Insert(seq_num))
+      return false;
+    uint16_t slot = free_slots_[--num_free_slots_];
+    slots_[SeqNumSet<T, kWindow, M>::Index(seq_num)] = slot;
+    values_[slot] = value;
+    return true;
+  }
+
+  // Returns false if |seq_num| is not in the map.
+  bool Erase(T seq_num) {
+    if (!keys_.Contains(seq_num))
+      return false;
+    free_slots_[num_free_slots_++] =
+        slots_[SeqNumSet<T, kWindow, M>::Index(seq_num)];
+    keys_.Erase(seq_num);
+    return true;
+  }
+
+  void EraseOlderThan(T seq_num) {
+    if (!empty() && AscendingSeqNumComp<T, M>()(seq_num, back())) {
+      Clear();
+      return;
+    }
+    while (!empty() && AscendingSeqNumComp<T, M>()(seq_num, front()))
+      Erase(front());
+  }
+
+  void Clear() {
+    keys_.Clear();
+    for (size_t i = 0; i < kCapacity; ++i)
+      free_slots_[i] = static_cast<uint16_t>(kCapacity - 1 - i);
+    num_free_slots_ = kCapacity;
+  }
+
+  rtc::Optional<T> FirstAtOrAfter(T seq_num) const {
+    return keys_.FirstAtOrAfter(seq_num);
+  }
+  rtc::Optional<T> FirstAfter(T seq_num) const {
+    return keys_.FirstAfter(seq_num);
+  }
+
+ private:
+  static_assert(kCapacity <= kWindow, "More capacity than keys.");
+  static_assert(kCapacity <= (1 << 16), "Slots are indexed with 16 bits.");
+
+  SeqNumSet<T, kWindow, M> keys_;
+  // Index into |values_| for every position of the window in use.
+  const std::unique_ptr<uint16_t[]> slots_;
+  const std::unique_ptr<V[]> values_;
+  // Stack of unused indices into |values_|.
+  const std::unique_ptr<uint16_t[]> free_slots_;
+  size_t num_free_slots_;
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_VIDEO_CODING_SEQUENCE_NUMBER_RING_H_
@@ -0,0 +1,175 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <map>
+#include <set>
+
+#include "webrtc/base/random.h"
+#include "webrtc/modules/video_coding/sequence_number_ring.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+TEST(SeqNumSetTest, InsertAndErase) {
+  SeqNumSet<uint16_t, 1024> set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_TRUE(set.Insert(10));
+  EXPECT_FALSE(set.Insert(10));
+  EXPECT_TRUE(set.Insert(5));
+  EXPECT_TRUE(set.Insert(300));
+  EXPECT_EQ(3u, set.size());
+  EXPECT_EQ(5, set.front());
+  EXPECT_EQ(300, set.back());
+  EXPECT_TRUE(set.Contains(10));
+  EXPECT_FALSE(set.Contains(11));
+  // Same position in the table as 10, but outside of the window.
+  EXPECT_FALSE(set.Contains(10 + 1024));
+
+  EXPECT_TRUE(set.Erase(5));
+  EXPECT_FALSE(set.Erase(5));
+  EXPECT_EQ(10, set.front());
+  EXPECT_TRUE(set.Erase(300));
+  EXPECT_EQ(10, set.back());
+  EXPECT_TRUE(set.Erase(10));
+  EXPECT_TRUE(set.empty());
+}
+
+TEST(SeqNumSetTest, WrapAround) {
+  SeqNumSet<uint16_t, 1024> set;
+  set.Insert(0xfff0);
+  set.Insert(2);
+  set.Insert(0xffff);
+  EXPECT_EQ(0xfff0, set.front());
+  EXPECT_EQ(2, set.back());
+  EXPECT_EQ(0xffff, *set.FirstAfter(0xfff0));
+  EXPECT_EQ(2, *set.FirstAfter(0xffff));
+  EXPECT_FALSE(set.FirstAfter(2));
+
+  set.EraseOlderThan(1);
+  EXPECT_EQ(1u, set.size());
+  EXPECT_EQ(2, set.front());
+  set.EraseOlderThan(3);
+  EXPECT_TRUE(set.empty());
+}
+
+TEST(SeqNumSetTest, FirstAtOrAfter) {
+  SeqNumSet<uint16_t, 128, 128> set;
+  EXPECT_FALSE(set.FirstAtOrAfter(0));
+  set.Insert(120);
+  set.Insert(3);
+  EXPECT_EQ(120, *set.FirstAtOrAfter(100));
+  EXPECT_EQ(120, *set.FirstAtOrAfter(120));
+  EXPECT_EQ(3, *set.FirstAtOrAfter(121));
+  EXPECT_EQ(3, *set.FirstAtOrAfter(3));
+  EXPECT_FALSE(set.FirstAtOrAfter(4));
+}
+
+TEST(SeqNumSetTest, MatchesStdSet) {
+  const int kWindow = 2048;
+  Random random(0x1234);
+  SeqNumSet<uint16_t, kWindow> set;
+  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> reference;
+  uint16_t newest = 0xff00;
+  for (int i = 0; i < 100000; ++i) {
+    newest += random.Rand(0, 3);
+    uint16_t seq_num = newest - random.Rand(0, kWindow / 2);
+    switch (random.Rand(0, 3)) {
+      case 0:
+      case 1:
+        ASSERT_EQ(reference.insert(seq_num).second, set.Insert(seq_num));
+        break;
+      case 2:
+        ASSERT_EQ(reference.erase(seq_num) == 1, set.Erase(seq_num));
+        break;
+      case 3: {
+        auto it = reference.lower_bound(seq_num);
+        rtc::Optional<uint16_t> found = set.FirstAtOrAfter(seq_num);
+        ASSERT_EQ(it != reference.end(), static_cast<bool>(found));
+        if (found) {
+          ASSERT_EQ(*it, *found);
+        }
+        break;
+      }
+    }
+    uint16_t old_seq_num = newest - kWindow / 2;
+    reference.erase(reference.begin(), reference.lower_bound(old_seq_num));
+    set.EraseOlderThan(old_seq_num);
+
+    ASSERT_EQ(reference.size(), set.size());
+    if (!reference.empty()) {
+      ASSERT_EQ(*reference.begin(), set.front());
+      ASSERT_EQ(*reference.rbegin(), set.back());
+    }
+  }
+}
+
+TEST(SeqNumMapTest, InsertFindErase) {
+  SeqNumMap<uint16_t, int, 1024, 4> map;
+  EXPECT_TRUE(map.Insert(1, 10));
+  EXPECT_TRUE(map.Insert(2, 20));
+  EXPECT_FALSE(map.Insert(2, 30));
+  EXPECT_EQ(20, *map.Find(2));
+  EXPECT_EQ(nullptr, map.Find(3));
+  *map.Find(1) = 11;
+  EXPECT_EQ(11, *map.Find(1));
+
+  // Slots are reused once erased.
+  EXPECT_TRUE(map.Insert(3, 30));
+  EXPECT_TRUE(map.Insert(4, 40));
+  EXPECT_TRUE(map.full());
+  EXPECT_TRUE(map.Erase(2));
+  EXPECT_TRUE(map.Insert(1000, 50));
+  EXPECT_EQ(11, *map.Find(1));
+  EXPECT_EQ(30, *map.Find(3));
+  EXPECT_EQ(40, *map.Find(4));
+  EXPECT_EQ(50, *map.Find(1000));
+
+  map.EraseOlderThan(4);
+  EXPECT_EQ(2u, map.size());
+  EXPECT_EQ(4, map.front());
+  EXPECT_EQ(1000, *map.FirstAfter(4));
+}
+
+TEST(SeqNumMapTest, MatchesStdMap) {
+  const int kWindow = 1024;
+  const int kCapacity = 256;
+  Random random(0x4321);
+  SeqNumMap<uint16_t, uint32_t, kWindow, kCapacity> map;
+  std::map<uint16_t, uint32_t, DescendingSeqNumComp<uint16_t>> reference;
+  uint16_t newest = 0;
+  for (int i = 0; i < 100000; ++i) {
+    newest += random.Rand(0, 2);
+    uint16_t seq_num = newest - random.Rand(0, kWindow / 2);
+    uint32_t value = random.Rand<uint32_t>();
+    if (random.Rand<bool>() && reference.size() < kCapacity) {
+      ASSERT_EQ(reference.insert(std::make_pair(seq_num, value)).second,
+                map.Insert(seq_num, value));
+    } else {
+      ASSERT_EQ(reference.erase(seq_num) == 1, map.Erase(seq_num));
+    }
+    uint16_t old_seq_num = newest - kWindow / 2;
+    reference.erase(reference.begin(), reference.lower_bound(old_seq_num));
+    map.EraseOlderThan(old_seq_num);
+
+    ASSERT_EQ(reference.size(), map.size());
+    rtc::Optional<uint16_t> key;
+    if (!map.empty())
+      key = rtc::Optional<uint16_t>(map.front());
+    for (const auto& entry : reference) {
+      ASSERT_TRUE(key);
+      ASSERT_EQ(entry.first, *key);
+      ASSERT_EQ(entry.second, *map.Find(*key));
+      key = map.FirstAfter(*key);
+    }
+    ASSERT_FALSE(key);
+  }
+}
+
+}  // namespace webrtc
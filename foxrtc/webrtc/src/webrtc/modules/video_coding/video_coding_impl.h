@@ -142,6 +142,15 @@ class VideoReceiver : public Module {
   int32_t RegisterPacketRequestCallback(VCMPacketRequestCallback* callback);
 
   int32_t Decode(uint16_t maxWaitTimeMs);
+  // Decodes the next frame if it is due, without waiting. Sets
+  // |*next_decode_time_ms| to now if a frame was taken, to the decode time of
+  // a buffered frame that is not yet due, or to -1.
+  int32_t DecodeIfDue(int64_t* next_decode_time_ms);
+  // Decodes a frame handed out by a video_coding::FrameBuffer that uses
+  // timing().
+  int32_t Decode(const VCMEncodedFrame* frame);
+
+  VCMTiming* timing() { return &_timing; }
 
   int32_t ReceiveCodec(VideoCodec* currentReceiveCodec) const;
   VideoCodecType ReceiveCodec() const;
@@ -172,6 +181,7 @@ class VideoReceiver : public Module {
   void TriggerDecoderShutdown();
 
  protected:
+  int32_t DecodeAndReleaseFrame(VCMEncodedFrame* frame);
   int32_t Decode(const webrtc::VCMEncodedFrame& frame)
       EXCLUSIVE_LOCKS_REQUIRED(receive_crit_);
   int32_t RequestKeyFrame();
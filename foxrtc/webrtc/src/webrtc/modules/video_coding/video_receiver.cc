@@ -249,7 +249,47 @@ int32_t VideoReceiver::Decode(uint16_t maxWaitTimeMs) {
 
   if (!frame)
     return VCM_FRAME_NOT_READY;
+  return DecodeAndReleaseFrame(frame);
+}
+
+int32_t VideoReceiver::DecodeIfDue(int64_t* next_decode_time_ms) {
+  *next_decode_time_ms = -1;
+  bool prefer_late_decoding = false;
+  {
+    rtc::CritScope cs(&receive_crit_);
+    prefer_late_decoding = _codecDataBase.PrefersLateDecoding();
+  }
+
+  VCMEncodedFrame* frame = _receiver.FrameForDecoding(
+      0, prefer_late_decoding, next_decode_time_ms);
+
+  if (!frame)
+    return VCM_FRAME_NOT_READY;
+  // More frames may be ready right away.
+  *next_decode_time_ms = clock_->TimeInMilliseconds();
+  return DecodeAndReleaseFrame(frame);
+}
+
+int32_t VideoReceiver::Decode(const VCMEncodedFrame* frame) {
+  if (pre_decode_image_callback_) {
+    EncodedImage encoded_image(frame->EncodedImage());
+    int qp = -1;
+    if (qp_parser_.GetQp(*frame, &qp)) {
+      encoded_image.qp_ = qp;
+    }
+    pre_decode_image_callback_->Encoded(encoded_image, frame->CodecSpecific(),
+                                        nullptr);
+  }
+
+  rtc::CritScope cs(&receive_crit_);
+  if (first_frame_received_()) {
+    LOG(LS_INFO) << "Received first decodable video frame";
+  }
+  // The frame buffer has already updated the current delay.
+  return Decode(*frame);
+}
 
+int32_t VideoReceiver::DecodeAndReleaseFrame(VCMEncodedFrame* frame) {
   {
     rtc::CritScope cs(&process_crit_);
     if (drop_frames_until_keyframe_) {
@@ -10,12 +10,17 @@
 
 #include "webrtc/modules/video_processing/frame_preprocessor.h"
 
+#include "webrtc/base/timeutils.h"
 #include "webrtc/modules/video_processing/video_denoiser.h"
 
 namespace webrtc {
 
 VPMFramePreprocessor::VPMFramePreprocessor()
-    : resampled_frame_(), frame_cnt_(0) {
+    : resampled_frame_(),
+      frame_cnt_(0),
+      denoising_enabled_(false),
+      skip_static_scenes_(false),
+      last_passed_frame_ms_(0) {
   spatial_resampler_ = new VPMSimpleSpatialResampler();
   vd_ = new VPMVideoDecimator();
   EnableDenoising(false);
@@ -76,10 +81,20 @@ uint32_t VPMFramePreprocessor::GetDecimatedHeight() const {
 }
 
 void VPMFramePreprocessor::EnableDenoising(bool enable) {
-  if (enable) {
-    denoiser_.reset(new VideoDenoiser(true));
-  } else {
+  denoising_enabled_ = enable;
+  UpdateDenoiser();
+}
+
+void VPMFramePreprocessor::EnableStaticSceneSkipping(bool enable) {
+  skip_static_scenes_ = enable;
+  UpdateDenoiser();
+}
+
+void VPMFramePreprocessor::UpdateDenoiser() {
+  if (!denoising_enabled_ && !skip_static_scenes_) {
     denoiser_.reset();
+  } else if (!denoiser_) {
+    denoiser_.reset(new VideoDenoiser(true));
   }
 }
 
@@ -105,14 +120,32 @@ const VideoFrame* VPMFramePreprocessor::PreprocessFrame(
     }
     // Invert the flag.
     denoised_frame_toggle_ ^= 1;
+    // DenoiseFrame() writes every pixel of |denoised_buffer|, so it can be
+    // replaced by a free one rather than overwrite a frame handed out two
+    // calls ago.
+    const VideoFrameBuffer& input = *current_frame->video_frame_buffer();
+    const int stride_uv = (input.width() + 1) / 2;
+    if (input.StrideY() == input.width() && input.StrideU() == stride_uv &&
+        input.StrideV() == stride_uv) {
+      // Let the pool reuse the old buffer if nobody else holds it.
+      *denoised_buffer = nullptr;
+      *denoised_buffer =
+          denoised_buffer_pool_.CreateBuffer(input.width(), input.height());
+    }
     denoiser_->DenoiseFrame(current_frame->video_frame_buffer(),
                             denoised_buffer,
                             denoised_buffer_prev, true);
-    denoised_frame_ = VideoFrame(*denoised_buffer,
-                                 current_frame->timestamp(),
-                                 current_frame->render_time_ms(),
-                                 current_frame->rotation());
-    current_frame = &denoised_frame_;
+    if (skip_static_scenes_ && denoiser_->last_frame_static() &&
+        rtc::TimeMillis() - last_passed_frame_ms_ < kStaticSceneRefreshMs) {
+      return nullptr;
+    }
+    if (denoising_enabled_) {
+      denoised_frame_ = VideoFrame(*denoised_buffer,
+                                   current_frame->timestamp(),
+                                   current_frame->render_time_ms(),
+                                   current_frame->rotation());
+      current_frame = &denoised_frame_;
+    }
   }
 
   if (spatial_resampler_->ApplyResample(current_frame->width(),
@@ -125,6 +158,7 @@ const VideoFrame* VPMFramePreprocessor::PreprocessFrame(
   }
 
   ++frame_cnt_;
+  last_passed_frame_ms_ = rtc::TimeMillis();
   return current_frame;
 }
 
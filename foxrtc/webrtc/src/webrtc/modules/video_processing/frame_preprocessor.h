@@ -13,6 +13,7 @@
 
 #include <memory>
 
+#include "webrtc/common_video/include/i420_buffer_pool.h"
 #include "webrtc/modules/video_processing/include/video_processing.h"
 #include "webrtc/modules/video_processing/spatial_resampler.h"
 #include "webrtc/modules/video_processing/video_decimator.h"
@@ -54,14 +55,26 @@ class VPMFramePreprocessor {
 
   // Preprocess output:
   void EnableDenoising(bool enable);
+  // Drop frames the denoiser finds unchanged from the previous one, but still
+  // pass one on every |kStaticSceneRefreshMs|. Runs the denoiser for its
+  // statistics even if denoising is disabled.
+  void EnableStaticSceneSkipping(bool enable);
   const VideoFrame* PreprocessFrame(const VideoFrame& frame);
 
  private:
   // The content does not change so much every frame, so to reduce complexity
   // we can compute new content metrics every |kSkipFrameCA| frames.
   enum { kSkipFrameCA = 2 };
+  enum { kStaticSceneRefreshMs = 1000 };
+
+  // Creates or deletes |denoiser_| as denoising or skipping requires.
+  void UpdateDenoiser();
 
   rtc::scoped_refptr<I420Buffer> denoised_buffer_[2];
+  // Denoised frames are written into buffers from here, as long as the
+  // input has the strides of a pooled buffer, so that a frame still held
+  // downstream is never overwritten.
+  I420BufferPool denoised_buffer_pool_;
   VideoFrame denoised_frame_;
   VideoFrame resampled_frame_;
   VPMSpatialResampler* spatial_resampler_;
@@ -69,6 +82,9 @@ class VPMFramePreprocessor {
   std::unique_ptr<VideoDenoiser> denoiser_;
   uint8_t denoised_frame_toggle_;
   uint32_t frame_cnt_;
+  bool denoising_enabled_;
+  bool skip_static_scenes_;
+  int64_t last_passed_frame_ms_;
 };
 
 }  // namespace webrtc
@@ -52,6 +52,10 @@ class VideoProcessing {
       VideoFrameResampling resampling_mode) = 0;
 
   virtual void EnableDenoising(bool enable) = 0;
+  // Drop frames that show no change from the previous one, except one per
+  // second. Any change on skin colored blocks counts, so that a face moving
+  // slightly in front of a still background is not dropped.
+  virtual void EnableStaticSceneSkipping(bool enable) = 0;
   virtual const VideoFrame* PreprocessFrame(const VideoFrame& frame) = 0;
 };
 
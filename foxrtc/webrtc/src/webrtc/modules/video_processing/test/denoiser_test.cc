@@ -10,12 +10,17 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <memory>
 
+#include "webrtc/base/random.h"
 #include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
 #include "webrtc/modules/video_processing/include/video_processing.h"
 #include "webrtc/modules/video_processing/test/video_processing_unittest.h"
+#include "webrtc/modules/video_processing/util/denoiser_filter_avx2.h"
+#include "webrtc/modules/video_processing/util/denoiser_filter_sse2.h"
 #include "webrtc/modules/video_processing/video_denoiser.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 #include "webrtc/test/frame_utils.h"
 
 namespace webrtc {
@@ -172,4 +177,141 @@ TEST_F(VideoProcessingTest, Denoiser) {
   ASSERT_NE(0, feof(source_file_)) << "Error reading source file";
 }
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Create() picks AVX2 over SSE2 when it can, so compare both explicitly
+// against the C version, on blocks with every level of difference.
+TEST(DenoiserFilterTest, Avx2AndSse2MatchC) {
+  if (!WebRtc_GetCPUInfo(kAVX2))
+    return;
+  std::unique_ptr<DenoiserFilter> df_c(DenoiserFilter::Create(false, nullptr));
+  std::unique_ptr<DenoiserFilter> df_simd[] = {
+      std::unique_ptr<DenoiserFilter>(new DenoiserFilterSSE2()),
+      std::unique_ptr<DenoiserFilter>(new DenoiserFilterAVX2())};
+  const int kStride = 24;
+  uint8_t running_src[16 * kStride], src[16 * kStride];
+  uint8_t dst_c[16 * kStride], dst_simd[16 * kStride];
+  Random random(0x1234);
+  for (int i = 0; i < 1000; ++i) {
+    const int max_diff = random.Rand(1, 20);
+    for (int j = 0; j < 16 * kStride; ++j) {
+      running_src[j] = random.Rand<uint8_t>();
+      src[j] = static_cast<uint8_t>(std::min(
+          255, std::max(0, running_src[j] + random.Rand(-max_diff, max_diff))));
+    }
+    const uint8_t motion_magnitude = random.Rand(0, 40);
+    const int increase_denoising = random.Rand(0, 1);
+    uint32_t sse_c, sse_simd;
+    const uint32_t var_c =
+        df_c->Variance16x8(running_src, kStride, src, kStride, &sse_c);
+    memset(dst_c, 0, sizeof(dst_c));
+    const DenoiserDecision decision_c =
+        df_c->MbDenoise(running_src, kStride, dst_c, kStride, src, kStride,
+                        motion_magnitude, increase_denoising);
+    for (const auto& df : df_simd) {
+      EXPECT_EQ(var_c, df->Variance16x8(running_src, kStride, src, kStride,
+                                        &sse_simd));
+      EXPECT_EQ(sse_c, sse_simd);
+      memset(dst_simd, 0, sizeof(dst_simd));
+      const DenoiserDecision decision =
+          df->MbDenoise(running_src, kStride, dst_simd, kStride, src, kStride,
+                        motion_magnitude, increase_denoising);
+      EXPECT_EQ(0, memcmp(dst_c, dst_simd, sizeof(dst_c)));
+      // SSE2 saturates column sums while it accumulates, so it can differ
+      // from C on blocks that are copied anyway.
+      if (df.get() == df_simd[1].get()) {
+        EXPECT_EQ(decision_c, decision);
+      }
+    }
+  }
+}
+#endif
+
+namespace {
+
+const int kStaticWidth = 352;
+const int kStaticHeight = 288;
+
+rtc::scoped_refptr<I420Buffer> CreateStaticSceneBuffer() {
+  rtc::scoped_refptr<I420Buffer> buffer =
+      I420Buffer::Create(kStaticWidth, kStaticHeight);
+  for (int y = 0; y < kStaticHeight; ++y) {
+    for (int x = 0; x < kStaticWidth; ++x)
+      buffer->MutableDataY()[y * buffer->StrideY() + x] = (x * 7 + y * 3) % 200;
+  }
+  // Grey, which is not skin.
+  memset(buffer->MutableDataU(), 128,
+         buffer->StrideU() * ((kStaticHeight + 1) / 2));
+  memset(buffer->MutableDataV(), 128,
+         buffer->StrideV() * ((kStaticHeight + 1) / 2));
+  return buffer;
+}
+
+// Brightens the luma of macroblock (|mb_row|, |mb_col|) by 40.
+void ChangeBlock(I420Buffer* buffer, int mb_row, int mb_col) {
+  for (int y = 0; y < 16; ++y) {
+    uint8_t* row = buffer->MutableDataY() +
+                   ((mb_row << 4) + y) * buffer->StrideY() + (mb_col << 4);
+    for (int x = 0; x < 16; ++x)
+      row[x] += 40;
+  }
+}
+
+// Gives macroblock (|mb_row|, |mb_col|) a skin color.
+void PaintSkin(I420Buffer* buffer, int mb_row, int mb_col) {
+  for (int y = 0; y < 8; ++y) {
+    memset(buffer->MutableDataU() + ((mb_row << 3) + y) * buffer->StrideU() +
+               (mb_col << 3),
+           117, 8);
+    memset(buffer->MutableDataV() + ((mb_row << 3) + y) * buffer->StrideV() +
+               (mb_col << 3),
+           150, 8);
+  }
+}
+
+class StaticSceneDenoiser {
+ public:
+  StaticSceneDenoiser() : denoiser_(true), toggle_(0) {}
+
+  bool DenoiseFrame(const rtc::scoped_refptr<VideoFrameBuffer>& frame) {
+    denoiser_.DenoiseFrame(frame, &buffers_[toggle_], &buffers_[toggle_ ^ 1],
+                           true);
+    toggle_ ^= 1;
+    return denoiser_.last_frame_static();
+  }
+
+ private:
+  VideoDenoiser denoiser_;
+  rtc::scoped_refptr<I420Buffer> buffers_[2];
+  int toggle_;
+};
+
+}  // namespace
+
+TEST(VideoDenoiserTest, DetectsStaticScene) {
+  StaticSceneDenoiser denoiser;
+  rtc::scoped_refptr<I420Buffer> still = CreateStaticSceneBuffer();
+  // The first frame only initializes the denoiser.
+  EXPECT_FALSE(denoiser.DenoiseFrame(still));
+  EXPECT_TRUE(denoiser.DenoiseFrame(still));
+  EXPECT_TRUE(denoiser.DenoiseFrame(still));
+
+  // A change in a single block is taken for noise.
+  rtc::scoped_refptr<I420Buffer> one_block = CreateStaticSceneBuffer();
+  ChangeBlock(one_block.get(), 5, 5);
+  EXPECT_TRUE(denoiser.DenoiseFrame(one_block));
+
+  // Unless that block has skin color.
+  rtc::scoped_refptr<I420Buffer> skin = CreateStaticSceneBuffer();
+  PaintSkin(skin.get(), 5, 5);
+  EXPECT_FALSE(denoiser.DenoiseFrame(skin));
+  EXPECT_TRUE(denoiser.DenoiseFrame(skin));
+
+  rtc::scoped_refptr<I420Buffer> moving = CreateStaticSceneBuffer();
+  PaintSkin(moving.get(), 5, 5);
+  for (int mb_col = 0; mb_col < 10; ++mb_col)
+    ChangeBlock(moving.get(), 8, mb_col);
+  EXPECT_FALSE(denoiser.DenoiseFrame(moving));
+  EXPECT_TRUE(denoiser.DenoiseFrame(moving));
+}
+
 }  // namespace webrtc
@@ -14,7 +14,9 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "webrtc/base/fakeclock.h"
 #include "webrtc/base/keep_ref_until_done.h"
 #include "webrtc/base/timeutils.h"
 #include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
@@ -188,6 +190,61 @@ TEST_F(VideoProcessingTest, Resampler) {
   printf("Min run time = %d us / frame\n\n", static_cast<int>(min_runtime));
 }
 
+TEST(VideoProcessingStaticSceneTest, SkipsUnchangedFrames) {
+  rtc::ScopedFakeClock clock;
+  clock.AdvanceTime(rtc::TimeDelta::FromSeconds(1));
+  std::unique_ptr<VideoProcessing> vp(VideoProcessing::Create());
+  vp->EnableTemporalDecimation(false);
+  vp->SetInputFrameResampleMode(kNoRescaling);
+  vp->EnableStaticSceneSkipping(true);
+
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(352, 288);
+  buffer->InitializeData();
+  VideoFrame frame(buffer, 0, 0, kVideoRotation_0);
+  // Without denoising the frames themselves are passed on.
+  const VideoFrame* out_frame = vp->PreprocessFrame(frame);
+  ASSERT_TRUE(out_frame != nullptr);
+  EXPECT_EQ(buffer, out_frame->video_frame_buffer());
+  clock.AdvanceTime(rtc::TimeDelta::FromMilliseconds(33));
+  EXPECT_TRUE(vp->PreprocessFrame(frame) == nullptr);
+  clock.AdvanceTime(rtc::TimeDelta::FromMilliseconds(900));
+  EXPECT_TRUE(vp->PreprocessFrame(frame) == nullptr);
+  // One frame per second is passed on regardless.
+  clock.AdvanceTime(rtc::TimeDelta::FromMilliseconds(67));
+  EXPECT_TRUE(vp->PreprocessFrame(frame) != nullptr);
+  clock.AdvanceTime(rtc::TimeDelta::FromMilliseconds(33));
+  EXPECT_TRUE(vp->PreprocessFrame(frame) == nullptr);
+
+  rtc::scoped_refptr<I420Buffer> changed = I420Buffer::Create(352, 288);
+  changed->InitializeData();
+  memset(changed->MutableDataY(), 100, changed->StrideY() * 288);
+  clock.AdvanceTime(rtc::TimeDelta::FromMilliseconds(33));
+  EXPECT_TRUE(vp->PreprocessFrame(VideoFrame(changed, 0, 0,
+                                             kVideoRotation_0)) != nullptr);
+
+  vp->EnableStaticSceneSkipping(false);
+  EXPECT_TRUE(vp->PreprocessFrame(frame) != nullptr);
+}
+
+TEST(VideoProcessingStaticSceneTest, KeepsDenoisedFramesHeldDownstream) {
+  std::unique_ptr<VideoProcessing> vp(VideoProcessing::Create());
+  vp->EnableTemporalDecimation(false);
+  vp->SetInputFrameResampleMode(kNoRescaling);
+  vp->EnableDenoising(true);
+
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(352, 288);
+  buffer->InitializeData();
+  VideoFrame frame(buffer, 0, 0, kVideoRotation_0);
+  std::vector<rtc::scoped_refptr<VideoFrameBuffer>> held;
+  for (int i = 0; i < 4; ++i) {
+    const VideoFrame* out_frame = vp->PreprocessFrame(frame);
+    ASSERT_TRUE(out_frame != nullptr);
+    for (const auto& previous : held)
+      EXPECT_NE(previous, out_frame->video_frame_buffer());
+    held.push_back(out_frame->video_frame_buffer());
+  }
+}
+
 void PreprocessFrameAndVerify(const VideoFrame& source,
                               int target_width,
                               int target_height,
@@ -67,11 +67,16 @@ static void ShowRect(const std::unique_ptr<DenoiserFilter>& filter,
 }
 #endif
 
+// At most 1/128 of the blocks of a static frame may change, for what noise
+// the filter does not absorb.
+static const int kStaticFrameChangedBlocksShift = 7;
+
 VideoDenoiser::VideoDenoiser(bool runtime_cpu_detection)
     : width_(0),
       height_(0),
       filter_(DenoiserFilter::Create(runtime_cpu_detection, &cpu_type_)),
-      ne_(new NoiseEstimation()) {}
+      ne_(new NoiseEstimation()),
+      last_frame_static_(false) {}
 
 void VideoDenoiser::DenoiserReset(
     const rtc::scoped_refptr<VideoFrameBuffer>& frame,
@@ -98,6 +103,7 @@ void VideoDenoiser::DenoiserReset(
   x_density_.reset(new uint8_t[mb_cols_]);
   y_density_.reset(new uint8_t[mb_rows_]);
   moving_object_.reset(new uint8_t[mb_cols_ * mb_rows_]);
+  last_frame_static_ = false;
 }
 
 int VideoDenoiser::PositionCheck(int mb_row, int mb_col, int noise_level) {
@@ -219,6 +225,30 @@ void VideoDenoiser::CopyLumaOnMargin(const uint8_t* y_src, uint8_t* y_dst) {
   }
 }
 
+bool VideoDenoiser::IsStaticFrame(const uint8_t* y_src,
+                                  const uint8_t* u_src,
+                                  const uint8_t* v_src) {
+  // Noise estimation raises the threshold of MbDenoise() for noisy sources,
+  // so sensor noise alone does not make a block fail the filter.
+  const int max_changed_blocks =
+      (mb_rows_ * mb_cols_) >> kStaticFrameChangedBlocksShift;
+  int changed_blocks = 0;
+  for (int mb_row = 0; mb_row < mb_rows_; ++mb_row) {
+    for (int mb_col = 0; mb_col < mb_cols_; ++mb_col) {
+      if (mb_filter_decision_[mb_row * mb_cols_ + mb_col] == FILTER_BLOCK)
+        continue;
+      if (++changed_blocks > max_changed_blocks)
+        return false;
+      // Faces move little but matter most, so any change on skin counts.
+      if (MbHasSkinColor(y_src, u_src, v_src, stride_y_, stride_u_, stride_v_,
+                         mb_row, mb_col)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 void VideoDenoiser::DenoiseFrame(
     const rtc::scoped_refptr<VideoFrameBuffer>& frame,
     rtc::scoped_refptr<I420Buffer>* denoised_frame,
@@ -318,6 +348,8 @@ void VideoDenoiser::DenoiseFrame(
     }  // End of for loop
   }    // End of for loop
 
+  last_frame_static_ = IsStaticFrame(y_src, u_src, v_src);
+
   ReduceFalseDetection(moving_edge_, &moving_object_, noise_level);
 
   CopySrcOnMOB(y_src, y_dst);
@@ -34,6 +34,10 @@ class VideoDenoiser {
                     rtc::scoped_refptr<I420Buffer>* denoised_frame_prev,
                     bool noise_estimation_enabled);
 
+  // Whether the last frame passed to DenoiseFrame() showed no change from
+  // the one before it. False after a reset.
+  bool last_frame_static() const { return last_frame_static_; }
+
  private:
   void DenoiserReset(const rtc::scoped_refptr<VideoFrameBuffer>& frame,
                      rtc::scoped_refptr<I420Buffer>* denoised_frame,
@@ -61,6 +65,12 @@ class VideoDenoiser {
   // Copy luma margin blocks when frame width/height not divisible by 16.
   void CopyLumaOnMargin(const uint8_t* y_src, uint8_t* y_dst);
 
+  // A frame is static when all but a few of its blocks were filtered and
+  // none of the rest has skin color.
+  bool IsStaticFrame(const uint8_t* y_src,
+                     const uint8_t* u_src,
+                     const uint8_t* v_src);
+
   int width_;
   int height_;
   int mb_rows_;
@@ -80,6 +90,7 @@ class VideoDenoiser {
   std::unique_ptr<uint8_t[]> y_density_;
   // Save the return values by MbDenoise for each block.
   std::unique_ptr<DenoiserDecision[]> mb_filter_decision_;
+  bool last_frame_static_;
 };
 
 }  // namespace webrtc
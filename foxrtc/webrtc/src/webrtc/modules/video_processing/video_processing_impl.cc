@@ -63,6 +63,11 @@ void VideoProcessingImpl::EnableDenoising(bool enable) {
   frame_pre_processor_.EnableDenoising(enable);
 }
 
+void VideoProcessingImpl::EnableStaticSceneSkipping(bool enable) {
+  rtc::CritScope cs(&mutex_);
+  frame_pre_processor_.EnableStaticSceneSkipping(enable);
+}
+
 const VideoFrame* VideoProcessingImpl::PreprocessFrame(
     const VideoFrame& frame) {
   rtc::CritScope mutex(&mutex_);
@@ -33,6 +33,7 @@ class VideoProcessingImpl : public VideoProcessing {
   uint32_t GetDecimatedWidth() const override;
   uint32_t GetDecimatedHeight() const override;
   void EnableDenoising(bool enable) override;
+  void EnableStaticSceneSkipping(bool enable) override;
   const VideoFrame* PreprocessFrame(const VideoFrame& frame) override;
 
  private:
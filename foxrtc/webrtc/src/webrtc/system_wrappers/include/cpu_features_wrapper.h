@@ -20,7 +20,10 @@ extern "C" {
 // List of features in x86.
 typedef enum {
   kSSE2,
-  kSSE3
+  kSSE3,
+  // These two are only reported if the OS also saves the YMM registers.
+  kAVX2,
+  kFMA3
 } CPUFeature;
 
 // List of features in ARM.
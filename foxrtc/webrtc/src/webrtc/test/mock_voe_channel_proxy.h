@@ -51,8 +51,9 @@ class MockVoEChannelProxy : public voe::ChannelProxy {
   // MOCK_METHOD1(SetSink, void(std::unique_ptr<AudioSinkInterface> sink));
   MOCK_METHOD1(RegisterExternalTransport, void(Transport* transport));
   MOCK_METHOD0(DeRegisterExternalTransport, void());
-  MOCK_METHOD3(ReceivedRTPPacket, bool(const uint8_t* packet,
+  MOCK_METHOD4(ReceivedRTPPacket, bool(const uint8_t* packet,
                                        size_t length,
+                                       const RTPHeader& header,
                                        const PacketTime& packet_time));
   MOCK_METHOD2(ReceivedRTCPPacket, bool(const uint8_t* packet, size_t length));
   MOCK_CONST_METHOD0(GetAudioDecoderFactory,
@@ -0,0 +1,173 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/video/decode_worker_pool.h"
+
+#include <algorithm>
+
+#include "webrtc/base/checks.h"
+
+namespace webrtc {
+namespace {
+// Upper bound on how long an idle worker sleeps, which also bounds how long
+// shutdown can take.
+const int kMaxWaitMs = 50;
+}  // namespace
+
+DecodeWorkerPool::DecodeWorkerPool(Clock* clock, int num_workers)
+    : clock_(clock),
+      stopping_(false),
+      wake_event_(false, false),
+      decode_done_event_(false, false) {
+  RTC_DCHECK_GT(num_workers, 0);
+  for (int i = 0; i < num_workers; ++i) {
+    workers_.emplace_back(
+        new rtc::PlatformThread(&DecodeWorkerPool::WorkerThread, this,
+                                "DecodeWorker"));
+    workers_.back()->Start();
+    workers_.back()->SetPriority(rtc::kHighestPriority);
+  }
+}
+
+DecodeWorkerPool::~DecodeWorkerPool() {
+  {
+    rtc::CritScope lock(&crit_);
+    RTC_DCHECK(entries_.empty());
+    stopping_ = true;
+  }
+  // |wake_event_| auto-resets and wakes one worker. Each worker passes it on
+  // as it exits, see Process().
+  wake_event_.Set();
+  for (auto& worker : workers_)
+    worker->Stop();
+}
+
+void DecodeWorkerPool::AddStream(Stream* stream, int priority) {
+  rtc::CritScope lock(&crit_);
+  Entry entry;
+  entry.stream = stream;
+  entry.priority = priority;
+  entry.next_decode_ms = -1;
+  entry.busy = false;
+  entry.woken = false;
+  entries_.push_back(entry);
+}
+
+void DecodeWorkerPool::RemoveStream(Stream* stream) {
+  while (true) {
+    {
+      rtc::CritScope lock(&crit_);
+      auto it = std::find_if(
+          entries_.begin(), entries_.end(),
+          [stream](const Entry& entry) { return entry.stream == stream; });
+      if (it == entries_.end())
+        return;
+      if (!it->busy) {
+        entries_.erase(it);
+        return;
+      }
+    }
+    decode_done_event_.Wait(kMaxWaitMs);
+  }
+}
+
+void DecodeWorkerPool::Wake(Stream* stream) {
+  {
+    rtc::CritScope lock(&crit_);
+    for (Entry& entry : entries_) {
+      if (entry.stream != stream)
+        continue;
+      if (entry.busy) {
+        entry.woken = true;
+        return;
+      }
+      // A stream waiting for the decode time of an earlier frame is already
+      // scheduled; new packets can only belong to later frames.
+      if (entry.next_decode_ms >= 0)
+        return;
+      entry.next_decode_ms = clock_->TimeInMilliseconds();
+      break;
+    }
+  }
+  wake_event_.Set();
+}
+
+bool DecodeWorkerPool::WorkerThread(void* obj) {
+  return static_cast<DecodeWorkerPool*>(obj)->Process();
+}
+
+bool DecodeWorkerPool::Process() {
+  Entry* entry = nullptr;
+  int64_t wait_ms = kMaxWaitMs;
+  {
+    rtc::CritScope lock(&crit_);
+    if (stopping_) {
+      wake_event_.Set();
+      return false;
+    }
+    entry = NextEntry(clock_->TimeInMilliseconds(), &wait_ms);
+    if (entry) {
+      entry->busy = true;
+      entry->woken = false;
+    }
+  }
+  if (!entry) {
+    wake_event_.Wait(static_cast<int>(wait_ms));
+    return true;
+  }
+
+  // |entry| stays valid while busy, RemoveStream() waits for it.
+  int64_t next_decode_ms = entry->stream->DecodeNextFrame();
+  {
+    rtc::CritScope lock(&crit_);
+    entry->busy = false;
+    if (entry->woken) {
+      int64_t now_ms = clock_->TimeInMilliseconds();
+      if (next_decode_ms < 0 || next_decode_ms > now_ms)
+        next_decode_ms = now_ms;
+    }
+    entry->next_decode_ms = next_decode_ms;
+  }
+  decode_done_event_.Set();
+  return true;
+}
+
+DecodeWorkerPool::Entry* DecodeWorkerPool::NextEntry(int64_t now_ms,
+                                                     int64_t* wait_ms) {
+  Entry* earliest = nullptr;
+  Entry* highest_priority = nullptr;
+  int num_ready = 0;
+  for (Entry& entry : entries_) {
+    if (entry.busy || entry.next_decode_ms < 0)
+      continue;
+    if (entry.next_decode_ms > now_ms) {
+      *wait_ms = std::min(*wait_ms, entry.next_decode_ms - now_ms);
+      continue;
+    }
+    ++num_ready;
+    if (!earliest || entry.next_decode_ms < earliest->next_decode_ms)
+      earliest = &entry;
+    if (!highest_priority || entry.priority > highest_priority->priority ||
+        (entry.priority == highest_priority->priority &&
+         entry.next_decode_ms < highest_priority->next_decode_ms)) {
+      highest_priority = &entry;
+    }
+  }
+  if (!earliest)
+    return nullptr;
+  // Hand the rest of the ready streams to another worker.
+  if (num_ready > 1)
+    wake_event_.Set();
+  if (now_ms - earliest->next_decode_ms > kOverloadThresholdMs)
+    return highest_priority;
+  return earliest;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_VIDEO_DECODE_WORKER_POOL_H_
+#define WEBRTC_VIDEO_DECODE_WORKER_POOL_H_
+
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/base/thread_annotations.h"
+#include "webrtc/system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Decodes video for any number of receive streams on a fixed number of
+// threads, instead of one highest-priority thread per stream. A stream is
+// decoded one frame at a time and never on two workers at once. Ready streams
+// are served earliest decode time first; once the pool has fallen more than
+// kOverloadThresholdMs behind, they are served by priority instead, so that
+// low priority streams are the ones whose frames arrive too late and get
+// dropped.
+class DecodeWorkerPool {
+ public:
+  class Stream {
+   public:
+    // Decodes at most one frame without blocking. Returns when the stream
+    // should be called again: no later than now if another frame may be
+    // ready, the decode time of a frame that is buffered but not yet due, or
+    // -1 if nothing is buffered.
+    virtual int64_t DecodeNextFrame() = 0;
+
+   protected:
+    virtual ~Stream() {}
+  };
+
+  static const int64_t kOverloadThresholdMs = 20;
+
+  DecodeWorkerPool(Clock* clock, int num_workers);
+  ~DecodeWorkerPool();
+
+  // Streams with a higher |priority| are decoded first under overload.
+  void AddStream(Stream* stream, int priority);
+  // Returns once no worker is decoding |stream| anymore.
+  void RemoveStream(Stream* stream);
+  // Tells the pool that new data has arrived for an idle |stream|.
+  void Wake(Stream* stream);
+
+ private:
+  struct Entry {
+    Stream* stream;
+    int priority;
+    // Next time the stream should be decoded, -1 while idle.
+    int64_t next_decode_ms;
+    bool busy;
+    // Woken while being decoded.
+    bool woken;
+  };
+
+  static bool WorkerThread(void* obj);
+  bool Process();
+  // Returns the entry to decode now, or null and the time until one is due.
+  Entry* NextEntry(int64_t now_ms, int64_t* wait_ms)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  Clock* const clock_;
+  rtc::CriticalSection crit_;
+  std::list<Entry> entries_ GUARDED_BY(crit_);
+  bool stopping_ GUARDED_BY(crit_);
+  rtc::Event wake_event_;
+  rtc::Event decode_done_event_;
+  std::vector<std::unique_ptr<rtc::PlatformThread>> workers_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(DecodeWorkerPool);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_VIDEO_DECODE_WORKER_POOL_H_
@@ -0,0 +1,201 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <vector>
+
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/video/decode_worker_pool.h"
+
+namespace webrtc {
+namespace {
+
+const int kWaitTimeoutMs = 5000;
+
+// Pretends to have |frames| buffered frames, all of them due now, and signals
+// |drained| once they have been decoded.
+class FakeStream : public DecodeWorkerPool::Stream {
+ public:
+  FakeStream(Clock* clock, int frames)
+      : clock_(clock),
+        frames_left_(frames),
+        decoded_frames_(0),
+        in_decode_(false),
+        concurrent_decode_(false),
+        drained_(false, false) {}
+
+  int64_t DecodeNextFrame() override {
+    {
+      rtc::CritScope lock(&crit_);
+      if (in_decode_)
+        concurrent_decode_ = true;
+      in_decode_ = true;
+    }
+    // Give other workers a chance to pick the same stream.
+    SleepMs(1);
+    rtc::CritScope lock(&crit_);
+    in_decode_ = false;
+    if (frames_left_ == 0)
+      return -1;
+    ++decoded_frames_;
+    if (--frames_left_ == 0) {
+      drained_.Set();
+      return -1;
+    }
+    return clock_->TimeInMilliseconds();
+  }
+
+  void AddFrames(int frames) {
+    rtc::CritScope lock(&crit_);
+    frames_left_ += frames;
+  }
+
+  int decoded_frames() {
+    rtc::CritScope lock(&crit_);
+    return decoded_frames_;
+  }
+
+  bool concurrent_decode() {
+    rtc::CritScope lock(&crit_);
+    return concurrent_decode_;
+  }
+
+  rtc::Event* drained() { return &drained_; }
+
+ private:
+  static void SleepMs(int ms) {
+    rtc::Event sleep(false, false);
+    sleep.Wait(ms);
+  }
+
+  Clock* const clock_;
+  rtc::CriticalSection crit_;
+  int frames_left_;
+  int decoded_frames_;
+  bool in_decode_;
+  bool concurrent_decode_;
+  rtc::Event drained_;
+};
+
+// Always behind schedule by more than the overload threshold. Records the
+// order in which the streams sharing |log| were decoded.
+class OverloadedStream : public DecodeWorkerPool::Stream {
+ public:
+  OverloadedStream(Clock* clock,
+                   int id,
+                   int frames,
+                   rtc::CriticalSection* crit,
+                   std::vector<int>* log)
+      : clock_(clock), id_(id), frames_left_(frames), crit_(crit), log_(log) {}
+
+  int64_t DecodeNextFrame() override {
+    rtc::CritScope lock(crit_);
+    if (frames_left_ == 0)
+      return -1;
+    log_->push_back(id_);
+    if (--frames_left_ == 0)
+      return -1;
+    return clock_->TimeInMilliseconds() -
+           2 * DecodeWorkerPool::kOverloadThresholdMs;
+  }
+
+ private:
+  Clock* const clock_;
+  const int id_;
+  int frames_left_;
+  rtc::CriticalSection* const crit_;
+  std::vector<int>* const log_;
+};
+
+}  // namespace
+
+TEST(DecodeWorkerPoolTest, DecodesWokenStreamUntilDrained) {
+  Clock* clock = Clock::GetRealTimeClock();
+  DecodeWorkerPool pool(clock, 2);
+  FakeStream stream(clock, 5);
+  pool.AddStream(&stream, 0);
+
+  pool.Wake(&stream);
+  EXPECT_TRUE(stream.drained()->Wait(kWaitTimeoutMs));
+  EXPECT_EQ(5, stream.decoded_frames());
+
+  // An idle stream is picked up again when woken.
+  stream.AddFrames(3);
+  pool.Wake(&stream);
+  EXPECT_TRUE(stream.drained()->Wait(kWaitTimeoutMs));
+  EXPECT_EQ(8, stream.decoded_frames());
+
+  pool.RemoveStream(&stream);
+}
+
+TEST(DecodeWorkerPoolTest, NeverDecodesStreamConcurrently) {
+  Clock* clock = Clock::GetRealTimeClock();
+  DecodeWorkerPool pool(clock, 4);
+  FakeStream stream1(clock, 20);
+  FakeStream stream2(clock, 20);
+  pool.AddStream(&stream1, 0);
+  pool.AddStream(&stream2, 0);
+
+  // Repeated wakes while busy must not start a second decode of a stream.
+  for (int i = 0; i < 10; ++i) {
+    pool.Wake(&stream1);
+    pool.Wake(&stream2);
+  }
+  EXPECT_TRUE(stream1.drained()->Wait(kWaitTimeoutMs));
+  EXPECT_TRUE(stream2.drained()->Wait(kWaitTimeoutMs));
+  EXPECT_FALSE(stream1.concurrent_decode());
+  EXPECT_FALSE(stream2.concurrent_decode());
+
+  pool.RemoveStream(&stream1);
+  pool.RemoveStream(&stream2);
+}
+
+TEST(DecodeWorkerPoolTest, PrefersHighPriorityStreamWhenOverloaded) {
+  Clock* clock = Clock::GetRealTimeClock();
+  rtc::CriticalSection crit;
+  std::vector<int> log;
+  const int kLowId = 0;
+  const int kHighId = 1;
+  const int kFrames = 10;
+  OverloadedStream low(clock, kLowId, kFrames, &crit, &log);
+  OverloadedStream high(clock, kHighId, kFrames, &crit, &log);
+  {
+    DecodeWorkerPool pool(clock, 1);
+    pool.AddStream(&low, 0);
+    pool.AddStream(&high, 1);
+    pool.Wake(&low);
+    pool.Wake(&high);
+
+    for (int i = 0; i < kWaitTimeoutMs; ++i) {
+      {
+        rtc::CritScope lock(&crit);
+        if (log.size() == 2 * kFrames)
+          break;
+      }
+      rtc::Event(false, false).Wait(1);
+    }
+    pool.RemoveStream(&low);
+    pool.RemoveStream(&high);
+  }
+
+  rtc::CritScope lock(&crit);
+  ASSERT_EQ(2u * kFrames, log.size());
+  // Once the high priority stream has been served, it keeps the only worker
+  // until it has nothing left to decode.
+  size_t first_high = 0;
+  while (log[first_high] != kHighId)
+    ++first_high;
+  for (size_t i = first_high; i < first_high + kFrames; ++i)
+    EXPECT_EQ(kHighId, log[i]) << "at " << i;
+}
+
+}  // namespace webrtc
@@ -283,13 +283,15 @@ class CodecObserver : public test::EndToEndTest,
                 VideoRotation rotation_to_test,
                 const std::string& payload_name,
                 webrtc::VideoEncoder* encoder,
-                webrtc::VideoDecoder* decoder)
+                webrtc::VideoDecoder* decoder,
+                bool use_frame_buffer = false)
       : EndToEndTest(2 * webrtc::EndToEndTest::kDefaultTimeoutMs),
         no_frames_to_wait_for_(no_frames_to_wait_for),
         expected_rotation_(rotation_to_test),
         payload_name_(payload_name),
         encoder_(encoder),
         decoder_(decoder),
+        use_frame_buffer_(use_frame_buffer),
         frame_counter_(0) {}
 
   void PerformTest() override {
@@ -306,6 +308,7 @@ class CodecObserver : public test::EndToEndTest,
     send_config->encoder_settings.payload_type = 126;
 
     (*receive_configs)[0].renderer = this;
+    (*receive_configs)[0].use_frame_buffer = use_frame_buffer_;
     (*receive_configs)[0].decoders.resize(1);
     (*receive_configs)[0].decoders[0].payload_type =
         send_config->encoder_settings.payload_type;
@@ -331,6 +334,7 @@ class CodecObserver : public test::EndToEndTest,
   std::string payload_name_;
   std::unique_ptr<webrtc::VideoEncoder> encoder_;
   std::unique_ptr<webrtc::VideoDecoder> decoder_;
+  const bool use_frame_buffer_;
   int frame_counter_;
 };
 
@@ -341,6 +345,13 @@ TEST_F(EndToEndTest, SendsAndReceivesVP8Rotation90) {
   RunBaseTest(&test);
 }
 
+TEST_F(EndToEndTest, SendsAndReceivesVP8WithFrameBuffer) {
+  CodecObserver test(500, kVideoRotation_0, "VP8",
+                     VideoEncoder::Create(VideoEncoder::kVp8),
+                     VP8Decoder::Create(), true);
+  RunBaseTest(&test);
+}
+
 #if !defined(RTC_DISABLE_VP9)
 TEST_F(EndToEndTest, SendsAndReceivesVP9) {
   CodecObserver test(500, kVideoRotation_0, "VP9",
@@ -349,6 +360,13 @@ TEST_F(EndToEndTest, SendsAndReceivesVP9) {
   RunBaseTest(&test);
 }
 
+TEST_F(EndToEndTest, SendsAndReceivesVP9WithFrameBuffer) {
+  CodecObserver test(500, kVideoRotation_0, "VP9",
+                     VideoEncoder::Create(VideoEncoder::kVp9),
+                     VP9Decoder::Create(), true);
+  RunBaseTest(&test);
+}
+
 TEST_F(EndToEndTest, SendsAndReceivesVP9VideoRotation90) {
   CodecObserver test(5, kVideoRotation_90, "VP9",
                      VideoEncoder::Create(VideoEncoder::kVp9),
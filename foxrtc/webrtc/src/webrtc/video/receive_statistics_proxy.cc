@@ -165,6 +165,11 @@ void ReceiveStatisticsProxy::OnDecoderImplementationName(
   rtc::CritScope lock(&crit_);
   stats_.decoder_implementation_name = implementation_name;
 }
+
+void ReceiveStatisticsProxy::OnFrameDecodeTime(int decode_time_ms) {
+  rtc::CritScope lock(&crit_);
+  stats_.decode_time_histogram.Add(decode_time_ms);
+}
 void ReceiveStatisticsProxy::OnIncomingRate(unsigned int framerate,
                                             unsigned int bitrate_bps) {
   rtc::CritScope lock(&crit_);
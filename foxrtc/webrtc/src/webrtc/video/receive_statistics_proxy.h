@@ -48,6 +48,7 @@ class ReceiveStatisticsProxy : public VCMReceiveStatisticsCallback,
   void OnRenderedFrame(const VideoFrame& frame);
   void OnIncomingPayloadType(int payload_type);
   void OnDecoderImplementationName(const char* implementation_name);
+  void OnFrameDecodeTime(int decode_time_ms);
   void OnIncomingRate(unsigned int framerate, unsigned int bitrate_bps);
   void OnDecoderTiming(int decode_ms,
                        int max_decode_ms,
@@ -10,6 +10,7 @@
 
 #include "webrtc/video/rtp_stream_receiver.h"
 
+#include <utility>
 #include <vector>
 
 #include "webrtc/base/checks.h"
@@ -24,6 +25,10 @@
 #include "webrtc/modules/rtp_rtcp/include/rtp_header_parser.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_receiver.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp.h"
+#include "webrtc/modules/video_coding/frame_object.h"
+#include "webrtc/modules/video_coding/nack_module.h"
+#include "webrtc/modules/video_coding/packet.h"
+#include "webrtc/modules/video_coding/timing.h"
 #include "webrtc/modules/video_coding/video_coding_impl.h"
 #include "webrtc/system_wrappers/include/metrics.h"
 #include "webrtc/system_wrappers/include/timestamp_extrapolator.h"
@@ -71,6 +76,9 @@ std::unique_ptr<RtpRtcp> CreateRtpRtcpModule(
 }
 
 static const int kPacketLogIntervalMs = 10000;
+// Both must be powers of two, see video_coding::PacketBuffer.
+static const size_t kPacketBufferStartSize = 32;
+static const size_t kPacketBufferMaxSize = 2048;
 
 RtpStreamReceiver::RtpStreamReceiver(
     vcm::VideoReceiver* video_receiver,
@@ -83,7 +91,11 @@ RtpStreamReceiver::RtpStreamReceiver(
     const VideoReceiveStream::Config* config,
     ReceiveStatisticsProxy* receive_stats_proxy,
     ProcessThread* process_thread,
-    RateLimiter* retransmission_rate_limiter)
+    RateLimiter* retransmission_rate_limiter,
+    NackSender* nack_sender,
+    KeyFrameRequestSender* keyframe_request_sender,
+    video_coding::OnCompleteFrameCallback* complete_frame_callback,
+    VCMTiming* timing)
     : clock_(Clock::GetRealTimeClock()),
       config_(*config),
       video_receiver_(video_receiver),
@@ -110,7 +122,11 @@ RtpStreamReceiver::RtpStreamReceiver(
                                     remote_bitrate_estimator_,
                                     paced_sender,
                                     packet_router,
-                                    retransmission_rate_limiter)) {
+                                    retransmission_rate_limiter)),
+      keyframe_request_sender_(keyframe_request_sender),
+      complete_frame_callback_(complete_frame_callback),
+      timing_(timing),
+      has_received_frame_(false) {
   packet_router_->AddRtpModule(rtp_rtcp_.get());
   rtp_receive_statistics_->RegisterRtpStatisticsCallback(receive_stats_proxy);
   rtp_receive_statistics_->RegisterRtcpStatisticsCallback(receive_stats_proxy);
@@ -191,10 +207,26 @@ RtpStreamReceiver::RtpStreamReceiver(
   rtp_rtcp_->RegisterRtcpStatisticsCallback(receive_stats_proxy);
 
   process_thread_->RegisterModule(rtp_rtcp_.get());
+
+  if (config_.use_frame_buffer) {
+    RTC_DCHECK(keyframe_request_sender_);
+    RTC_DCHECK(complete_frame_callback_);
+    RTC_DCHECK(timing_);
+    if (config_.rtp.nack.rtp_history_ms > 0) {
+      nack_module_.reset(
+          new NackModule(clock_, nack_sender, keyframe_request_sender));
+      process_thread_->RegisterModule(nack_module_.get());
+    }
+    packet_buffer_ = video_coding::PacketBuffer::Create(
+        clock_, kPacketBufferStartSize, kPacketBufferMaxSize, this);
+    reference_finder_.reset(new video_coding::RtpFrameReferenceFinder(this));
+  }
 }
 
 RtpStreamReceiver::~RtpStreamReceiver() {
   process_thread_->DeRegisterModule(rtp_rtcp_.get());
+  if (nack_module_)
+    process_thread_->DeRegisterModule(nack_module_.get());
 
   packet_router_->RemoveRtpModule(rtp_rtcp_.get());
   rtp_rtcp_->SetREMBStatus(false);
@@ -235,6 +267,20 @@ int32_t RtpStreamReceiver::OnReceivedPayloadData(
   WebRtcRTPHeader rtp_header_with_ntp = *rtp_header;
   rtp_header_with_ntp.ntp_time_ms =
       ntp_estimator_.Estimate(rtp_header->header.timestamp);
+  if (packet_buffer_) {
+    VCMPacket packet(payload_data, payload_size, rtp_header_with_ntp);
+    timing_->IncomingTimestamp(packet.timestamp, clock_->TimeInMilliseconds());
+    if (nack_module_)
+      packet.timesNacked = nack_module_->OnReceivedPacket(packet);
+    if (packet.sizeBytes == 0) {
+      // Padding still closes gaps in the picture id sequence.
+      reference_finder_->PaddingReceived(packet.seqNum);
+      return 0;
+    }
+    if (!packet_buffer_->InsertPacket(packet))
+      return -1;
+    return 0;
+  }
   if (video_receiver_->IncomingPacket(payload_data, payload_size,
                                       rtp_header_with_ntp) != 0) {
     // Check this...
@@ -327,6 +373,65 @@ bool RtpStreamReceiver::DeliverRtp(const uint8_t* rtp_packet,
   return ret;
 }
 
+void RtpStreamReceiver::OnReceivedFrame(
+    std::unique_ptr<video_coding::RtpFrameObject> frame) {
+  if (!has_received_frame_) {
+    has_received_frame_ = true;
+    // Nothing can be decoded before a key frame, ask for one right away.
+    if (frame->FrameType() != kVideoFrameKey)
+      keyframe_request_sender_->RequestKeyFrame();
+  }
+  reference_finder_->ManageFrame(std::move(frame));
+}
+
+void RtpStreamReceiver::OnCompleteFrame(
+    std::unique_ptr<video_coding::FrameObject> frame) {
+  {
+    rtc::CritScope lock(&last_seq_num_cs_);
+    video_coding::RtpFrameObject* rtp_frame =
+        static_cast<video_coding::RtpFrameObject*>(frame.get());
+    last_seq_num_for_pic_id_[rtp_frame->picture_id] =
+        rtp_frame->last_seq_num();
+  }
+  complete_frame_callback_->OnCompleteFrame(std::move(frame));
+}
+
+void RtpStreamReceiver::OnRttUpdate(int64_t avg_rtt_ms, int64_t max_rtt_ms) {
+  if (nack_module_)
+    nack_module_->UpdateRtt(max_rtt_ms);
+}
+
+void RtpStreamReceiver::FrameContinuous(uint16_t picture_id) {
+  if (!nack_module_)
+    return;
+  int seq_num = -1;
+  {
+    rtc::CritScope lock(&last_seq_num_cs_);
+    auto seq_num_it = last_seq_num_for_pic_id_.find(picture_id);
+    if (seq_num_it != last_seq_num_for_pic_id_.end())
+      seq_num = seq_num_it->second;
+  }
+  if (seq_num != -1)
+    nack_module_->ClearUpTo(seq_num);
+}
+
+void RtpStreamReceiver::FrameDecoded(uint16_t picture_id) {
+  int seq_num = -1;
+  {
+    rtc::CritScope lock(&last_seq_num_cs_);
+    auto seq_num_it = last_seq_num_for_pic_id_.find(picture_id);
+    if (seq_num_it != last_seq_num_for_pic_id_.end()) {
+      seq_num = seq_num_it->second;
+      last_seq_num_for_pic_id_.erase(last_seq_num_for_pic_id_.begin(),
+                                     ++seq_num_it);
+    }
+  }
+  if (seq_num != -1) {
+    packet_buffer_->ClearTo(seq_num);
+    reference_finder_->ClearTo(seq_num);
+  }
+}
+
 int32_t RtpStreamReceiver::RequestKeyFrame() {
   return rtp_rtcp_->RequestKeyFrame();
 }
@@ -12,12 +12,14 @@
 #define WEBRTC_VIDEO_RTP_STREAM_RECEIVER_H_
 
 #include <list>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/criticalsection.h"
+#include "webrtc/base/scoped_ref_ptr.h"
 #include "webrtc/engine_configurations.h"
 #include "webrtc/modules/rtp_rtcp/include/receive_statistics.h"
 #include "webrtc/modules/rtp_rtcp/include/remote_ntp_time_estimator.h"
@@ -25,12 +27,15 @@
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "webrtc/modules/video_coding/include/video_coding_defines.h"
+#include "webrtc/modules/video_coding/packet_buffer.h"
+#include "webrtc/modules/video_coding/rtp_frame_reference_finder.h"
 #include "webrtc/typedefs.h"
 #include "webrtc/video_receive_stream.h"
 
 namespace webrtc {
 
 class FecReceiver;
+class NackModule;
 class PacedSender;
 class PacketRouter;
 class ProcessThread;
@@ -43,6 +48,7 @@ class RtpHeaderParser;
 class RTPPayloadRegistry;
 class RtpReceiver;
 class Transport;
+class VCMTiming;
 class VieRemb;
 
 namespace vcm {
@@ -51,8 +57,15 @@ class VideoReceiver;
 
 class RtpStreamReceiver : public RtpData, public RtpFeedback,
                           public VCMFrameTypeCallback,
-                          public VCMPacketRequestCallback {
+                          public VCMPacketRequestCallback,
+                          public video_coding::OnReceivedFrameCallback,
+                          public video_coding::OnCompleteFrameCallback,
+                          public CallStatsObserver {
  public:
+  // With |config->use_frame_buffer| set, packets bypass |video_receiver|'s
+  // jitter buffer and complete frames are passed to |complete_frame_callback|
+  // instead. |nack_sender|, |keyframe_request_sender| and |timing| are only
+  // used in that mode.
   RtpStreamReceiver(vcm::VideoReceiver* video_receiver,
                     RemoteBitrateEstimator* remote_bitrate_estimator,
                     Transport* transport,
@@ -63,7 +76,12 @@ class RtpStreamReceiver : public RtpData, public RtpFeedback,
                     const VideoReceiveStream::Config* config,
                     ReceiveStatisticsProxy* receive_stats_proxy,
                     ProcessThread* process_thread,
-                    RateLimiter* retransmission_rate_limiter);
+                    RateLimiter* retransmission_rate_limiter,
+                    NackSender* nack_sender,
+                    KeyFrameRequestSender* keyframe_request_sender,
+                    video_coding::OnCompleteFrameCallback*
+                        complete_frame_callback,
+                    VCMTiming* timing);
   ~RtpStreamReceiver();
 
   bool SetReceiveCodec(const VideoCodec& video_codec);
@@ -112,6 +130,25 @@ class RtpStreamReceiver : public RtpData, public RtpFeedback,
   int32_t ResendPackets(const uint16_t* sequenceNumbers,
                         uint16_t length) override;
 
+  // Implements OnReceivedFrameCallback.
+  void OnReceivedFrame(
+      std::unique_ptr<video_coding::RtpFrameObject> frame) override;
+
+  // Implements OnCompleteFrameCallback.
+  void OnCompleteFrame(
+      std::unique_ptr<video_coding::FrameObject> frame) override;
+
+  // Implements CallStatsObserver.
+  void OnRttUpdate(int64_t avg_rtt_ms, int64_t max_rtt_ms) override;
+
+  // Called by the frame buffer once all frames up to |picture_id| are
+  // continuous, so that packets before it are no longer NACKed.
+  void FrameContinuous(uint16_t picture_id);
+
+  // Called once the frame with |picture_id| has been decoded, releasing the
+  // packets of it and of all frames before it.
+  void FrameDecoded(uint16_t picture_id);
+
  private:
   bool ReceivePacket(const uint8_t* packet,
                      size_t packet_length,
@@ -152,6 +189,20 @@ class RtpStreamReceiver : public RtpData, public RtpFeedback,
   int64_t last_packet_log_ms_ GUARDED_BY(receive_cs_);
 
   const std::unique_ptr<RtpRtcp> rtp_rtcp_;
+
+  // Members for the frame buffer receive mode, see
+  // VideoReceiveStream::Config::use_frame_buffer.
+  KeyFrameRequestSender* const keyframe_request_sender_;
+  video_coding::OnCompleteFrameCallback* const complete_frame_callback_;
+  VCMTiming* const timing_;
+  // Null unless NACK is enabled.
+  std::unique_ptr<NackModule> nack_module_;
+  rtc::scoped_refptr<video_coding::PacketBuffer> packet_buffer_;
+  std::unique_ptr<video_coding::RtpFrameReferenceFinder> reference_finder_;
+  rtc::CriticalSection last_seq_num_cs_;
+  std::map<uint16_t, uint16_t, DescendingSeqNumComp<uint16_t>>
+      last_seq_num_for_pic_id_ GUARDED_BY(last_seq_num_cs_);
+  bool has_received_frame_;
 };
 
 }  // namespace webrtc
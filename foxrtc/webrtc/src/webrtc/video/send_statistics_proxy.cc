@@ -367,6 +367,7 @@ void SendStatisticsProxy::OnEncodedFrameTimeMeasured(
   uma_container_->encode_time_counter_.Add(encode_time_ms);
   encode_time_.Apply(1.0f, encode_time_ms);
   stats_.avg_encode_time_ms = round(encode_time_.filtered());
+  stats_.encode_time_histogram.Add(encode_time_ms);
   stats_.encode_usage_percent = metrics.encode_usage_percent;
 }
 
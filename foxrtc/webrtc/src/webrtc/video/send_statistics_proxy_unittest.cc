@@ -288,6 +288,29 @@ TEST_F(SendStatisticsProxyTest, OnEncodedFrameTimeMeasured) {
   VideoSendStream::Stats stats = statistics_proxy_->GetStats();
   EXPECT_EQ(kEncodeTimeMs, stats.avg_encode_time_ms);
   EXPECT_EQ(metrics.encode_usage_percent, stats.encode_usage_percent);
+  EXPECT_EQ(1u, stats.encode_time_histogram.num_frames);
+  EXPECT_EQ(kEncodeTimeMs, stats.encode_time_histogram.max_ms);
+}
+
+TEST_F(SendStatisticsProxyTest, EncodeTimeHistogram) {
+  CpuOveruseMetrics metrics;
+  // 90 fast frames, 9 at 20 ms and one that overflows the last bucket.
+  for (int i = 0; i < 90; ++i)
+    statistics_proxy_->OnEncodedFrameTimeMeasured(3, metrics);
+  for (int i = 0; i < 9; ++i)
+    statistics_proxy_->OnEncodedFrameTimeMeasured(20, metrics);
+  statistics_proxy_->OnEncodedFrameTimeMeasured(500, metrics);
+
+  const FrameTimeHistogram& histogram =
+      statistics_proxy_->GetStats().encode_time_histogram;
+  EXPECT_EQ(100u, histogram.num_frames);
+  EXPECT_EQ(90u, histogram.buckets[3 / FrameTimeHistogram::kBucketMs]);
+  EXPECT_EQ(9u, histogram.buckets[20 / FrameTimeHistogram::kBucketMs]);
+  EXPECT_EQ(1u, histogram.buckets[FrameTimeHistogram::kNumBuckets - 1]);
+  EXPECT_EQ(4, histogram.Percentile(50));
+  EXPECT_EQ(22, histogram.Percentile(95));
+  EXPECT_EQ(500, histogram.Percentile(100));
+  EXPECT_EQ(500, histogram.max_ms);
 }
 
 TEST_F(SendStatisticsProxyTest, OnEncoderReconfiguredChangePreferredBitrate) {
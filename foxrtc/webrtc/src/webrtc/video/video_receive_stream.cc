@@ -50,6 +50,12 @@ std::string VideoReceiveStream::Decoder::ToString() const {
   ss << " h264_extra_settings: "
      << (decoder_specific.h264_extra_settings ? "(h264_extra_settings)"
                                               : "nullptr");
+  ss << ", vp9_settings: {number_of_threads: "
+     << decoder_specific.vp9_settings.number_of_threads
+     << ", frame_parallel_decoding: "
+     << (decoder_specific.vp9_settings.frame_parallel_decoding ? "on"
+                                                               : "off");
+  ss << '}';
   ss << '}';
   ss << '}';
 
@@ -68,6 +74,7 @@ std::string VideoReceiveStream::Config::ToString() const {
   ss << ", rtp: " << rtp.ToString();
   ss << ", renderer: " << (renderer ? "(renderer)" : "nullptr");
   ss << ", render_delay_ms: " << render_delay_ms;
+  ss << ", use_frame_buffer: " << (use_frame_buffer ? "on" : "off");
   if (!sync_group.empty())
     ss << ", sync_group: " << sync_group;
   ss << ", pre_decode_callback: "
@@ -127,6 +134,7 @@ std::string VideoReceiveStream::Stats::ToString(int64_t time_ms) const {
   ss << "render_fps: " << render_frame_rate << ", ";
   ss << "decode_ms: " << decode_ms << ", ";
   ss << "max_decode_ms: " << max_decode_ms << ", ";
+  ss << "p95_decode_ms: " << decode_time_histogram.Percentile(95) << ", ";
   ss << "cur_delay_ms: " << current_delay_ms << ", ";
   ss << "targ_delay_ms: " << target_delay_ms << ", ";
   ss << "jb_delay_ms: " << jitter_buffer_ms << ", ";
@@ -163,6 +171,10 @@ VideoCodec CreateDecoderVideoCodec(const VideoReceiveStream::Decoder& decoder) {
     codec.codecSpecific.VP8 = VideoEncoder::GetDefaultVp8Settings();
   } else if (codec.codecType == kVideoCodecVP9) {
     codec.codecSpecific.VP9 = VideoEncoder::GetDefaultVp9Settings();
+    codec.codecSpecific.VP9.numberOfThreads =
+        decoder.decoder_specific.vp9_settings.number_of_threads;
+    codec.codecSpecific.VP9.frameParallelDecoding =
+        decoder.decoder_specific.vp9_settings.frame_parallel_decoding;
   } else if (codec.codecType == kVideoCodecH264) {
     codec.codecSpecific.H264 = VideoEncoder::GetDefaultH264Settings();
   }
@@ -185,15 +197,29 @@ VideoReceiveStream::VideoReceiveStream(
     webrtc::VoiceEngine* voice_engine,
     ProcessThread* process_thread,
     CallStats* call_stats,
-    VieRemb* remb)
+    VieRemb* remb,
+    DecodeWorkerPool* decode_worker_pool)
     : transport_adapter_(config.rtcp_send_transport),
       config_(std::move(config)),
       process_thread_(process_thread),
       clock_(Clock::GetRealTimeClock()),
       decode_thread_(DecodeThreadFunction, this, "DecodingThread"),
+      // The frame buffer already wakes the decode thread exactly when a
+      // frame becomes decodable.
+      decode_worker_pool_(config_.use_frame_buffer ? nullptr
+                                                   : decode_worker_pool),
+      decoding_(false),
       congestion_controller_(congestion_controller),
       call_stats_(call_stats),
       video_receiver_(clock_, nullptr, this, this, this),
+      jitter_estimator_(config_.use_frame_buffer
+                            ? new VCMJitterEstimator(clock_)
+                            : nullptr),
+      frame_buffer_(config_.use_frame_buffer
+                        ? new video_coding::FrameBuffer(
+                              clock_, jitter_estimator_.get(),
+                              video_receiver_.timing())
+                        : nullptr),
       stats_proxy_(&config_, clock_),
       rtp_stream_receiver_(
           &video_receiver_,
@@ -207,7 +233,11 @@ VideoReceiveStream::VideoReceiveStream(
           &config_,
           &stats_proxy_,
           process_thread_,
-          congestion_controller_->GetRetransmissionRateLimiter()),
+          congestion_controller_->GetRetransmissionRateLimiter(),
+          this,
+          this,
+          this,
+          video_receiver_.timing()),
       rtp_stream_sync_(&video_receiver_, &rtp_stream_receiver_) {
   LOG(LS_INFO) << "VideoReceiveStream: " << config_.ToString();
 
@@ -269,11 +299,15 @@ bool VideoReceiveStream::DeliverRtcp(const uint8_t* packet, size_t length) {
 bool VideoReceiveStream::DeliverRtp(const uint8_t* packet,
                                     size_t length,
                                     const PacketTime& packet_time) {
-  return rtp_stream_receiver_.DeliverRtp(packet, length, packet_time);
+  if (!rtp_stream_receiver_.DeliverRtp(packet, length, packet_time))
+    return false;
+  if (decode_worker_pool_)
+    decode_worker_pool_->Wake(this);
+  return true;
 }
 
 void VideoReceiveStream::Start() {
-  if (decode_thread_.IsRunning())
+  if (decoding_)
     return;
   transport_adapter_.Enable();
   rtc::VideoSinkInterface<VideoFrame>* renderer = nullptr;
@@ -295,9 +329,23 @@ void VideoReceiveStream::Start() {
       config_.pre_render_callback));
   // Register the channel to receive stats updates.
   call_stats_->RegisterStatsObserver(video_stream_decoder_.get());
+  if (frame_buffer_) {
+    call_stats_->RegisterStatsObserver(&rtp_stream_receiver_);
+    frame_buffer_->SetProtectionMode(
+        rtp_stream_receiver_.IsFecEnabled() &&
+                rtp_stream_receiver_.IsRetransmissionsEnabled()
+            ? kProtectionNackFEC
+            : kProtectionNack);
+    frame_buffer_->Start();
+  }
   // Start the decode thread
-  decode_thread_.Start();
-  decode_thread_.SetPriority(rtc::kHighestPriority);
+  if (decode_worker_pool_) {
+    decode_worker_pool_->AddStream(this, config_.decode_priority);
+  } else {
+    decode_thread_.Start();
+    decode_thread_.SetPriority(rtc::kHighestPriority);
+  }
+  decoding_ = true;
   rtp_stream_receiver_.StartReceive();
 }
 
@@ -307,7 +355,16 @@ void VideoReceiveStream::Stop() {
   // stop immediately, instead of waiting for a timeout. Needs to be called
   // before joining the decoder thread thread.
   video_receiver_.TriggerDecoderShutdown();
-  decode_thread_.Stop();
+  if (frame_buffer_)
+    frame_buffer_->Stop();
+  if (decode_worker_pool_) {
+    decode_worker_pool_->RemoveStream(this);
+  } else {
+    decode_thread_.Stop();
+  }
+  decoding_ = false;
+  if (frame_buffer_)
+    call_stats_->DeregisterStatsObserver(&rtp_stream_receiver_);
   call_stats_->DeregisterStatsObserver(video_stream_decoder_.get());
   video_stream_decoder_.reset();
   incoming_video_stream_.reset();
@@ -378,13 +435,45 @@ EncodedImageCallback::Result VideoReceiveStream::OnEncodedImage(
 }
 
 bool VideoReceiveStream::DecodeThreadFunction(void* ptr) {
-  static_cast<VideoReceiveStream*>(ptr)->Decode();
+  return static_cast<VideoReceiveStream*>(ptr)->Decode();
+}
+
+bool VideoReceiveStream::Decode() {
+  if (!frame_buffer_) {
+    static const int kMaxDecodeWaitTimeMs = 50;
+    video_receiver_.Decode(kMaxDecodeWaitTimeMs);
+    return true;
+  }
+
+  static const int kMaxWaitForFrameMs = 3000;
+  std::unique_ptr<video_coding::FrameObject> frame;
+  video_coding::FrameBuffer::ReturnReason res =
+      frame_buffer_->NextFrame(kMaxWaitForFrameMs, &frame);
+  if (res == video_coding::FrameBuffer::kStopped)
+    return false;
+
+  if (frame) {
+    if (video_receiver_.Decode(frame.get()) == VCM_OK)
+      rtp_stream_receiver_.FrameDecoded(frame->picture_id);
+  } else {
+    LOG(LS_WARNING) << "No decodable frame in " << kMaxWaitForFrameMs
+                    << " ms, requesting keyframe.";
+    RequestKeyFrame();
+  }
   return true;
 }
 
-void VideoReceiveStream::Decode() {
-  static const int kMaxDecodeWaitTimeMs = 50;
-  video_receiver_.Decode(kMaxDecodeWaitTimeMs);
+int64_t VideoReceiveStream::DecodeNextFrame() {
+  int64_t next_decode_time_ms = -1;
+  video_receiver_.DecodeIfDue(&next_decode_time_ms);
+  return next_decode_time_ms;
+}
+
+void VideoReceiveStream::OnCompleteFrame(
+    std::unique_ptr<video_coding::FrameObject> frame) {
+  int last_continuous_pid = frame_buffer_->InsertFrame(std::move(frame));
+  if (last_continuous_pid != -1)
+    rtp_stream_receiver_.FrameContinuous(last_continuous_pid);
 }
 
 void VideoReceiveStream::SendNack(
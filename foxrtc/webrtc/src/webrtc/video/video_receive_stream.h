@@ -18,8 +18,11 @@
 #include "webrtc/call/transport_adapter.h"
 #include "webrtc/common_video/include/incoming_video_stream.h"
 #include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
+#include "webrtc/modules/video_coding/frame_buffer2.h"
+#include "webrtc/modules/video_coding/jitter_estimator.h"
 #include "webrtc/modules/video_coding/video_coding_impl.h"
 #include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/video/decode_worker_pool.h"
 #include "webrtc/video/receive_statistics_proxy.h"
 #include "webrtc/video/rtp_stream_receiver.h"
 #include "webrtc/video/rtp_streams_synchronizer.h"
@@ -42,15 +45,19 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
                            public rtc::VideoSinkInterface<VideoFrame>,
                            public EncodedImageCallback,
                            public NackSender,
-                           public KeyFrameRequestSender {
+                           public KeyFrameRequestSender,
+                           public DecodeWorkerPool::Stream,
+                           public video_coding::OnCompleteFrameCallback {
  public:
+  // Decodes on |decode_worker_pool| if set, otherwise on a thread of its own.
   VideoReceiveStream(int num_cpu_cores,
                      CongestionController* congestion_controller,
                      VideoReceiveStream::Config config,
                      webrtc::VoiceEngine* voice_engine,
                      ProcessThread* process_thread,
                      CallStats* call_stats,
-                     VieRemb* remb);
+                     VieRemb* remb,
+                     DecodeWorkerPool* decode_worker_pool);
   ~VideoReceiveStream() override;
 
   void SignalNetworkState(NetworkState state);
@@ -84,6 +91,13 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
   // Implements KeyFrameRequestSender.
   void RequestKeyFrame() override;
 
+  // Implements DecodeWorkerPool::Stream.
+  int64_t DecodeNextFrame() override;
+
+  // Implements video_coding::OnCompleteFrameCallback.
+  void OnCompleteFrame(
+      std::unique_ptr<video_coding::FrameObject> frame) override;
+
   // Takes ownership of the file, is responsible for closing it later.
   // Calling this method will close and finalize any current log.
   // Giving rtc::kInvalidPlatformFileValue disables logging.
@@ -94,7 +108,7 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
 
  private:
   static bool DecodeThreadFunction(void* ptr);
-  void Decode();
+  bool Decode();
 
   TransportAdapter transport_adapter_;
   const VideoReceiveStream::Config config_;
@@ -102,11 +116,16 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
   Clock* const clock_;
 
   rtc::PlatformThread decode_thread_;
+  DecodeWorkerPool* const decode_worker_pool_;
+  bool decoding_;
 
   CongestionController* const congestion_controller_;
   CallStats* const call_stats_;
 
   vcm::VideoReceiver video_receiver_;
+  // Null unless |config_.use_frame_buffer| is set.
+  std::unique_ptr<VCMJitterEstimator> jitter_estimator_;
+  std::unique_ptr<video_coding::FrameBuffer> frame_buffer_;
   std::unique_ptr<rtc::VideoSinkInterface<VideoFrame>> incoming_video_stream_;
   ReceiveStatisticsProxy stats_proxy_;
   RtpStreamReceiver rtp_stream_receiver_;
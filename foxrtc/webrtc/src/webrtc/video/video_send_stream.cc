@@ -161,6 +161,7 @@ std::string VideoSendStream::Stats::ToString(int64_t time_ms) const {
   ss << "input_fps: " << input_frame_rate << ", ";
   ss << "encode_fps: " << encode_frame_rate << ", ";
   ss << "encode_ms: " << avg_encode_time_ms << ", ";
+  ss << "p95_encode_ms: " << encode_time_histogram.Percentile(95) << ", ";
   ss << "encode_usage_perc: " << encode_usage_percent << ", ";
   ss << "target_bps: " << target_media_bitrate_bps << ", ";
   ss << "media_bps: " << media_bitrate_bps << ", ";
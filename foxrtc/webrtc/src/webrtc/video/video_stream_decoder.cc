@@ -104,6 +104,10 @@ void VideoStreamDecoder::OnDecoderImplementationName(
   receive_stats_callback_->OnDecoderImplementationName(implementation_name);
 }
 
+void VideoStreamDecoder::OnFrameDecodeTime(int decode_time_ms) {
+  receive_stats_callback_->OnFrameDecodeTime(decode_time_ms);
+}
+
 void VideoStreamDecoder::OnReceiveRatesUpdated(uint32_t bit_rate,
                                                uint32_t frame_rate) {
   receive_stats_callback_->OnIncomingRate(frame_rate, bit_rate);
@@ -60,6 +60,7 @@ class VideoReceiveStream {
     FrameCounts frame_counts;
     int decode_ms = 0;
     int max_decode_ms = 0;
+    FrameTimeHistogram decode_time_histogram;
     int current_delay_ms = 0;
     int target_delay_ms = 0;
     int jitter_buffer_ms = 0;
@@ -175,6 +176,18 @@ class VideoReceiveStream {
     // available.
     bool disable_prerenderer_smoothing = false;
 
+    // With a shared decode pool, see Call::Config::num_decode_threads,
+    // streams with a higher priority keep being decoded when the pool can't
+    // keep up with all of them.
+    int decode_priority = 0;
+
+    // If set, frames are assembled by video_coding::PacketBuffer, ordered by
+    // RtpFrameReferenceFinder and held in video_coding::FrameBuffer instead of
+    // the VCM jitter buffer. The decoder is woken as soon as a frame becomes
+    // decodable rather than polling with a timed wait. Such streams always
+    // decode on a thread of their own.
+    bool use_frame_buffer = false;
+
     // Identifier for an A/V synchronization group. Empty string to disable.
     // TODO(pbos): Synchronize streams in a sync group, not just video streams
     // to one of the audio streams.
@@ -55,6 +55,7 @@ class VideoSendStream {
     int input_frame_rate = 0;
     int encode_frame_rate = 0;
     int avg_encode_time_ms = 0;
+    FrameTimeHistogram encode_time_histogram;
     int encode_usage_percent = 0;
     // Bitrate the encoder is currently configured to use due to bandwidth
     // limitations.
@@ -1485,6 +1485,18 @@ int Channel::SetOpusDtx(bool enable_dtx) {
   return 0;
 }
 
+int Channel::SetOpusCpuAdaptation(bool enable) {
+  WEBRTC_TRACE(kTraceInfo, kTraceVoice, VoEId(_instanceId, _channelId),
+               "Channel::SetOpusCpuAdaptation(%d)", enable);
+  if (audio_coding_->SetOpusCpuAdaptation(enable) != 0) {
+    _engineStatisticsPtr->SetLastError(VE_AUDIO_CODING_MODULE_ERROR,
+                                       kTraceError,
+                                       "SetOpusCpuAdaptation() failed");
+    return -1;
+  }
+  return 0;
+}
+
 int Channel::GetOpusDtx(bool* enabled) {
   int success = -1;
   audio_coding_->QueryEncoder([&](AudioEncoder const* encoder) {
@@ -1537,15 +1549,25 @@ int32_t Channel::ReceivedRTPPacket(const uint8_t* received_packet,
   WEBRTC_TRACE(kTraceStream, kTraceVoice, VoEId(_instanceId, _channelId),
                "Channel::ReceivedRTPPacket()");
 
-  // Store playout timestamp for the received RTP packet
-  UpdatePlayoutTimestamp(false);
-
   RTPHeader header;
   if (!rtp_header_parser_->Parse(received_packet, length, &header)) {
+    // Store playout timestamp for the received RTP packet
+    UpdatePlayoutTimestamp(false);
     WEBRTC_TRACE(webrtc::kTraceDebug, webrtc::kTraceVoice, _channelId,
                  "Incoming packet: invalid RTP header");
     return -1;
   }
+  return ReceivedRTPPacket(received_packet, length, header, packet_time);
+}
+
+int32_t Channel::ReceivedRTPPacket(const uint8_t* received_packet,
+                                   size_t length,
+                                   const RTPHeader& parsed_header,
+                                   const PacketTime& packet_time) {
+  // Store playout timestamp for the received RTP packet
+  UpdatePlayoutTimestamp(false);
+
+  RTPHeader header = parsed_header;
   header.payload_type_frequency =
       rtp_payload_registry_->GetPayloadTypeFrequency(header.payloadType);
   if (header.payload_type_frequency < 0)
@@ -208,6 +208,7 @@ class Channel
   int SetOpusMaxPlaybackRate(int frequency_hz);
   int SetOpusDtx(bool enable_dtx);
   int GetOpusDtx(bool* enabled);
+  int SetOpusCpuAdaptation(bool enable);
 
   // VoENetwork
   int32_t RegisterExternalTransport(Transport* transport);
@@ -215,6 +216,11 @@ class Channel
   int32_t ReceivedRTPPacket(const uint8_t* received_packet,
                             size_t length,
                             const PacketTime& packet_time);
+  // Same as above, for a packet with an already parsed |header|.
+  int32_t ReceivedRTPPacket(const uint8_t* received_packet,
+                            size_t length,
+                            const RTPHeader& header,
+                            const PacketTime& packet_time);
   int32_t ReceivedRTCPPacket(const uint8_t* data, size_t length);
 
   // VoEFile
@@ -187,9 +187,11 @@ void ChannelProxy::DeRegisterExternalTransport() {
 
 bool ChannelProxy::ReceivedRTPPacket(const uint8_t* packet,
                                      size_t length,
+                                     const RTPHeader& header,
                                      const PacketTime& packet_time) {
   // May be called on either worker thread or network thread.
-  return channel()->ReceivedRTPPacket(packet, length, packet_time) == 0;
+  return channel()->ReceivedRTPPacket(packet, length, header, packet_time) ==
+         0;
 }
 
 bool ChannelProxy::ReceivedRTCPPacket(const uint8_t* packet, size_t length) {
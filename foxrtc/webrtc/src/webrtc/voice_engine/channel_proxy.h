@@ -81,6 +81,7 @@ class ChannelProxy {
   virtual void DeRegisterExternalTransport();
   virtual bool ReceivedRTPPacket(const uint8_t* packet,
                                  size_t length,
+                                 const RTPHeader& header,
                                  const PacketTime& packet_time);
   virtual bool ReceivedRTCPPacket(const uint8_t* packet, size_t length);
 
@@ -137,6 +137,11 @@ class WEBRTC_DLLEXPORT VoECodec {
   // are updated.
   virtual int GetOpusDtxStatus(int channel, bool* enabled) { return -1; }
 
+  // If send codec is Opus on a specified |channel|, enables or disables
+  // lowering its complexity, and then lengthening its packets, while encoding
+  // takes too much CPU. Returns 0 if success, and -1 if failed.
+  virtual int SetOpusCpuAdaptation(int channel, bool enable) { return -1; }
+
  protected:
   VoECodec() {}
   virtual ~VoECodec() {}
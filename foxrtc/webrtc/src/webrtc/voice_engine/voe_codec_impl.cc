@@ -393,6 +393,23 @@ int VoECodecImpl::GetOpusDtxStatus(int channel, bool* enabled) {
   return channelPtr->GetOpusDtx(enabled);
 }
 
+int VoECodecImpl::SetOpusCpuAdaptation(int channel, bool enable) {
+  WEBRTC_TRACE(kTraceApiCall, kTraceVoice, VoEId(_shared->instance_id(), -1),
+               "SetOpusCpuAdaptation(channel=%d, enable=%d)", channel, enable);
+  if (!_shared->statistics().Initialized()) {
+    _shared->SetLastError(VE_NOT_INITED, kTraceError);
+    return -1;
+  }
+  voe::ChannelOwner ch = _shared->channel_manager().GetChannel(channel);
+  voe::Channel* channelPtr = ch.channel();
+  if (channelPtr == NULL) {
+    _shared->SetLastError(VE_CHANNEL_NOT_VALID, kTraceError,
+                          "SetOpusCpuAdaptation failed to locate channel");
+    return -1;
+  }
+  return channelPtr->SetOpusCpuAdaptation(enable);
+}
+
 #endif  // WEBRTC_VOICE_ENGINE_CODEC_API
 
 }  // namespace webrtc
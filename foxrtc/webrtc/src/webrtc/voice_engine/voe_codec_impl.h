@@ -60,6 +60,8 @@ class VoECodecImpl : public VoECodec {
 
   int GetOpusDtxStatus(int channel, bool* enabled) override;
 
+  int SetOpusCpuAdaptation(int channel, bool enable) override;
+
  protected:
   VoECodecImpl(voe::SharedData* shared);
   ~VoECodecImpl() override;
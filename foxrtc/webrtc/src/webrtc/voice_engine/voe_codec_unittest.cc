@@ -102,6 +102,34 @@ TEST(VoECodecInst, RememberOpusDtxAfterSettingChange) {
   VoiceEngine::Delete(voe);
 }
 
+TEST(VoECodecInst, SetOpusCpuAdaptationOnlyForOpus) {
+  VoiceEngine* voe(VoiceEngine::Create());
+  VoEBase* base(VoEBase::GetInterface(voe));
+  VoECodec* voe_codec(VoECodec::GetInterface(voe));
+  std::unique_ptr<FakeAudioDeviceModule> adm(new FakeAudioDeviceModule);
+
+  base->Init(adm.get());
+
+  CodecInst opus = {111, "opus", 48000, 960, 1, 32000};
+  CodecInst pcmu = {0, "PCMU", 8000, 160, 1, 64000};
+
+  int channel = base->CreateChannel();
+
+  EXPECT_EQ(0, voe_codec->SetSendCodec(channel, opus));
+  EXPECT_EQ(0, voe_codec->SetOpusCpuAdaptation(channel, true));
+  EXPECT_EQ(0, voe_codec->SetOpusCpuAdaptation(channel, false));
+
+  EXPECT_EQ(0, voe_codec->SetSendCodec(channel, pcmu));
+  EXPECT_EQ(-1, voe_codec->SetOpusCpuAdaptation(channel, true));
+  EXPECT_EQ(0, voe_codec->SetOpusCpuAdaptation(channel, false));
+
+  base->DeleteChannel(channel);
+  base->Terminate();
+  base->Release();
+  voe_codec->Release();
+  VoiceEngine::Delete(voe);
+}
+
 }  // namespace
 }  // namespace voe
 }  // namespace webrtc